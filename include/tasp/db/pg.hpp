@@ -7,7 +7,19 @@
 
 #include "pg/connection.hpp"
 #include "pg/connection_pool.hpp"
+#include "pg/copy_in.hpp"
+#include "pg/copy_out.hpp"
+#include "pg/coroutine.hpp"
+#include "pg/executor.hpp"
+#include "pg/histogram.hpp"
+#include "pg/observer.hpp"
+#include "pg/params.hpp"
+#include "pg/pipeline.hpp"
+#include "pg/query.hpp"
 #include "pg/result.hpp"
+#include "pg/result_stream.hpp"
+#include "pg/sql.hpp"
+#include "pg/statistics.hpp"
 #include "pg/transaction.hpp"
 
 #endif  // TASP_DB_PG_HPP_
\ No newline at end of file
@@ -6,11 +6,20 @@
 #define TASP_DB_PG_CONNECTION_HPP_
 
 #include <any>
+#include <functional>
+#include <future>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
+#include <tasp/db/pg/copy_in.hpp>
+#include <tasp/db/pg/copy_out.hpp>
+#include <tasp/db/pg/params.hpp>
+#include <tasp/db/pg/pipeline.hpp>
+#include <tasp/db/pg/query.hpp>
 #include <tasp/db/pg/result.hpp>
+#include <tasp/db/pg/result_stream.hpp>
 #include <tasp/db/pg/transaction.hpp>
 
 namespace tasp::db::pg
@@ -59,8 +68,14 @@ public:
     /**
      * @brief Выполнение запроса у СУБД с переменным количеством параметров.
      *
-     * В запроса можно указать {}. Вместо этого будет подставлено значение из
-     * параметров.
+     * Параметры указываются в запросе как $1, $2, ... и передаются в СУБД
+     * отдельно от текста запроса. Для совместимости можно указать {}, такие
+     * вхождения вне комментариев и кавычек по порядку заменяются на $1,
+     * $2, ... Параметр передает только значение: имена таблиц и столбцов
+     * через {} не подставляются, "{}" остается идентификатором.
+     *
+     * Параметры преобразуются в текст функциями Encoder, выбранными во время
+     * компиляции, значения std::nullopt и nullptr передаются как NULL.
      *
      * @param query SQL-запрос
      * @param params Параметры запроса
@@ -71,14 +86,21 @@ public:
     [[nodiscard]] std::unique_ptr<Result> Exec(std::string_view query,
                                                Args && ...params) const noexcept
     {
-        return Exec(query, {std::any(std::forward<Args>(params))...});
+        const Params values{params...};
+        return Exec(Result::Format::Text, query, values);
     }
 
     /**
      * @brief Выполнение запроса у СУБД.
      *
-     * В запроса можно указать {}. Вместо этого будет подставлено значение из
-     * параметров.
+     * Параметры указываются в запросе как $1, $2, ... и передаются в СУБД
+     * отдельно от текста запроса. Для совместимости можно указать {}, такие
+     * вхождения вне комментариев и кавычек по порядку заменяются на $1,
+     * $2, ... Параметр передает только значение: имена таблиц и столбцов
+     * через {} не подставляются, "{}" остается идентификатором.
+     *
+     * Параметры преобразуются в текст во время выполнения по типу значения
+     * std::any, что медленнее, чем передача параметров в Exec по отдельности.
      *
      * @param query SQL-запрос
      * @param params Параметры запроса
@@ -89,6 +111,266 @@ public:
         std::string_view query, const std::vector<std::any> &params)
         const noexcept;
 
+    /**
+     * @brief Выполнение запроса у СУБД с переменным количеством параметров и
+     * указанием формата результата.
+     *
+     * В двоичном формате числа, даты и uuid передаются без преобразования в
+     * текст и декодируются методами Result::Get.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса
+     */
+    template<typename... Args>
+    [[nodiscard]] std::unique_ptr<Result> Exec(Result::Format format,
+                                               std::string_view query,
+                                               Args &&...params) const noexcept
+    {
+        const Params values{params...};
+        return Exec(format, query, values);
+    }
+
+    /**
+     * @brief Выполнение запроса у СУБД с преобразованными параметрами и
+     * указанием формата результата.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса
+     */
+    [[nodiscard]] std::unique_ptr<Result> Exec(
+        Result::Format format,
+        std::string_view query,
+        const Params &params) const noexcept;
+
+    /**
+     * @brief Выполнение запроса у СУБД с указанием формата результата.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса
+     */
+    [[nodiscard]] std::unique_ptr<Result> Exec(
+        Result::Format format,
+        std::string_view query,
+        const std::vector<std::any> &params) const noexcept;
+
+    /**
+     * @brief Выполнение запроса, разобранного во время компиляции.
+     *
+     * Количество и типы параметров проверяются при компиляции, текст запроса
+     * при выполнении не просматривается, а ключ подготовленного запроса в
+     * кэше вычислен заранее.
+     *
+     * @param query Запрос, объявленный constexpr
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса
+     */
+    template<size_t Size, typename... Args, typename... Values>
+    [[nodiscard]] std::unique_ptr<Result> Exec(
+        const Query<Size, Args...> &query,
+        const Values &...params) const noexcept
+    {
+        const auto values = query.Bind(params...);
+        return Exec(Result::Format::Text, query.Text(), values);
+    }
+
+    /**
+     * @brief Выполнение запроса, разобранного во время компиляции, с
+     * указанием формата результата.
+     *
+     * @param format Формат результата
+     * @param query Запрос, объявленный constexpr
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса
+     */
+    template<size_t Size, typename... Args, typename... Values>
+    [[nodiscard]] std::unique_ptr<Result> Exec(
+        Result::Format format,
+        const Query<Size, Args...> &query,
+        const Values &...params) const noexcept
+    {
+        const auto values = query.Bind(params...);
+        return Exec(format, query.Text(), values);
+    }
+
+    /**
+     * @brief Выполнение запроса, подготовленного заранее, с преобразованными
+     * параметрами.
+     *
+     * @param format Формат результата
+     * @param query Текст запроса с параметрами вида $n
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса
+     */
+    [[nodiscard]] std::unique_ptr<Result> Exec(
+        Result::Format format,
+        const QueryText &query,
+        const Params &params) const noexcept;
+
+    /**
+     * @brief Обработчик завершения асинхронного запроса.
+     */
+    using Callback = std::function<void(std::unique_ptr<Result>)>;
+
+    /**
+     * @brief Асинхронное выполнение запроса у СУБД с переменным количеством
+     * параметров.
+     *
+     * Запрос отправляется без ожидания результата, результат читается потоком
+     * обработки событий библиотеки. До получения результата подключение нельзя
+     * использовать для других запросов.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса, который будет получен
+     */
+    template<typename... Args>
+    [[nodiscard]] std::future<std::unique_ptr<Result>> ExecAsync(
+        std::string_view query,
+        Args &&...params) const noexcept
+    {
+        const Params values{params...};
+        return ExecAsync(query, values);
+    }
+
+    /**
+     * @brief Асинхронное выполнение запроса у СУБД с преобразованными
+     * параметрами.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса, который будет получен
+     */
+    [[nodiscard]] std::future<std::unique_ptr<Result>> ExecAsync(
+        std::string_view query,
+        const Params &params) const noexcept;
+
+    /**
+     * @brief Асинхронное выполнение запроса у СУБД.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат выполнения запроса, который будет получен
+     */
+    [[nodiscard]] std::future<std::unique_ptr<Result>> ExecAsync(
+        std::string_view query,
+        const std::vector<std::any> &params) const noexcept;
+
+    /**
+     * @brief Асинхронное выполнение запроса у СУБД с обработчиком завершения.
+     *
+     * Обработчик вызывается в потоке обработки событий библиотеки и не должен
+     * блокироваться. Если запрос не удалось отправить, обработчик вызывается
+     * сразу в текущем потоке.
+     *
+     * @param callback Обработчик завершения запроса
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     */
+    void ExecAsync(Callback callback,
+                   Result::Format format,
+                   std::string_view query,
+                   const std::vector<std::any> &params = {}) const noexcept;
+
+    /**
+     * @brief Асинхронное выполнение запроса у СУБД с обработчиком завершения
+     * и преобразованными параметрами.
+     *
+     * @param callback Обработчик завершения запроса
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     */
+    void ExecAsync(Callback callback,
+                   Result::Format format,
+                   std::string_view query,
+                   const Params &params) const noexcept;
+
+    /**
+     * @brief Потоковое выполнение запроса у СУБД с переменным количеством
+     * параметров.
+     *
+     * Строки результата получаются порциями по мере их передачи сервером.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Указатель на поток строк результата
+     */
+    template<typename... Args>
+    [[nodiscard]] std::unique_ptr<ResultStream> Stream(
+        std::string_view query,
+        Args &&...params) const noexcept
+    {
+        const Params values{params...};
+        return Stream(Result::Format::Text, query, values);
+    }
+
+    /**
+     * @brief Потоковое выполнение запроса у СУБД с переменным количеством
+     * параметров и указанием формата результата.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Указатель на поток строк результата
+     */
+    template<typename... Args>
+    [[nodiscard]] std::unique_ptr<ResultStream> Stream(
+        Result::Format format,
+        std::string_view query,
+        Args &&...params) const noexcept
+    {
+        const Params values{params...};
+        return Stream(format, query, values);
+    }
+
+    /**
+     * @brief Потоковое выполнение запроса у СУБД с указанием формата
+     * результата.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Указатель на поток строк результата
+     */
+    [[nodiscard]] std::unique_ptr<ResultStream> Stream(
+        Result::Format format,
+        std::string_view query,
+        const std::vector<std::any> &params = {}) const noexcept;
+
+    /**
+     * @brief Потоковое выполнение запроса у СУБД с преобразованными
+     * параметрами.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Указатель на поток строк результата
+     */
+    [[nodiscard]] std::unique_ptr<ResultStream> Stream(
+        Result::Format format,
+        std::string_view query,
+        const Params &params) const noexcept;
+
     /**
      * @brief Старт транзакции.
      *
@@ -97,6 +379,60 @@ public:
     [[nodiscard]] std::unique_ptr<Transaction> BeginTransaction()
         const noexcept;
 
+    /**
+     * @brief Асинхронный старт транзакции.
+     *
+     * Обработчик вызывается после выполнения команды BEGIN так же, как
+     * обработчик ExecAsync. Команды COMMIT и ROLLBACK выполняются синхронно.
+     *
+     * @param callback Обработчик, получающий транзакцию
+     */
+    void BeginTransactionAsync(
+        std::function<void(std::unique_ptr<Transaction>)> callback)
+        const noexcept;
+
+    /**
+     * @brief Старт пакетного выполнения запросов в режиме конвейера.
+     *
+     * @return Указатель на конвейер
+     */
+    [[nodiscard]] std::unique_ptr<Pipeline> BeginPipeline() const noexcept;
+
+    /**
+     * @brief Старт массовой загрузки данных командой COPY FROM STDIN.
+     *
+     * Имена таблицы и столбцов экранируются PQescapeIdentifier, поэтому
+     * учитывают регистр. Имя таблицы может содержать схему через точку.
+     * Имена, целиком заключенные в двойные кавычки с удвоенными кавычками
+     * внутри, считаются уже экранированными и подставляются в команду без
+     * изменений, схема и таблица проверяются по отдельности.
+     *
+     * @param table Имя таблицы
+     * @param columns Имена столбцов, пустой список - все столбцы таблицы
+     * @param format Формат передачи данных
+     *
+     * @return Указатель на загрузку
+     */
+    [[nodiscard]] std::unique_ptr<CopyIn> BeginCopyIn(
+        std::string_view table,
+        const std::vector<std::string> &columns = {},
+        CopyIn::Format format = CopyIn::Format::Text) const noexcept;
+
+    /**
+     * @brief Старт выгрузки данных командой COPY TO STDOUT.
+     *
+     * Запрос выполняется как COPY (query) TO STDOUT, параметры не
+     * поддерживаются.
+     *
+     * @param query SQL-запрос, результат которого выгружается
+     * @param format Формат передачи данных
+     *
+     * @return Указатель на выгрузку
+     */
+    [[nodiscard]] std::unique_ptr<CopyOut> BeginCopyOut(
+        std::string_view query,
+        CopyOut::Format format = CopyOut::Format::Text) const noexcept;
+
     Connection(const Connection &) = delete;
     Connection(Connection &&) = delete;
     Connection &operator=(const Connection &) = delete;
@@ -5,9 +5,15 @@
 #ifndef TASP_DB_PG_CONNECTION_POOL_HPP_
 #define TASP_DB_PG_CONNECTION_POOL_HPP_
 
+#include <jsoncpp/json/json.h>
+
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string_view>
 
 #include <tasp/db/pg/connection.hpp>
+#include <tasp/db/pg/histogram.hpp>
 
 namespace tasp::db::pg
 {
@@ -23,6 +29,29 @@ class ConnectionPoolImpl;
 class [[gnu::visibility("default")]] ConnectionPool final
 {
 public:
+    /**
+     * @brief Снимок показателей работы пула подключений.
+     *
+     * Счетчики накапливаются с момента создания пула.
+     */
+    struct Metrics
+    {
+        size_t max{0};     /*!< Максимальное количество подключений */
+        size_t active{0};  /*!< Подключения, выданные в аренду и открываемые */
+        size_t idle{0};    /*!< Свободные подключения */
+        size_t waiting{0}; /*!< Запросы, ожидающие подключения */
+
+        uint64_t acquired{0};  /*!< Выданные подключения */
+        uint64_t created{0};   /*!< Установленные подключения */
+        uint64_t failed{0};    /*!< Неудачные попытки подключения */
+        uint64_t closed{0};    /*!< Закрытые пулом подключения */
+        uint64_t exhausted{0}; /*!< Запросы, не получившие подключение сразу */
+        uint64_t timeouts{0};  /*!< Запросы, не дождавшиеся подключения */
+
+        Histogram wait; /*!< Время ожидания подключения */
+        Histogram hold; /*!< Время аренды подключения */
+    };
+
     /**
      * @brief Запрос ссылки на глобальный пул подключения к СУБД PostgreSQL.
      *
@@ -33,9 +62,85 @@ public:
     /**
      * @brief Запрос свободного подключения к СУБД PostgreSQL из пула.
      *
+     * Для каждого подключения к БД из конфигурационного файла используется
+     * отдельный пул со своими настройками, пул создается при первом запросе.
+     *
+     * @param name Имя подключения к БД из конф. файла, пустое - подключение
+     * по умолчанию
+     *
+     * @return Указатель на подключение к СУБД PostgreSQL
+     */
+    [[nodiscard]] std::unique_ptr<Connection> GetConnection(
+        std::string_view name = {}) const noexcept;
+
+    /**
+     * @brief Асинхронный запрос свободного подключения к СУБД PostgreSQL из
+     * пула.
+     *
+     * Поток при ожидании свободного подключения не блокируется. Обработчик
+     * вызывается в текущем потоке, если подключение получено сразу, иначе -
+     * через исполнитель (Executor) после освобождения подключения или
+     * окончания попыток.
+     *
+     * @param callback Обработчик, получающий подключение
+     * @param name Имя подключения к БД из конф. файла, пустое - подключение
+     * по умолчанию
+     */
+    void GetConnectionAsync(
+        std::function<void(std::unique_ptr<Connection>)> callback,
+        std::string_view name = {}) const noexcept;
+
+    /**
+     * @brief Запрос подключения к СУБД PostgreSQL для запросов только на
+     * чтение.
+     *
+     * Подключение выдается из пула наименее загруженной реплики подключения
+     * из конфигурационного файла. Если реплики не настроены, недоступны или
+     * отстают от основной БД больше допустимого, подключение выдается из
+     * пула основной БД.
+     *
+     * @param name Имя подключения к БД из конф. файла, пустое - подключение
+     * по умолчанию
+     *
      * @return Указатель на подключение к СУБД PostgreSQL
      */
-    [[nodiscard]] std::unique_ptr<Connection> GetConnection() const noexcept;
+    [[nodiscard]] std::unique_ptr<Connection> GetReadConnection(
+        std::string_view name = {}) const noexcept;
+
+    /**
+     * @brief Асинхронный запрос подключения к СУБД PostgreSQL для запросов
+     * только на чтение.
+     *
+     * @param callback Обработчик, получающий подключение
+     * @param name Имя подключения к БД из конф. файла, пустое - подключение
+     * по умолчанию
+     *
+     * @see GetReadConnection, GetConnectionAsync
+     */
+    void GetReadConnectionAsync(
+        std::function<void(std::unique_ptr<Connection>)> callback,
+        std::string_view name = {}) const noexcept;
+
+    /**
+     * @brief Запрос показателей работы пула подключений.
+     *
+     * @param name Имя подключения к БД из конф. файла, пустое - подключение
+     * по умолчанию
+     *
+     * @return Снимок показателей
+     */
+    [[nodiscard]] Metrics GetMetrics(std::string_view name = {}) const noexcept;
+
+    /**
+     * @brief Запрос показателей работы пула подключений в формате JSON.
+     *
+     * @param name Имя подключения к БД из конф. файла, пустое - подключение
+     * по умолчанию
+     *
+     * @return Снимок показателей, длительности - в микросекундах
+     */
+    [[nodiscard]] Json::Value GetMetricsJson(
+        std::string_view name = {}) const noexcept;
 
     ConnectionPool(const ConnectionPool &) = delete;
     ConnectionPool(ConnectionPool &&) = delete;
@@ -54,9 +159,9 @@ private:
     ~ConnectionPool() noexcept;
 
     /**
-     * @brief Указатель на реализацию.
+     * @brief Указатель на реализацию пула подключения по умолчанию.
      */
-    std::unique_ptr<ConnectionPoolImpl> impl_;
+    std::shared_ptr<ConnectionPoolImpl> impl_;
 };
 
 }  // namespace tasp::db::pg
@@ -0,0 +1,170 @@
+/**
+ * @file
+ * @brief Интерфейсы для массовой загрузки данных в СУБД PostgreSQL командой
+ * COPY FROM STDIN.
+ */
+#ifndef TASP_DB_PG_COPY_IN_HPP_
+#define TASP_DB_PG_COPY_IN_HPP_
+
+#include <any>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <tasp/db/pg/params.hpp>
+
+namespace tasp::db::pg
+{
+
+class CopyInImpl;
+
+/**
+ * @brief Интерфейс массовой загрузки данных командой COPY FROM STDIN.
+ *
+ * Строки накапливаются во внутреннем буфере и передаются серверу крупными
+ * блоками. Загрузка завершается методом End, если он не был вызван, загрузка
+ * завершается в деструкторе. Пока объект существует, подключение занято и не
+ * может использоваться для других запросов.
+ *
+ * Пример:
+ * @code
+ * auto copy = connection.BeginCopyIn("events", {"id", "name"});
+ * copy->WriteRow(1, "first");
+ * copy->WriteRow(2, nullptr);
+ * auto rows = copy->End();
+ * @endcode
+ *
+ * Класс скрывает от пользователя реализацию с помощью идиомы PIMPL
+ * (Pointer to Implementation – указатель на реализацию).
+ */
+class [[gnu::visibility("default")]] CopyIn final
+{
+public:
+    /**
+     * @brief Формат передачи данных.
+     */
+    enum class Format
+    {
+        Text = 0,   /*!< Текстовый формат COPY, разделитель - табуляция */
+        Csv = 1,    /*!< Формат CSV */
+        Binary = 2, /*!< Двоичный формат COPY */
+    };
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param impl Указатель на реализацию
+     */
+    explicit CopyIn(std::unique_ptr<CopyInImpl> impl) noexcept;
+
+    /**
+     * @brief Деструктор.
+     *
+     * Автоматически вызывается End, если не был вызван End или Abort.
+     */
+    ~CopyIn() noexcept;
+
+    /**
+     * @brief Статус загрузки.
+     *
+     * @return Статус, false после ошибки
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Запись строки с переменным количеством значений.
+     *
+     * Значения nullptr и std::nullopt записываются как NULL, значения
+     * std::optional - как содержащееся в них значение или NULL. В двоичном
+     * формате тип значения должен соответствовать типу столбца: int16_t -
+     * smallint, int32_t - integer, int64_t - bigint, float - real, double -
+     * double precision, bool - boolean, Timestamp - timestamp(tz), Uuid - uuid,
+     * строки - text/varchar.
+     *
+     * @param values Значения столбцов
+     *
+     * @return Результат записи
+     */
+    template<typename... Args>
+    bool WriteRow(Args &&...values) const noexcept
+    {
+        return WriteRow({ToAny(std::forward<Args>(values))...});
+    }
+
+    /**
+     * @brief Запись строки.
+     *
+     * Значения std::optional внутри std::any не поддерживаются, их нужно
+     * передавать содержащимся значением или std::nullopt.
+     *
+     * @param values Значения столбцов
+     *
+     * @return Результат записи
+     */
+    bool WriteRow(const std::vector<std::any> &values) const noexcept;
+
+    /**
+     * @brief Запись данных, уже подготовленных в формате загрузки.
+     *
+     * @param data Данные
+     *
+     * @return Результат записи
+     */
+    bool Write(std::string_view data) const noexcept;
+
+    /**
+     * @brief Завершение загрузки.
+     *
+     * @return Количество загруженных строк, -1 при ошибке
+     */
+    [[nodiscard]] int64_t End() const noexcept;
+
+    /**
+     * @brief Отмена загрузки.
+     *
+     * Загруженные данные не сохраняются.
+     *
+     * @param message Причина отмены
+     */
+    void Abort(std::string_view message = {}) const noexcept;
+
+    CopyIn(const CopyIn &) = delete;
+    CopyIn(CopyIn &&) = delete;
+    CopyIn &operator=(const CopyIn &) = delete;
+    CopyIn &operator=(CopyIn &&) = delete;
+
+private:
+    /**
+     * @brief Упаковка значения столбца в std::any.
+     *
+     * @param value Значение, std::optional заменяется содержащимся значением
+     * или std::nullopt
+     *
+     * @return Значение
+     */
+    template<typename Value>
+    [[nodiscard]] static std::any ToAny(Value &&value) noexcept
+    {
+        if constexpr (IsOptional<std::decay_t<Value>>::value)
+        {
+            return value ? ToAny(*std::forward<Value>(value))
+                         : std::any{std::nullopt};
+        }
+        else
+        {
+            return std::any(std::forward<Value>(value));
+        }
+    }
+
+    /**
+     * @brief Указатель на реализацию.
+     */
+    std::unique_ptr<CopyInImpl> impl_;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_COPY_IN_HPP_
@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @brief Интерфейсы для выгрузки данных из СУБД PostgreSQL командой
+ * COPY TO STDOUT.
+ */
+#ifndef TASP_DB_PG_COPY_OUT_HPP_
+#define TASP_DB_PG_COPY_OUT_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tasp::db::pg
+{
+
+class CopyOutImpl;
+
+/**
+ * @brief Интерфейс выгрузки данных командой COPY TO STDOUT.
+ *
+ * Данные передаются блоками по мере их получения от сервера, результат
+ * запроса целиком в памяти не формируется. Сервер передает каждую строку
+ * отдельным блоком. Пока объект существует, подключение занято и не может
+ * использоваться для других запросов. Если объект удаляется до получения всех
+ * данных, выгрузка отменяется.
+ *
+ * Пример:
+ * @code
+ * auto copy = connection.BeginCopyOut("SELECT id, name FROM events");
+ * std::vector<std::optional<std::string>> row;
+ * while (copy->NextRow(row))
+ * {
+ *     row[1].value_or("NULL");
+ * }
+ * @endcode
+ *
+ * Класс скрывает от пользователя реализацию с помощью идиомы PIMPL
+ * (Pointer to Implementation – указатель на реализацию).
+ */
+class [[gnu::visibility("default")]] CopyOut final
+{
+public:
+    /**
+     * @brief Формат передачи данных.
+     */
+    enum class Format
+    {
+        Text = 0,   /*!< Текстовый формат COPY, разделитель - табуляция */
+        Csv = 1,    /*!< Формат CSV */
+        Binary = 2, /*!< Двоичный формат COPY */
+    };
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param impl Указатель на реализацию
+     */
+    explicit CopyOut(std::unique_ptr<CopyOutImpl> impl) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~CopyOut() noexcept;
+
+    /**
+     * @brief Статус выгрузки.
+     *
+     * После получения всех данных показывает, завершилась ли выгрузка без
+     * ошибок.
+     *
+     * @return Статус
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Запрос следующего блока данных в формате выгрузки.
+     *
+     * Блок действителен до следующего вызова методов объекта.
+     *
+     * @return Блок данных, пустой блок - данные закончились или произошла
+     * ошибка
+     */
+    [[nodiscard]] std::string_view Next() const noexcept;
+
+    /**
+     * @brief Запрос следующей строки с разбором на значения столбцов.
+     *
+     * Поддерживается только текстовый формат.
+     *
+     * @param row Значения столбцов, std::nullopt - значение NULL
+     *
+     * @return Результат, false - строки закончились или произошла ошибка
+     */
+    [[nodiscard]] bool NextRow(
+        std::vector<std::optional<std::string>> &row) const noexcept;
+
+    /**
+     * @brief Запись всех оставшихся данных в файловый дескриптор.
+     *
+     * @param descriptor Файловый дескриптор (файл, сокет, канал)
+     *
+     * @return Количество записанных байт, -1 при ошибке
+     */
+    [[nodiscard]] int64_t WriteTo(int descriptor) const noexcept;
+
+    /**
+     * @brief Количество выгруженных строк.
+     *
+     * @return Количество строк, -1 пока выгрузка не завершена или при ошибке
+     */
+    [[nodiscard]] int64_t Rows() const noexcept;
+
+    CopyOut(const CopyOut &) = delete;
+    CopyOut(CopyOut &&) = delete;
+    CopyOut &operator=(const CopyOut &) = delete;
+    CopyOut &operator=(CopyOut &&) = delete;
+
+private:
+    /**
+     * @brief Указатель на реализацию.
+     */
+    std::unique_ptr<CopyOutImpl> impl_;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_COPY_OUT_HPP_
@@ -0,0 +1,286 @@
+/**
+ * @file
+ * @brief Ожидаемые объекты (awaitable) для выполнения запросов к СУБД
+ * PostgreSQL из сопрограмм C++20.
+ *
+ * Библиотека собирается по стандарту C++17, поэтому объекты реализованы в
+ * заголовочном файле поверх асинхронных методов с обработчиками завершения
+ * и доступны только при сборке приложения с поддержкой сопрограмм. Поток, в
+ * котором возобновляется сопрограмма, определяется исполнителем (Executor).
+ */
+#ifndef TASP_DB_PG_COROUTINE_HPP_
+#define TASP_DB_PG_COROUTINE_HPP_
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <any>
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tasp/db/pg/connection.hpp>
+#include <tasp/db/pg/connection_pool.hpp>
+#include <tasp/db/pg/executor.hpp>
+
+namespace tasp::db::pg::coro
+{
+
+/**
+ * @brief Ожидаемый объект асинхронной операции.
+ *
+ * Запускает операцию при приостановке сопрограммы и возобновляет ее в
+ * обработчике завершения. Если операция завершилась до приостановки,
+ * сопрограмма продолжает выполнение без приостановки.
+ */
+template<class Value>
+class Awaitable final
+{
+public:
+    /**
+     * @brief Функция запуска операции, принимает обработчик завершения.
+     */
+    using Start = std::function<void(std::function<void(Value)>)>;
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param start Функция запуска операции
+     */
+    explicit Awaitable(Start start) noexcept
+    : start_(std::move(start))
+    {
+    }
+
+    /**
+     * @brief Деструктор.
+     */
+    ~Awaitable() noexcept = default;
+
+    /**
+     * @brief Проверка готовности результата без приостановки.
+     *
+     * @return false, операция запускается при приостановке
+     */
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @brief Запуск операции при приостановке сопрограммы.
+     *
+     * @param handle Сопрограмма
+     *
+     * @return false - операция уже завершилась, сопрограмма не
+     * приостанавливается
+     */
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        handle_ = handle;
+        start_(
+            [this](Value value)
+            {
+                value_ = std::move(value);
+                if (state_.exchange(State::Done) == State::Suspended)
+                {
+                    handle_.resume();
+                }
+            });
+
+        return state_.exchange(State::Suspended) != State::Done;
+    }
+
+    /**
+     * @brief Результат операции.
+     *
+     * @return Результат
+     */
+    Value await_resume() noexcept
+    {
+        return std::move(value_);
+    }
+
+    Awaitable(const Awaitable &) = delete;
+    Awaitable(Awaitable &&) = delete;
+    Awaitable &operator=(const Awaitable &) = delete;
+    Awaitable &operator=(Awaitable &&) = delete;
+
+private:
+    /**
+     * @brief Состояния операции.
+     */
+    enum class State
+    {
+        Started = 0,   /*!< Операция запущена */
+        Suspended = 1, /*!< Сопрограмма приостановлена */
+        Done = 2,      /*!< Операция завершена */
+    };
+
+    /**
+     * @brief Функция запуска операции.
+     */
+    Start start_;
+
+    /**
+     * @brief Результат операции.
+     */
+    Value value_{};
+
+    /**
+     * @brief Состояние операции.
+     */
+    std::atomic<State> state_{State::Started};
+
+    /**
+     * @brief Приостановленная сопрограмма.
+     */
+    std::coroutine_handle<> handle_{};
+};
+
+/**
+ * @brief Выполнение запроса у СУБД.
+ *
+ * Пример:
+ * @code
+ * auto result = co_await tasp::db::pg::coro::Exec(
+ *     *connection, "SELECT * FROM events WHERE id = $1", id);
+ * @endcode
+ *
+ * @param connection Подключение к БД, должно существовать до завершения
+ * запроса
+ * @param format Формат результата
+ * @param query SQL-запрос
+ * @param params Параметры запроса
+ *
+ * @return Ожидаемый объект с результатом выполнения запроса
+ */
+[[nodiscard]] inline Awaitable<std::unique_ptr<Result>> Exec(
+    const Connection &connection,
+    Result::Format format,
+    std::string_view query,
+    std::vector<std::any> params = {}) noexcept
+{
+    return Awaitable<std::unique_ptr<Result>>{
+        [&connection,
+         format,
+         query = std::string{query},
+         params = std::move(params)](
+            std::function<void(std::unique_ptr<Result>)> resume)
+        {
+            connection.ExecAsync(std::move(resume), format, query, params);
+        }};
+}
+
+/**
+ * @brief Выполнение запроса у СУБД с преобразованными параметрами.
+ *
+ * @param connection Подключение к БД, должно существовать до завершения
+ * запроса
+ * @param format Формат результата
+ * @param query SQL-запрос
+ * @param params Параметры запроса
+ *
+ * @return Ожидаемый объект с результатом выполнения запроса
+ */
+[[nodiscard]] inline Awaitable<std::unique_ptr<Result>> Exec(
+    const Connection &connection,
+    Result::Format format,
+    std::string_view query,
+    Params params) noexcept
+{
+    return Awaitable<std::unique_ptr<Result>>{
+        [&connection,
+         format,
+         query = std::string{query},
+         params = std::move(params)](
+            std::function<void(std::unique_ptr<Result>)> resume)
+        {
+            connection.ExecAsync(std::move(resume), format, query, params);
+        }};
+}
+
+/**
+ * @brief Выполнение запроса у СУБД с переменным количеством параметров.
+ *
+ * @param connection Подключение к БД
+ * @param query SQL-запрос
+ * @param params Параметры запроса
+ *
+ * @return Ожидаемый объект с результатом выполнения запроса
+ */
+template<typename... Args>
+[[nodiscard]] Awaitable<std::unique_ptr<Result>> Exec(
+    const Connection &connection,
+    std::string_view query,
+    Args &&...params) noexcept
+{
+    return Exec(connection, Result::Format::Text, query, Params{params...});
+}
+
+/**
+ * @brief Старт транзакции.
+ *
+ * @param connection Подключение к БД
+ *
+ * @return Ожидаемый объект с транзакцией
+ */
+[[nodiscard]] inline Awaitable<std::unique_ptr<Transaction>> BeginTransaction(
+    const Connection &connection) noexcept
+{
+    return Awaitable<std::unique_ptr<Transaction>>{
+        [&connection](
+            std::function<void(std::unique_ptr<Transaction>)> resume)
+        {
+            connection.BeginTransactionAsync(std::move(resume));
+        }};
+}
+
+/**
+ * @brief Запрос свободного подключения из пула.
+ *
+ * @param name Имя подключения к БД из конф. файла, пустое - подключение
+ * по умолчанию
+ * @param pool Пул подключений
+ *
+ * @return Ожидаемый объект с подключением
+ */
+[[nodiscard]] inline Awaitable<std::unique_ptr<Connection>> GetConnection(
+    std::string_view name = {},
+    const ConnectionPool &pool = ConnectionPool::Instance()) noexcept
+{
+    return Awaitable<std::unique_ptr<Connection>>{
+        [name, &pool](std::function<void(std::unique_ptr<Connection>)> resume)
+        {
+            pool.GetConnectionAsync(std::move(resume), name);
+        }};
+}
+
+/**
+ * @brief Запрос подключения для запросов только на чтение.
+ *
+ * @param name Имя подключения к БД из конф. файла, пустое - подключение
+ * по умолчанию
+ * @param pool Пул подключений
+ *
+ * @return Ожидаемый объект с подключением
+ */
+[[nodiscard]] inline Awaitable<std::unique_ptr<Connection>> GetReadConnection(
+    std::string_view name = {},
+    const ConnectionPool &pool = ConnectionPool::Instance()) noexcept
+{
+    return Awaitable<std::unique_ptr<Connection>>{
+        [name, &pool](std::function<void(std::unique_ptr<Connection>)> resume)
+        {
+            pool.GetReadConnectionAsync(std::move(resume), name);
+        }};
+}
+
+}  // namespace tasp::db::pg::coro
+
+#endif  // __cpp_impl_coroutine
+
+#endif  // TASP_DB_PG_COROUTINE_HPP_
@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @brief Интерфейс исполнителя обработчиков асинхронных операций.
+ */
+#ifndef TASP_DB_PG_EXECUTOR_HPP_
+#define TASP_DB_PG_EXECUTOR_HPP_
+
+#include <functional>
+#include <memory>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Интерфейс исполнителя обработчиков асинхронных операций.
+ *
+ * По умолчанию обработчики завершения асинхронных операций (ExecAsync,
+ * BeginTransactionAsync, GetConnectionAsync) вызываются в потоке обработки
+ * событий библиотеки. Установив исполнитель, приложение может передать их в
+ * свой цикл обработки событий или пул потоков, например, чтобы возобновлять
+ * сопрограммы в своем потоке.
+ *
+ * Пример:
+ * @code
+ * class LoopExecutor final : public tasp::db::pg::Executor
+ * {
+ * public:
+ *     void Post(std::function<void()> task) noexcept override
+ *     {
+ *         loop_.Post(std::move(task));
+ *     }
+ * };
+ *
+ * tasp::db::pg::Executor::Set(std::make_shared<LoopExecutor>());
+ * @endcode
+ */
+class [[gnu::visibility("default")]] Executor
+{
+public:
+    /**
+     * @brief Конструктор.
+     */
+    Executor() noexcept = default;
+
+    /**
+     * @brief Деструктор.
+     */
+    virtual ~Executor() noexcept;
+
+    /**
+     * @brief Передача обработчика на выполнение.
+     *
+     * @param task Обработчик
+     */
+    virtual void Post(std::function<void()> task) noexcept = 0;
+
+    /**
+     * @brief Установка исполнителя для всех асинхронных операций библиотеки.
+     *
+     * @param executor Исполнитель, nullptr - вызывать обработчики в потоке
+     * обработки событий библиотеки
+     */
+    static void Set(std::shared_ptr<Executor> executor) noexcept;
+
+    /**
+     * @brief Выполнение обработчика установленным исполнителем.
+     *
+     * Если исполнитель не установлен, обработчик выполняется в текущем потоке.
+     *
+     * @param task Обработчик
+     */
+    static void Dispatch(std::function<void()> task) noexcept;
+
+    Executor(const Executor &) = delete;
+    Executor(Executor &&) = delete;
+    Executor &operator=(const Executor &) = delete;
+    Executor &operator=(Executor &&) = delete;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_EXECUTOR_HPP_
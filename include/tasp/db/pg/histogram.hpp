@@ -0,0 +1,54 @@
+/**
+ * @file
+ * @brief Гистограмма длительностей операций с СУБД PostgreSQL.
+ */
+#ifndef TASP_DB_PG_HISTOGRAM_HPP_
+#define TASP_DB_PG_HISTOGRAM_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Гистограмма длительностей с фиксированными границами корзин.
+ */
+struct Histogram
+{
+    /**
+     * @brief Верхние границы корзин (включительно), последняя корзина -
+     * длительности больше последней границы.
+     */
+    static constexpr std::array<std::chrono::microseconds, 10> bounds{{
+        std::chrono::microseconds{100},
+        std::chrono::microseconds{500},
+        std::chrono::microseconds{1'000},
+        std::chrono::microseconds{5'000},
+        std::chrono::microseconds{10'000},
+        std::chrono::microseconds{50'000},
+        std::chrono::microseconds{100'000},
+        std::chrono::microseconds{500'000},
+        std::chrono::microseconds{1'000'000},
+        std::chrono::microseconds{5'000'000}}};
+
+    /**
+     * @brief Количество значений в корзинах.
+     */
+    std::array<uint64_t, bounds.size() + 1> buckets{};
+
+    /**
+     * @brief Общее количество значений.
+     */
+    uint64_t count{0};
+
+    /**
+     * @brief Сумма значений.
+     */
+    std::chrono::microseconds sum{0};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_HISTOGRAM_HPP_
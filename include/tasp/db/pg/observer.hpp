@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @brief Интерфейс наблюдателя за выполнением запросов к СУБД PostgreSQL.
+ */
+#ifndef TASP_DB_PG_OBSERVER_HPP_
+#define TASP_DB_PG_OBSERVER_HPP_
+
+#include <chrono>
+#include <memory>
+#include <string_view>
+
+#include <tasp/db/pg/params.hpp>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Интерфейс наблюдателя за выполнением запросов и выдачей подключений
+ * из пула, например, для трассировки.
+ *
+ * Методы наблюдателя вызываются в потоке, выполняющем операцию, и не должны
+ * блокироваться. Ссылки, переданные в методы, действительны только во время
+ * вызова. Пока не зарегистрировано ни одного наблюдателя, события не
+ * формируются.
+ *
+ * Пример:
+ * @code
+ * class Tracer final : public tasp::db::pg::Observer
+ * {
+ * public:
+ *     void OnFinish(const Query &query) noexcept override
+ *     {
+ *         span_.End(query.sql, query.duration);
+ *     }
+ * };
+ *
+ * tasp::db::pg::Observer::Add(std::make_shared<Tracer>());
+ * @endcode
+ */
+class [[gnu::visibility("default")]] Observer
+{
+public:
+    /**
+     * @brief Событие выполнения запроса.
+     */
+    struct Query
+    {
+        /**
+         * @brief SQL-запрос.
+         */
+        std::string_view sql;
+
+        /**
+         * @brief Параметры запроса.
+         */
+        const Params &params;
+
+        /**
+         * @brief Идентификатор подключения, одинаковый для всех запросов
+         * одного подключения.
+         */
+        const void *connection;
+
+        /**
+         * @brief Время выполнения, в OnStart - 0.
+         */
+        std::chrono::nanoseconds duration{0};
+
+        /**
+         * @brief Сообщение об ошибке, только в OnError.
+         */
+        std::string_view error{};
+    };
+
+    /**
+     * @brief Событие выдачи подключения из пула.
+     */
+    struct Checkout
+    {
+        /**
+         * @brief Имя подключения к БД из конф. файла.
+         */
+        std::string_view pool;
+
+        /**
+         * @brief Идентификатор подключения, nullptr - подключение не выдано.
+         */
+        const void *connection;
+
+        /**
+         * @brief Время ожидания подключения.
+         */
+        std::chrono::nanoseconds wait;
+    };
+
+    /**
+     * @brief Конструктор.
+     */
+    Observer() noexcept = default;
+
+    /**
+     * @brief Деструктор.
+     */
+    virtual ~Observer() noexcept;
+
+    /**
+     * @brief Начало выполнения запроса.
+     *
+     * @param query Событие
+     */
+    virtual void OnStart(const Query &query) noexcept;
+
+    /**
+     * @brief Успешное завершение запроса.
+     *
+     * @param query Событие
+     */
+    virtual void OnFinish(const Query &query) noexcept;
+
+    /**
+     * @brief Завершение запроса с ошибкой.
+     *
+     * @param query Событие
+     */
+    virtual void OnError(const Query &query) noexcept;
+
+    /**
+     * @brief Выдача подключения из пула.
+     *
+     * @param checkout Событие
+     */
+    virtual void OnCheckout(const Checkout &checkout) noexcept;
+
+    /**
+     * @brief Регистрация наблюдателя.
+     *
+     * @param observer Наблюдатель
+     */
+    static void Add(std::shared_ptr<Observer> observer) noexcept;
+
+    /**
+     * @brief Удаление наблюдателя.
+     *
+     * После возврата из функции наблюдатель может еще получить события,
+     * которые уже формируются в других потоках.
+     *
+     * @param observer Наблюдатель
+     */
+    static void Remove(const std::shared_ptr<Observer> &observer) noexcept;
+
+    Observer(const Observer &) = delete;
+    Observer(Observer &&) = delete;
+    Observer &operator=(const Observer &) = delete;
+    Observer &operator=(Observer &&) = delete;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_OBSERVER_HPP_
@@ -0,0 +1,425 @@
+/**
+ * @file
+ * @brief Параметры запроса к СУБД PostgreSQL.
+ */
+#ifndef TASP_DB_PG_PARAMS_HPP_
+#define TASP_DB_PG_PARAMS_HPP_
+
+#include <any>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <tasp/db/pg/result.hpp>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Проверка, является ли тип std::optional.
+ */
+template<typename Type>
+struct IsOptional : std::false_type
+{
+};
+
+/**
+ * @brief Проверка, является ли тип std::optional.
+ */
+template<typename Type>
+struct IsOptional<std::optional<Type>> : std::true_type
+{
+};
+
+/**
+ * @brief Преобразование значения параметра типа Type в текстовый формат
+ * PostgreSQL.
+ *
+ * Точка расширения для пользовательских типов: специализация должна
+ * содержать функцию
+ * @code
+ * static bool Encode(const Type &value, std::string &buffer) noexcept;
+ * @endcode
+ * которая дописывает текст значения в конец buffer и возвращает false, если
+ * значение нельзя передать в СУБД. Текст не должен содержать символ '\0'.
+ *
+ * Пример:
+ * @code
+ * template<>
+ * struct tasp::db::pg::Encoder<Point>
+ * {
+ *     static bool Encode(const Point &value, std::string &buffer) noexcept
+ *     {
+ *         buffer.append(fmt::format("({},{})", value.x, value.y));
+ *         return true;
+ *     }
+ * };
+ * @endcode
+ *
+ * Значения типов без специализации передаются через std::any и
+ * преобразуются во время выполнения, как в Connection::Exec с
+ * std::vector<std::any>.
+ */
+template<typename Type, typename Enable = void>
+struct Encoder
+{
+    /**
+     * @brief Признак отсутствия специализации для типа.
+     */
+    static constexpr bool generic{true};
+};
+
+/**
+ * @brief Преобразование логического значения.
+ */
+template<>
+struct Encoder<bool>
+{
+    /**
+     * @brief Запись значения.
+     *
+     * @param value Значение
+     * @param buffer Строка для записи
+     *
+     * @return Результат преобразования
+     */
+    static bool Encode(bool value, std::string &buffer) noexcept
+    {
+        buffer.push_back(value ? 't' : 'f');
+        return true;
+    }
+};
+
+/**
+ * @brief Преобразование целого числа, кроме символьных типов.
+ */
+template<typename Type>
+struct Encoder<
+    Type,
+    std::enable_if_t<std::is_integral_v<Type> && !std::is_same_v<Type, bool> &&
+                     !std::is_same_v<Type, char> &&
+                     !std::is_same_v<Type, wchar_t> &&
+                     !std::is_same_v<Type, char16_t> &&
+                     !std::is_same_v<Type, char32_t>>>
+{
+    /**
+     * @copydoc Encoder<bool>::Encode
+     */
+    static bool Encode(Type value, std::string &buffer) noexcept
+    {
+        std::array<char, 24> text{};
+        const auto [end, error] =
+            std::to_chars(text.data(), text.data() + text.size(), value);
+        buffer.append(text.data(), end);
+        return error == std::errc{};
+    }
+};
+
+/**
+ * @brief Преобразование числа с плавающей точкой.
+ *
+ * Записывается кратчайшее представление, из которого читается то же
+ * значение, NaN и бесконечности - как NaN, Infinity и -Infinity.
+ */
+template<>
+struct [[gnu::visibility("default")]] Encoder<float>
+{
+    /**
+     * @copydoc Encoder<bool>::Encode
+     */
+    static bool Encode(float value, std::string &buffer) noexcept;
+};
+
+/**
+ * @copydoc Encoder<float>
+ */
+template<>
+struct [[gnu::visibility("default")]] Encoder<double>
+{
+    /**
+     * @copydoc Encoder<bool>::Encode
+     */
+    static bool Encode(double value, std::string &buffer) noexcept;
+};
+
+/**
+ * @brief Преобразование строки.
+ */
+template<>
+struct Encoder<std::string_view>
+{
+    /**
+     * @copydoc Encoder<bool>::Encode
+     */
+    static bool Encode(std::string_view value, std::string &buffer) noexcept
+    {
+        buffer.append(value);
+        return true;
+    }
+};
+
+/**
+ * @copydoc Encoder<std::string_view>
+ */
+template<>
+struct Encoder<std::string> : Encoder<std::string_view>
+{
+};
+
+/**
+ * @copydoc Encoder<std::string_view>
+ */
+template<>
+struct Encoder<const char *> : Encoder<std::string_view>
+{
+};
+
+/**
+ * @copydoc Encoder<std::string_view>
+ */
+template<>
+struct Encoder<char *> : Encoder<std::string_view>
+{
+};
+
+/**
+ * @brief Преобразование момента времени в timestamptz (UTC).
+ */
+template<>
+struct [[gnu::visibility("default")]] Encoder<Timestamp>
+{
+    /**
+     * @copydoc Encoder<bool>::Encode
+     */
+    static bool Encode(const Timestamp &value, std::string &buffer) noexcept;
+};
+
+/**
+ * @brief Преобразование значения uuid.
+ */
+template<>
+struct [[gnu::visibility("default")]] Encoder<Uuid>
+{
+    /**
+     * @copydoc Encoder<bool>::Encode
+     */
+    static bool Encode(const Uuid &value, std::string &buffer) noexcept;
+};
+
+/**
+ * @brief Проверка отсутствия специализации Encoder для типа.
+ */
+template<typename Type, typename Enable = void>
+struct IsGenericEncoder : std::false_type
+{
+};
+
+/**
+ * @brief Проверка отсутствия специализации Encoder для типа.
+ */
+template<typename Type>
+struct IsGenericEncoder<Type, std::void_t<decltype(Encoder<Type>::generic)>>
+: std::true_type
+{
+};
+
+/**
+ * @brief Параметры запроса в текстовом формате PostgreSQL.
+ *
+ * Значения преобразуются при добавлении функциями Encoder, выбранными во
+ * время компиляции, и хранятся в одной строке, разделенные символом '\0',
+ * поэтому для параметров не выделяется память по отдельности. Значения
+ * std::nullopt и nullptr передаются как NULL.
+ */
+class [[gnu::visibility("default")]] Params final
+{
+public:
+    /**
+     * @brief Конструктор пустого списка параметров.
+     */
+    Params() noexcept;
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param values Значения параметров
+     */
+    template<typename... Args>
+    explicit Params(const Args &...values) noexcept
+    {
+        Reserve(sizeof...(values));
+        (Add(values), ...);
+    }
+
+    /**
+     * @brief Конструктор из значений, преобразуемых во время выполнения.
+     *
+     * @param values Значения параметров
+     */
+    explicit Params(const std::vector<std::any> &values) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~Params() noexcept;
+
+    Params(const Params &) = default;
+    Params(Params &&) noexcept = default;
+    Params &operator=(const Params &) = default;
+    Params &operator=(Params &&) noexcept = default;
+
+    /**
+     * @brief Добавление параметра.
+     *
+     * Для списка параметров Params добавляются все его значения.
+     *
+     * @param value Значение
+     */
+    template<typename Type>
+    void Add(const Type &value) noexcept
+    {
+        using Value = std::decay_t<Type>;
+
+        if constexpr (std::is_same_v<Value, Params>)
+        {
+            Append(value);
+        }
+        else if constexpr (std::is_same_v<Value, std::nullptr_t> ||
+                           std::is_same_v<Value, std::nullopt_t>)
+        {
+            AddNull();
+        }
+        else if constexpr (IsOptional<Value>::value)
+        {
+            if (value)
+            {
+                Add(*value);
+            }
+            else
+            {
+                AddNull();
+            }
+        }
+        else if constexpr (IsGenericEncoder<Value>::value)
+        {
+            Add(std::any{value});
+        }
+        else
+        {
+            if constexpr (std::is_pointer_v<Type>)
+            {
+                if (value == nullptr)
+                {
+                    AddNull();
+                    return;
+                }
+            }
+
+            offsets_.push_back(data_.size());
+            const auto encoded = Encoder<Value>::Encode(value, data_);
+            End(encoded);
+        }
+    }
+
+    /**
+     * @brief Добавление параметра, преобразуемого во время выполнения.
+     *
+     * @param value Значение
+     */
+    void Add(const std::any &value) noexcept;
+
+    /**
+     * @brief Добавление параметра NULL.
+     */
+    void AddNull() noexcept;
+
+    /**
+     * @brief Резервирование памяти под параметры.
+     *
+     * @param count Количество параметров
+     */
+    void Reserve(size_t count) noexcept;
+
+    /**
+     * @brief Запрос количества параметров.
+     *
+     * @return Количество параметров
+     */
+    [[nodiscard]] size_t Size() const noexcept;
+
+    /**
+     * @brief Проверка успешного преобразования всех параметров.
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool Valid() const noexcept;
+
+    /**
+     * @brief Проверка параметра на NULL.
+     *
+     * @param index Номер параметра
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool IsNull(size_t index) const noexcept;
+
+    /**
+     * @brief Запрос текста параметра.
+     *
+     * @param index Номер параметра
+     *
+     * @return Текст параметра, пустая строка для NULL
+     */
+    [[nodiscard]] std::string_view Value(size_t index) const noexcept;
+
+    /**
+     * @brief Запрос указателей на значения параметров для передачи в libpq.
+     *
+     * Указатели действительны, пока список параметров не изменяется.
+     *
+     * @param count Количество параметров, не больше Size()
+     *
+     * @return Указатели на строки с '\0' в конце, nullptr - NULL
+     */
+    [[nodiscard]] std::vector<const char *> Pointers(
+        size_t count) const noexcept;
+
+private:
+    /**
+     * @brief Завершение записи значения параметра.
+     *
+     * @param encoded Результат преобразования значения
+     */
+    void End(bool encoded) noexcept;
+
+    /**
+     * @brief Добавление всех параметров другого списка.
+     *
+     * @param params Список параметров
+     */
+    void Append(const Params &params) noexcept;
+
+    /**
+     * @brief Значения параметров, каждое завершается символом '\0'.
+     */
+    std::string data_{};
+
+    /**
+     * @brief Смещения значений в data_, npos - NULL.
+     */
+    std::vector<size_t> offsets_{};
+
+    /**
+     * @brief Все параметры преобразованы успешно.
+     */
+    bool valid_{true};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_PARAMS_HPP_
@@ -0,0 +1,165 @@
+/**
+ * @file
+ * @brief Интерфейсы для пакетного выполнения запросов к СУБД PostgreSQL в
+ * режиме конвейера.
+ */
+#ifndef TASP_DB_PG_PIPELINE_HPP_
+#define TASP_DB_PG_PIPELINE_HPP_
+
+#include <any>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <tasp/db/pg/params.hpp>
+#include <tasp/db/pg/result.hpp>
+
+namespace tasp::db::pg
+{
+
+class PipelineImpl;
+
+/**
+ * @brief Интерфейс пакетного выполнения запросов в режиме конвейера.
+ *
+ * Запросы отправляются в СУБД без ожидания результатов предыдущих запросов,
+ * результаты всех запросов пакета запрашиваются методом Results за одно
+ * обращение к серверу. Запросы пакета выполняются в одной неявной
+ * транзакции: если один запрос завершился ошибкой, все последующие запросы
+ * пакета не выполняются (их результаты имеют статус false), а изменения
+ * предыдущих запросов пакета отменяются. После вызова Results можно
+ * добавлять запросы следующего пакета.
+ *
+ * Пока объект существует, подключение занято и не может использоваться для
+ * других запросов. Если при удалении объекта в пакете остались запросы, они
+ * выполняются, а результаты отбрасываются.
+ *
+ * Если libpq собрана без поддержки конвейера, запросы выполняются
+ * последовательно при добавлении.
+ *
+ * Пример:
+ * @code
+ * auto pipeline = connection.BeginPipeline();
+ * pipeline->Add("INSERT INTO events (name) VALUES ($1)", "first");
+ * pipeline->Add("INSERT INTO events (name) VALUES ($1)", "second");
+ * for (const auto &result : pipeline->Results())
+ * {
+ *     result->Status();
+ * }
+ * @endcode
+ *
+ * Класс скрывает от пользователя реализацию с помощью идиомы PIMPL
+ * (Pointer to Implementation – указатель на реализацию).
+ */
+class [[gnu::visibility("default")]] Pipeline final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param impl Указатель на реализацию
+     */
+    explicit Pipeline(std::unique_ptr<PipelineImpl> impl) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~Pipeline() noexcept;
+
+    /**
+     * @brief Статус конвейера.
+     *
+     * @return Статус, false - нет подключения к БД или произошла ошибка
+     * обмена пакетом запросов с сервером
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Добавление запроса в пакет с переменным количеством параметров.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат отправки запроса, при ошибке запрос не добавляется
+     */
+    template<typename... Args>
+    bool Add(std::string_view query, Args &&...params) const noexcept
+    {
+        const Params values{params...};
+        return Add(Result::Format::Text, query, values);
+    }
+
+    /**
+     * @brief Добавление запроса в пакет с переменным количеством параметров и
+     * указанием формата результата.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат отправки запроса, при ошибке запрос не добавляется
+     */
+    template<typename... Args>
+    bool Add(Result::Format format,
+             std::string_view query,
+             Args &&...params) const noexcept
+    {
+        const Params values{params...};
+        return Add(format, query, values);
+    }
+
+    /**
+     * @brief Добавление запроса в пакет с указанием формата результата.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат отправки запроса, при ошибке запрос не добавляется
+     */
+    bool Add(Result::Format format,
+             std::string_view query,
+             const std::vector<std::any> &params = {}) const noexcept;
+
+    /**
+     * @brief Добавление запроса в пакет с преобразованными параметрами.
+     *
+     * @param format Формат результата
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     *
+     * @return Результат отправки запроса, при ошибке запрос не добавляется
+     */
+    bool Add(Result::Format format,
+             std::string_view query,
+             const Params &params) const noexcept;
+
+    /**
+     * @brief Количество запросов в пакете, ожидающих результата.
+     *
+     * @return Количество запросов
+     */
+    [[nodiscard]] size_t Size() const noexcept;
+
+    /**
+     * @brief Выполнение пакета и получение результатов.
+     *
+     * @return Результаты запросов в порядке добавления
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<Result>> Results() const noexcept;
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline(Pipeline &&) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+    Pipeline &operator=(Pipeline &&) = delete;
+
+private:
+    /**
+     * @brief Указатель на реализацию.
+     */
+    std::unique_ptr<PipelineImpl> impl_;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_PIPELINE_HPP_
@@ -0,0 +1,467 @@
+/**
+ * @file
+ * @brief SQL-запрос к СУБД PostgreSQL, подготовленный во время компиляции.
+ */
+#ifndef TASP_DB_PG_QUERY_HPP_
+#define TASP_DB_PG_QUERY_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <tasp/db/pg/params.hpp>
+#include <tasp/db/pg/sql.hpp>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Вычисление хеша нормализованного текста запроса (FNV-1a).
+ *
+ * Используется как ключ подготовленного запроса в кэше подключения.
+ * Запросы, отличающиеся только пробелами и комментариями (SqlNormalizer),
+ * имеют одинаковый хеш.
+ *
+ * @param text Текст запроса
+ *
+ * @return Хеш
+ */
+[[nodiscard]] constexpr uint64_t QueryHash(std::string_view text) noexcept
+{
+    uint64_t hash{14695981039346656037ULL};
+    SqlNormalizer normalizer{text};
+    for (char symbol{'\0'}; normalizer.Next(symbol);)
+    {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Текст SQL-запроса с параметрами вида $n, подготовленный заранее.
+ */
+struct QueryText
+{
+    /**
+     * @brief SQL-запрос с параметрами вида $n, за последним символом
+     * следует '\0'.
+     */
+    std::string_view sql;
+
+    /**
+     * @brief Количество параметров запроса.
+     */
+    size_t params;
+
+    /**
+     * @brief Хеш текста запроса, QueryHash(sql).
+     */
+    uint64_t hash;
+};
+
+/**
+ * @brief Тип параметра запроса, значение которого не проверяется во время
+ * компиляции.
+ */
+struct Untyped
+{
+};
+
+/**
+ * @brief Проверка возможности инициализации значения типа Type значением
+ * типа Value без сужающего преобразования.
+ */
+template<typename Type, typename Value, typename Enable = void>
+struct IsBraceConstructible : std::false_type
+{
+};
+
+/**
+ * @brief Проверка возможности инициализации значения типа Type значением
+ * типа Value без сужающего преобразования.
+ */
+template<typename Type, typename Value>
+struct IsBraceConstructible<
+    Type,
+    Value,
+    std::void_t<decltype(Type{std::declval<const Value &>()})>>
+: std::true_type
+{
+};
+
+/**
+ * @brief Проверка, можно ли передать значение типа Value в параметр запроса
+ * типа Arg.
+ *
+ * Значение должно приводиться к типу параметра без сужающего
+ * преобразования, std::nullopt и nullptr допускаются для любого параметра.
+ */
+template<typename Arg, typename Value>
+struct IsQueryArg
+: std::bool_constant<std::is_same_v<Arg, Untyped> ||
+                     std::is_same_v<Value, std::nullptr_t> ||
+                     std::is_same_v<Value, std::nullopt_t> ||
+                     IsBraceConstructible<Arg, Value>::value>
+{
+};
+
+/**
+ * @brief Проверка, можно ли передать значение std::optional в параметр
+ * запроса типа Arg.
+ */
+template<typename Arg, typename Value>
+struct IsQueryArg<Arg, std::optional<Value>>
+: std::bool_constant<IsQueryArg<Arg, Value>::value ||
+                     IsBraceConstructible<Arg, std::optional<Value>>::value>
+{
+};
+
+/**
+ * @brief SQL-запрос, разобранный во время компиляции.
+ *
+ * Вхождения {} заменяются на $1, $2, ... при компиляции, количество
+ * параметров и хеш текста для кэша подготовленных запросов вычисляются
+ * один раз, поэтому при выполнении текст запроса не просматривается. Если в
+ * запросе нет {}, количество параметров определяется по наибольшему номеру
+ * $n.
+ *
+ * Args - типы параметров запроса, их количество должно совпадать с
+ * количеством параметров, иначе запрос не компилируется. Значение параметра
+ * должно приводиться к своему типу без сужающего преобразования, для
+ * параметров типа Untyped тип не проверяется.
+ *
+ * Запрос создается функцией MakeQuery и должен быть объявлен constexpr,
+ * только тогда ошибки в запросе обнаруживаются при компиляции:
+ * @code
+ * static constexpr auto find_user = tasp::db::pg::MakeQuery<int64_t>(
+ *     "SELECT name FROM users WHERE id = {}");
+ *
+ * auto result = connection->Exec(find_user, id);
+ * @endcode
+ *
+ * Текст разбирается по тем же правилам, что и запросы, передаваемые
+ * строкой (FindSqlSpan): {} и $n внутри комментариев, идентификаторов в
+ * кавычках, констант E'...' и строк в долларовых кавычках не учитываются. В
+ * отличие от запросов, передаваемых строкой, {} внутри строковой константы
+ * не допускается, значение подставляется конкатенацией: '%' || {} || '%'.
+ */
+template<size_t Size, typename... Args>
+class Query final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param text SQL-запрос
+     */
+    constexpr explicit Query(const char (&text)[Size]) noexcept
+    {
+        const std::string_view sql{text, Size - 1};
+        size_t placeholders{0};
+        size_t numbered{0};
+
+        size_t pos{0};
+        while (pos < sql.size())
+        {
+            const auto span = FindSqlSpan(sql, pos);
+            if (span.kind != SqlSpan::Kind::Code)
+            {
+                if (span.kind == SqlSpan::Kind::Literal &&
+                    sql.substr(pos, span.end - pos).find("{}") !=
+                        std::string_view::npos)
+                {
+                    PlaceholderInLiteral();
+                }
+
+                for (; pos < span.end; ++pos)
+                {
+                    Put(sql[pos]);
+                }
+                continue;
+            }
+
+            const char symbol{sql[pos++]};
+            if (symbol == '{' && pos < sql.size() && sql[pos] == '}')
+            {
+                Put('$');
+                PutNumber(++placeholders);
+                ++pos;
+                continue;
+            }
+
+            Put(symbol);
+            if (symbol != '$')
+            {
+                continue;
+            }
+
+            size_t number{0};
+            while (pos < sql.size() && IsDigit(sql[pos]))
+            {
+                number = number * 10 + static_cast<size_t>(sql[pos] - '0');
+                Put(sql[pos++]);
+            }
+            numbered = number > numbered ? number : numbered;
+        }
+
+        if (placeholders != 0 && numbered != 0)
+        {
+            MixedPlaceholders();
+        }
+
+        params_ = placeholders != 0 ? placeholders : numbered;
+        if (params_ != sizeof...(Args))
+        {
+            ArgumentsMismatch();
+        }
+
+        if (!valid_)
+        {
+            sql_[0] = '\0';
+            length_ = 0;
+            params_ = 0;
+        }
+
+        hash_ = QueryHash(Sql());
+    }
+
+    /**
+     * @brief Запрос текста SQL-запроса с параметрами вида $n.
+     *
+     * @return SQL-запрос, за последним символом следует '\0'
+     */
+    [[nodiscard]] constexpr std::string_view Sql() const noexcept
+    {
+        return {sql_.data(), length_};
+    }
+
+    /**
+     * @brief Проверка отсутствия ошибок в запросе.
+     *
+     * Для запроса, объявленного constexpr, всегда true.
+     *
+     * @return Результат проверки, false - текст запроса пустой
+     */
+    [[nodiscard]] constexpr bool Valid() const noexcept
+    {
+        return valid_;
+    }
+
+    /**
+     * @brief Запрос количества параметров запроса.
+     *
+     * @return Количество параметров
+     */
+    [[nodiscard]] constexpr size_t Params() const noexcept
+    {
+        return params_;
+    }
+
+    /**
+     * @brief Запрос хеша текста запроса.
+     *
+     * @return Хеш
+     */
+    [[nodiscard]] constexpr uint64_t Hash() const noexcept
+    {
+        return hash_;
+    }
+
+    /**
+     * @brief Запрос подготовленного текста запроса для выполнения.
+     *
+     * @return Текст запроса
+     */
+    [[nodiscard]] constexpr QueryText Text() const noexcept
+    {
+        return {Sql(), params_, hash_};
+    }
+
+    /**
+     * @brief Преобразование значений параметров с проверкой их количества и
+     * типов во время компиляции.
+     *
+     * @param values Значения параметров
+     *
+     * @return Параметры запроса
+     */
+    template<typename... Values>
+    [[nodiscard]] static pg::Params Bind(const Values &...values) noexcept
+    {
+        if constexpr (sizeof...(Values) != sizeof...(Args))
+        {
+            static_assert(sizeof...(Values) == sizeof...(Args),
+                          "Количество параметров не совпадает с количеством "
+                          "параметров запроса");
+            return pg::Params{};
+        }
+        else if constexpr (!(IsQueryArg<Args, Values>::value && ...))
+        {
+            static_assert((IsQueryArg<Args, Values>::value && ...),
+                          "Тип параметра не совпадает с типом, указанным в "
+                          "запросе");
+            return pg::Params{};
+        }
+        else
+        {
+            return pg::Params{Cast<Args>(values)...};
+        }
+    }
+
+private:
+    /**
+     * @brief Максимальная длина запроса после замены {} на $n.
+     */
+    static constexpr size_t capacity{Size + Size / 2 * 4};
+
+    /**
+     * @brief Проверка символа на цифру.
+     *
+     * @param symbol Символ
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] static constexpr bool IsDigit(char symbol) noexcept
+    {
+        return symbol >= '0' && symbol <= '9';
+    }
+
+    /**
+     * @brief Приведение значения к типу параметра.
+     *
+     * @param value Значение
+     *
+     * @return Значение типа Arg или std::optional<Arg>, ссылка на value,
+     * если приведение не требуется
+     */
+    template<typename Arg, typename Value>
+    [[nodiscard]] static constexpr decltype(auto) Cast(
+        const Value &value) noexcept
+    {
+        if constexpr (std::is_same_v<Arg, Untyped> ||
+                      std::is_same_v<Arg, Value> ||
+                      std::is_same_v<Value, std::nullptr_t> ||
+                      std::is_same_v<Value, std::nullopt_t>)
+        {
+            return (value);
+        }
+        else if constexpr (IsBraceConstructible<Arg, Value>::value)
+        {
+            return Arg{value};
+        }
+        else
+        {
+            return value ? std::optional<Arg>{Cast<Arg>(*value)}
+                         : std::optional<Arg>{};
+        }
+    }
+
+    /**
+     * @brief Добавление символа в запрос.
+     *
+     * @param symbol Символ
+     */
+    constexpr void Put(char symbol) noexcept
+    {
+        if (length_ + 1 < capacity)
+        {
+            sql_[length_++] = symbol;
+        }
+    }
+
+    /**
+     * @brief Добавление в запрос номера параметра.
+     *
+     * @param number Номер параметра
+     */
+    constexpr void PutNumber(size_t number) noexcept
+    {
+        size_t divider{1};
+        while (divider * 10 <= number)
+        {
+            divider *= 10;
+        }
+
+        for (; divider != 0; divider /= 10)
+        {
+            Put(static_cast<char>('0' + number / divider % 10));
+        }
+    }
+
+    // Функции ниже не constexpr: их вызов при разборе запроса, объявленного
+    // constexpr, является ошибкой компиляции с именем функции в сообщении.
+    // Во время выполнения запрос помечается ошибочным, его текст очищается.
+
+    /**
+     * @brief Количество параметров не совпадает с количеством типов Args.
+     */
+    void ArgumentsMismatch() noexcept
+    {
+        valid_ = false;
+    }
+
+    /**
+     * @brief В запросе одновременно указаны {} и $n.
+     */
+    void MixedPlaceholders() noexcept
+    {
+        valid_ = false;
+    }
+
+    /**
+     * @brief {} внутри строковой константы.
+     */
+    void PlaceholderInLiteral() noexcept
+    {
+        valid_ = false;
+    }
+
+    /**
+     * @brief SQL-запрос с параметрами вида $n.
+     */
+    std::array<char, capacity> sql_{};
+
+    /**
+     * @brief Длина SQL-запроса.
+     */
+    size_t length_{0};
+
+    /**
+     * @brief Количество параметров запроса.
+     */
+    size_t params_{0};
+
+    /**
+     * @brief Хеш текста запроса.
+     */
+    uint64_t hash_{0};
+
+    /**
+     * @brief Запрос разобран без ошибок.
+     */
+    bool valid_{true};
+};
+
+/**
+ * @brief Создание SQL-запроса, разобранного во время компиляции.
+ *
+ * @param text SQL-запрос
+ *
+ * @return Запрос с параметрами типов Args
+ */
+template<typename... Args, size_t Size>
+[[nodiscard]] constexpr Query<Size, Args...> MakeQuery(
+    const char (&text)[Size]) noexcept
+{
+    return Query<Size, Args...>{text};
+}
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_QUERY_HPP_
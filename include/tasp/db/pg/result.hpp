@@ -7,15 +7,202 @@
 
 #include <jsoncpp/json/json.h>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace tasp::db::pg
 {
 
 class ResultImpl;
-class ResultIteratorImpl;
+
+/**
+ * @brief Момент времени для значений типов timestamp, timestamptz и date.
+ */
+using Timestamp = std::chrono::system_clock::time_point;
+
+/**
+ * @brief Значение типа uuid.
+ */
+using Uuid = std::array<uint8_t, 16>;
+
+/**
+ * @brief Значения столбца результата запроса, расположенные подряд.
+ *
+ * Значения NULL и значения, которые нельзя преобразовать в тип Type,
+ * хранятся как значение по умолчанию и отмечаются в битовой карте nulls.
+ * Логические значения хранятся как uint8_t (0 или 1), чтобы массив значений
+ * был непрерывным.
+ */
+template<typename Type>
+struct ColumnValues
+{
+    /**
+     * @brief Тип элемента массива значений.
+     */
+    using Value = std::conditional_t<std::is_same_v<Type, bool>, uint8_t, Type>;
+
+    /**
+     * @brief Значения в порядке строк результата.
+     */
+    std::vector<Value> values{};
+
+    /**
+     * @brief Битовая карта NULL: бит row % 64 элемента row / 64.
+     */
+    std::vector<uint64_t> nulls{};
+
+    /**
+     * @brief Запрос количества значений.
+     *
+     * @return Количество значений
+     */
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return values.size();
+    }
+
+    /**
+     * @brief Проверка значения на NULL.
+     *
+     * @param row Номер строки
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool IsNull(size_t row) const noexcept
+    {
+        return (nulls[row / 64] >> (row % 64) & 1U) != 0;
+    }
+};
+
+/**
+ * @brief Проверка типа на поддержку в Result::Column.
+ */
+template<typename Type>
+struct IsColumnValue
+: std::bool_constant<
+      std::is_same_v<Type, bool> || std::is_same_v<Type, int16_t> ||
+      std::is_same_v<Type, int32_t> || std::is_same_v<Type, int64_t> ||
+      std::is_same_v<Type, float> || std::is_same_v<Type, double> ||
+      std::is_same_v<Type, Timestamp>>
+{
+};
+
+/**
+ * @brief Проверка типа на поддержку в Result::Get и RowMapping.
+ *
+ * Поддерживаются типы Result::Column, std::string, std::string_view, Uuid и
+ * std::optional от них. Шаблоны Get реализованы в библиотеке только для
+ * этих типов, поэтому другие типы отклоняются при компиляции, а не при
+ * компоновке.
+ */
+template<typename Type>
+struct IsResultValue
+: std::bool_constant<IsColumnValue<Type>::value ||
+                     std::is_same_v<Type, std::string> ||
+                     std::is_same_v<Type, std::string_view> ||
+                     std::is_same_v<Type, Uuid>>
+{
+};
+
+/**
+ * @brief Проверка типа на поддержку в Result::Get и RowMapping.
+ */
+template<typename Type>
+struct IsResultValue<std::optional<Type>> : IsResultValue<Type>
+{
+};
+
+/**
+ * @brief Проверка типа на поддержку в Result::Get и RowMapping: вложенный
+ * std::optional не поддерживается.
+ */
+template<typename Type>
+struct IsResultValue<std::optional<std::optional<Type>>> : std::false_type
+{
+};
+
+/**
+ * @brief Соответствие поля структуры столбцу результата запроса.
+ */
+template<typename Class, typename Type>
+struct ColumnMapping
+{
+    static_assert(IsResultValue<Type>::value,
+                  "Тип поля не поддерживается Result::Get: допустимы bool, "
+                  "int16_t, int32_t, int64_t, float, double, std::string, "
+                  "std::string_view, Timestamp, Uuid и std::optional от них");
+    /**
+     * @brief Тип поля.
+     */
+    using Value = Type;
+
+    /**
+     * @brief Название столбца.
+     */
+    std::string_view name;
+
+    /**
+     * @brief Указатель на поле структуры.
+     */
+    Type Class::*member;
+};
+
+/**
+ * @brief Создание соответствия поля структуры столбцу результата запроса.
+ *
+ * @param name Название столбца
+ * @param member Указатель на поле структуры
+ *
+ * @return Соответствие
+ */
+template<typename Class, typename Type>
+[[nodiscard]] constexpr ColumnMapping<Class, Type> MapColumn(
+    std::string_view name,
+    Type Class::*member) noexcept
+{
+    return {name, member};
+}
+
+/**
+ * @brief Описание соответствия полей структуры Type столбцам результата
+ * запроса для Result::As.
+ *
+ * Специализация должна содержать кортеж соответствий columns, созданных
+ * функцией MapColumn. Поля должны иметь типы, поддерживаемые Result::Get.
+ *
+ * Пример:
+ * @code
+ * struct User
+ * {
+ *     int64_t id;
+ *     std::string name;
+ *     std::optional<Timestamp> login;
+ * };
+ *
+ * template<>
+ * struct tasp::db::pg::RowMapping<User>
+ * {
+ *     static constexpr auto columns =
+ *         std::make_tuple(MapColumn("id", &User::id),
+ *                         MapColumn("name", &User::name),
+ *                         MapColumn("last_login", &User::login));
+ * };
+ * @endcode
+ */
+template<typename Type>
+struct RowMapping;
 
 /**
  * @brief Интерфейс для работы с результатом запроса к СУБД PostgreSQL.
@@ -26,8 +213,78 @@ class ResultIteratorImpl;
 class [[gnu::visibility("default")]] Result final
 {
 public:
+    class Row;
     class Iterator;
 
+    /**
+     * @brief Столбец результата запроса.
+     *
+     * Номер столбца определяется по имени один раз для всего результата, после
+     * чего значения строк запрашиваются без поиска по имени.
+     */
+    class Field final
+    {
+    public:
+        /**
+         * @brief Конструктор отсутствующего столбца.
+         */
+        constexpr Field() noexcept = default;
+
+        /**
+         * @brief Конструктор.
+         *
+         * @param index Номер столбца
+         */
+        constexpr explicit Field(int index) noexcept
+        : index_(index)
+        {
+        }
+
+        /**
+         * @brief Запрос номера столбца.
+         *
+         * @return Номер столбца, -1 если столбец отсутствует
+         */
+        [[nodiscard]] constexpr int Index() const noexcept
+        {
+            return index_;
+        }
+
+        /**
+         * @brief Проверка наличия столбца в результате запроса.
+         *
+         * @return Результат проверки
+         */
+        [[nodiscard]] constexpr bool Valid() const noexcept
+        {
+            return index_ >= 0;
+        }
+
+    private:
+        /**
+         * @brief Номер столбца.
+         */
+        int index_{-1};
+    };
+
+    /**
+     * @brief Формат передачи данных результата запроса от СУБД.
+     */
+    enum class Format
+    {
+        Text = 0,   /*!< Текстовый формат */
+        Binary = 1, /*!< Двоичный формат */
+    };
+
+    /**
+     * @brief Структура данных при записи результата в формате JSON.
+     */
+    enum class JsonShape
+    {
+        Objects = 0, /*!< Строки - объекты с именами столбцов, как JsonValue */
+        Arrays = 1,  /*!< Имена столбцов отдельно, строки - массивы значений */
+    };
+
     /**
      * @brief Конструктор.
      *
@@ -47,6 +304,44 @@ public:
      */
     [[nodiscard]] bool Status() const noexcept;
 
+    /**
+     * @brief Поиск столбца по имени.
+     *
+     * @param name Название столбца
+     *
+     * @return Столбец
+     */
+    [[nodiscard]] Field Find(std::string_view name) const noexcept;
+
+    /**
+     * @brief Поиск нескольких столбцов по именам.
+     *
+     * Пример:
+     * @code
+     * const auto [id, name] = result->Find("id", "name");
+     * for (const auto &row : *result)
+     * {
+     *     auto value = row.Get<int64_t>(id);
+     * }
+     * @endcode
+     *
+     * @param first Название первого столбца
+     * @param second Название второго столбца
+     * @param names Названия остальных столбцов
+     *
+     * @return Столбцы в порядке перечисления имен
+     */
+    template<typename... Names>
+    [[nodiscard]] std::array<Field, sizeof...(Names) + 2> Find(
+        std::string_view first,
+        std::string_view second,
+        Names &&...names) const noexcept
+    {
+        return {Find(first),
+                Find(second),
+                Find(std::string_view{std::forward<Names>(names)})...};
+    }
+
     /**
      * @brief Запрос значения по имени столбца.
      *
@@ -56,6 +351,222 @@ public:
      */
     [[nodiscard]] std::string Value(std::string_view name) const noexcept;
 
+    /**
+     * @brief Проверка значения на NULL по имени столбца.
+     *
+     * @param name Название столбца.
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool IsNull(std::string_view name) const noexcept;
+
+    /**
+     * @brief Запрос значения по имени столбца с преобразованием в тип Type.
+     *
+     * Поддерживаемые типы: bool, int16_t, int32_t, int64_t, float, double,
+     * std::string, std::string_view, Timestamp, Uuid и std::optional от них.
+     * Значения декодируются напрямую из формата, в котором их передала СУБД.
+     * std::string_view ссылается на данные результата без копирования.
+     *
+     * @param name Название столбца.
+     *
+     * @return Значение. Для NULL и значений, которые нельзя преобразовать в
+     * тип Type, значение по умолчанию (std::nullopt для std::optional).
+     */
+    template<typename Type>
+    [[nodiscard]] Type Get(std::string_view name) const noexcept
+    {
+        CheckValue<Type>();
+        return Decode<Type>(impl_.get(), 0, name);
+    }
+
+    /**
+     * @brief Запрос значения столбца.
+     *
+     * @param field Столбец
+     *
+     * @return Значение. Пустую строку если значение отсутствует.
+     */
+    [[nodiscard]] std::string Value(Field field) const noexcept;
+
+    /**
+     * @brief Проверка значения столбца на NULL.
+     *
+     * @param field Столбец
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool IsNull(Field field) const noexcept;
+
+    /**
+     * @brief Запрос значения столбца с преобразованием в тип Type.
+     *
+     * @param field Столбец
+     *
+     * @return Значение
+     *
+     * @see Get(std::string_view) const
+     */
+    template<typename Type>
+    [[nodiscard]] Type Get(Field field) const noexcept
+    {
+        CheckValue<Type>();
+        return Decode<Type>(impl_.get(), 0, field.Index());
+    }
+
+    /**
+     * @brief Запрос количества строк результата.
+     *
+     * @return Количество строк
+     */
+    [[nodiscard]] int Rows() const noexcept;
+
+    /**
+     * @brief Запрос количества столбцов результата.
+     *
+     * @return Количество столбцов
+     */
+    [[nodiscard]] int Columns() const noexcept;
+
+    /**
+     * @brief Запрос строки результата по номеру.
+     *
+     * @param row Номер строки, от 0 до Rows()
+     *
+     * @return Строка
+     */
+    [[nodiscard]] Row operator[](int row) const noexcept;
+
+    /**
+     * @brief Запрос значения столбца в строке с преобразованием в тип Type.
+     *
+     * @param row Номер строки
+     * @param field Столбец
+     *
+     * @return Значение
+     *
+     * @see Get(std::string_view) const
+     */
+    template<typename Type>
+    [[nodiscard]] Type Get(int row, Field field) const noexcept
+    {
+        CheckValue<Type>();
+        return Decode<Type>(impl_.get(), row, field.Index());
+    }
+
+    /**
+     * @brief Запрос всех значений столбца с преобразованием в тип Type.
+     *
+     * Поддерживаемые типы: bool, int16_t, int32_t, int64_t, float, double и
+     * Timestamp. Способ преобразования выбирается один раз для столбца по
+     * его типу и формату, после чего значения декодируются в одном цикле
+     * без выделения памяти на каждое значение.
+     *
+     * Пример:
+     * @code
+     * const auto amounts = result->Column<int64_t>("amount");
+     * int64_t total{0};
+     * for (size_t row = 0; row < amounts.Size(); ++row)
+     * {
+     *     total += amounts.values[row];
+     * }
+     * @endcode
+     *
+     * @param name Название столбца
+     *
+     * @return Значения столбца. Для отсутствующего столбца все значения -
+     * NULL.
+     */
+    template<typename Type>
+    [[nodiscard]] ColumnValues<Type> Column(
+        std::string_view name) const noexcept
+    {
+        return Column<Type>(Find(name));
+    }
+
+    /**
+     * @brief Запрос всех значений столбца с преобразованием в тип Type.
+     *
+     * @param field Столбец
+     *
+     * @return Значения столбца
+     *
+     * @see Column(std::string_view) const
+     */
+    template<typename Type>
+    [[nodiscard]] ColumnValues<Type> Column(Field field) const noexcept
+    {
+        static_assert(IsColumnValue<Type>::value,
+                      "Тип не поддерживается Result::Column: допустимы bool, "
+                      "int16_t, int32_t, int64_t, float, double и Timestamp");
+        return Values<Type>(field.Index());
+    }
+
+    /**
+     * @brief Преобразование строк результата в структуры Type.
+     *
+     * Соответствие полей столбцам задается специализацией RowMapping<Type>.
+     * Номера столбцов определяются один раз, значения декодируются по типам
+     * полей. Поля, для которых нет столбца в результате, не изменяются, поля
+     * со значением NULL (кроме std::optional) получают значение по
+     * умолчанию.
+     *
+     * Пример:
+     * @code
+     * for (const auto &user : result->As<User>())
+     * {
+     *     ...
+     * }
+     * @endcode
+     *
+     * @return Структуры в порядке строк результата
+     */
+    template<typename Type>
+    [[nodiscard]] std::vector<Type> As() const noexcept
+    {
+        std::vector<Type> rows{};
+        rows.reserve(static_cast<size_t>(Rows()));
+
+        ForEach<Type>(
+            [&rows](Type &&row)
+            {
+                rows.push_back(std::move(row));
+            });
+
+        return rows;
+    }
+
+    /**
+     * @brief Перебор строк результата, преобразованных в структуры Type, без
+     * сохранения всех строк.
+     *
+     * @param callback Обработчик, получающий Type&& для каждой строки
+     *
+     * @see As() const
+     */
+    template<typename Type, typename Callback>
+    void ForEach(Callback &&callback) const noexcept
+    {
+        const auto fields = std::apply(
+            [this](const auto &...columns)
+            {
+                return std::array<Field, sizeof...(columns)>{
+                    Find(columns.name)...};
+            },
+            RowMapping<Type>::columns);
+
+        using Indexes = std::make_index_sequence<std::tuple_size_v<
+            std::decay_t<decltype(RowMapping<Type>::columns)>>>;
+
+        const auto rows = Rows();
+        for (int row = 0; row < rows; ++row)
+        {
+            Type value{};
+            Fill(row, fields, value, Indexes{});
+            callback(std::move(value));
+        }
+    }
+
     /**
      * @brief Запрос данных запроса в формате JSON.
      *
@@ -75,10 +586,51 @@ public:
      *   ]
      * }
      *
+     * Значения преобразуются по типу столбца: bool - в логические значения,
+     * целые числа, float4 и float8 - в числа (NaN и Infinity - в строки),
+     * numeric - в строки без потери точности, json и jsonb - в документы
+     * JSON, массивы этих и строковых типов - в массивы JSON с учетом
+     * вложенности. Значения остальных типов представляются строками в
+     * текстовом формате PostgreSQL, NULL - null.
+     *
      * @return JSON с данными.
      */
     [[nodiscard]] Json::Value JsonValue() const noexcept;
 
+    /**
+     * @brief Запись данных запроса в формате JSON в строку.
+     *
+     * Данные записываются напрямую из результата запроса, без построения
+     * Json::Value, и добавляются в конец строки. Значения преобразуются так
+     * же, как в JsonValue, кроме numeric: число записывается в том виде, в
+     * котором получено от сервера, без потери точности.
+     *
+     * Формат JsonShape::Objects совпадает с форматом JsonValue:
+     * {"count":2,"data":[{"field1":"value","field2":"value"},...]}
+     *
+     * Формат JsonShape::Arrays:
+     * {"count":2,"columns":["field1","field2"],"data":[["value","value"],...]}
+     *
+     * @param buffer Строка для записи
+     * @param shape Структура данных
+     */
+    void WriteJson(std::string &buffer,
+                   JsonShape shape = JsonShape::Objects) const noexcept;
+
+    /**
+     * @brief Запись данных запроса в формате JSON в поток.
+     *
+     * Данные записываются в поток частями через промежуточный буфер
+     * ограниченного размера.
+     *
+     * @param stream Поток для записи
+     * @param shape Структура данных
+     *
+     * @see WriteJson(std::string &, JsonShape) const
+     */
+    void WriteJson(std::ostream &stream,
+                   JsonShape shape = JsonShape::Objects) const noexcept;
+
     // Выключается проверка стиля наименований для этого участка, т.к. это
     // методы для использования в стандартной библиотеке c++.
     // NOLINTBEGIN(readability-identifier-naming)
@@ -87,14 +639,14 @@ public:
      *
      * @return Итератор на первую строку.
      */
-    [[nodiscard]] Result::Iterator begin() const;
+    [[nodiscard]] Result::Iterator begin() const noexcept;
 
     /**
      * @brief Итератор конца строк SQL-запроса.
      *
      * @return Итератор конца.
      */
-    [[nodiscard]] Result::Iterator end() const;
+    [[nodiscard]] Result::Iterator end() const noexcept;
     // NOLINTEND(readability-identifier-naming)
 
     Result(const Result &) = delete;
@@ -103,6 +655,89 @@ public:
     Result &operator=(Result &&) = delete;
 
 private:
+    /**
+     * @brief Проверка поддержки типа значения во время компиляции.
+     */
+    template<typename Type>
+    static constexpr void CheckValue() noexcept
+    {
+        static_assert(IsResultValue<Type>::value,
+                      "Тип не поддерживается Result::Get: допустимы bool, "
+                      "int16_t, int32_t, int64_t, float, double, std::string, "
+                      "std::string_view, Timestamp, Uuid и std::optional от "
+                      "них");
+    }
+
+    /**
+     * @brief Запрос значения по имени столбца с преобразованием в тип Type.
+     *
+     * Реализована в библиотеке для типов, поддерживаемых Get.
+     *
+     * @param result Указатель на реализацию результата
+     * @param row Номер строки
+     * @param name Название столбца
+     *
+     * @return Значение
+     */
+    template<typename Type>
+    [[nodiscard]] static Type Decode(const ResultImpl *result,
+                                     int row,
+                                     std::string_view name) noexcept;
+
+    /**
+     * @brief Запрос значения столбца с преобразованием в тип Type.
+     *
+     * Реализована в библиотеке для типов, поддерживаемых Get.
+     *
+     * @param result Указатель на реализацию результата
+     * @param row Номер строки
+     * @param column Номер столбца
+     *
+     * @return Значение
+     */
+    template<typename Type>
+    [[nodiscard]] static Type Decode(const ResultImpl *result,
+                                     int row,
+                                     int column) noexcept;
+
+    /**
+     * @brief Запрос всех значений столбца с преобразованием в тип Type.
+     *
+     * Реализована в библиотеке для типов, поддерживаемых Column.
+     *
+     * @param column Номер столбца
+     *
+     * @return Значения столбца
+     */
+    template<typename Type>
+    [[nodiscard]] ColumnValues<Type> Values(int column) const noexcept;
+
+    /**
+     * @brief Заполнение полей структуры значениями строки.
+     *
+     * @param row Номер строки
+     * @param fields Столбцы в порядке соответствий RowMapping<Type>
+     * @param value Структура
+     */
+    template<typename Type, size_t... Indexes>
+    void Fill(int row,
+              const std::array<Field, sizeof...(Indexes)> &fields,
+              Type &value,
+              std::index_sequence<Indexes...>) const noexcept
+    {
+        const auto assign = [this, row](auto &member, Field field)
+        {
+            if (field.Valid())
+            {
+                member = Get<std::decay_t<decltype(member)>>(row, field);
+            }
+        };
+
+        (assign(value.*std::get<Indexes>(RowMapping<Type>::columns).member,
+                fields[Indexes]),
+         ...);
+    }
+
     /**
      * @brief Указатель на реализацию.
      */
@@ -110,25 +745,40 @@ private:
 };
 
 /**
- * @brief Итератор для перебора строк результата SQL-команды.
+ * @brief Строка результата SQL-запроса.
  *
- * Класс скрывает от пользователя реализацию с помощью идиомы PIMPL
- * (Pointer to Implementation – указатель на реализацию).
+ * Хранит только указатель на результат и номер строки, поэтому копируется
+ * без выделения памяти. Действительна, пока существует результат.
  */
-class Result::Iterator
+class Result::Row final
 {
 public:
+    /**
+     * @brief Конструктор.
+     */
+    constexpr Row() noexcept = default;
+
     /**
      * @brief Конструктор.
      *
-     * @param impl Указатель на реализацию
+     * @param result Указатель на реализацию результата
+     * @param row Номер строки
      */
-    explicit Iterator(std::unique_ptr<ResultIteratorImpl> impl) noexcept;
+    constexpr Row(const ResultImpl *result, int row) noexcept
+    : result_(result)
+    , row_(row)
+    {
+    }
 
     /**
-     * @brief Деструктор.
+     * @brief Запрос номера строки.
+     *
+     * @return Номер строки
      */
-    ~Iterator();
+    [[nodiscard]] constexpr int Index() const noexcept
+    {
+        return row_;
+    }
 
     /**
      * @brief Запрос значения по имени столбца.
@@ -139,39 +789,378 @@ public:
      */
     [[nodiscard]] std::string Value(std::string_view name) const noexcept;
 
+    /**
+     * @brief Проверка значения на NULL по имени столбца.
+     *
+     * @param name Название столбца.
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool IsNull(std::string_view name) const noexcept;
+
+    /**
+     * @brief Запрос значения по имени столбца с преобразованием в тип Type.
+     *
+     * Поддерживаемые типы: bool, int16_t, int32_t, int64_t, float, double,
+     * std::string, std::string_view, Timestamp, Uuid и std::optional от них.
+     * Значения декодируются напрямую из формата, в котором их передала СУБД.
+     * std::string_view ссылается на данные результата без копирования.
+     *
+     * @param name Название столбца.
+     *
+     * @return Значение. Для NULL и значений, которые нельзя преобразовать в
+     * тип Type, значение по умолчанию (std::nullopt для std::optional).
+     */
+    template<typename Type>
+    [[nodiscard]] Type Get(std::string_view name) const noexcept
+    {
+        Result::CheckValue<Type>();
+        return Result::Decode<Type>(result_, row_, name);
+    }
+
+    /**
+     * @brief Запрос значения столбца.
+     *
+     * @param field Столбец
+     *
+     * @return Значение. Пустую строку если значение отсутствует.
+     */
+    [[nodiscard]] std::string Value(Result::Field field) const noexcept;
+
+    /**
+     * @brief Проверка значения столбца на NULL.
+     *
+     * @param field Столбец
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool IsNull(Result::Field field) const noexcept;
+
+    /**
+     * @brief Запрос значения столбца с преобразованием в тип Type.
+     *
+     * @param field Столбец
+     *
+     * @return Значение
+     *
+     * @see Get(std::string_view) const
+     */
+    template<typename Type>
+    [[nodiscard]] Type Get(Result::Field field) const noexcept
+    {
+        Result::CheckValue<Type>();
+        return Result::Decode<Type>(result_, row_, field.Index());
+    }
+
+private:
+    friend class Result::Iterator;
+
+    /**
+     * @brief Указатель на реализацию результата.
+     */
+    const ResultImpl *result_{nullptr};
+
+    /**
+     * @brief Номер строки.
+     */
+    int row_{0};
+};
+
+/**
+ * @brief Итератор для перебора строк результата SQL-команды.
+ *
+ * Копируется без выделения памяти. Итератор-прокси: разыменование
+ * возвращает строку Row по значению, а не ссылку, поэтому по требованиям
+ * C++17 он является итератором ввода (iterator_category) и передается только
+ * в алгоритмы, которым достаточно такого итератора. Операции произвольного
+ * доступа (it + n, it[n], it2 - it1, сравнения) выполняются за константное
+ * время и доступны напрямую, в C++20 итератор соответствует концепции
+ * random_access_iterator (iterator_concept).
+ */
+class Result::Iterator final
+{
+public:
+    /**
+     * @brief Результат operator->, хранящий строку в себе.
+     *
+     * Строка копируется, поэтому указатель остается действительным и для
+     * временного итератора, например, внутри std::reverse_iterator.
+     */
+    class Pointer final
+    {
+    public:
+        /**
+         * @brief Конструктор.
+         *
+         * @param row Строка
+         */
+        constexpr explicit Pointer(Row row) noexcept
+        : row_(row)
+        {
+        }
+
+        /**
+         * @brief Доступ к методам строки.
+         *
+         * @return Указатель на строку
+         */
+        [[nodiscard]] constexpr const Row *operator->() const noexcept
+        {
+            return &row_;
+        }
+
+    private:
+        /**
+         * @brief Строка.
+         */
+        Row row_;
+    };
+
+    // Выключается проверка стиля наименований для этого участка, т.к. это
+    // типы для использования в стандартной библиотеке c++.
+    // NOLINTBEGIN(readability-identifier-naming)
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = Row;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Pointer;
+    using reference = Row;
+    // NOLINTEND(readability-identifier-naming)
+
+    /**
+     * @brief Конструктор.
+     */
+    constexpr Iterator() noexcept = default;
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param result Указатель на реализацию результата
+     * @param row Номер строки
+     */
+    constexpr Iterator(const ResultImpl *result, int row) noexcept
+    : row_(result, row)
+    {
+    }
+
+    /**
+     * @brief Получение строки, на которую указывает итератор.
+     *
+     * @return Строка
+     */
+    [[nodiscard]] constexpr reference operator*() const noexcept
+    {
+        return row_;
+    }
+
+    /**
+     * @brief Доступ к методам строки, на которую указывает итератор.
+     *
+     * @return Указатель на копию строки
+     */
+    [[nodiscard]] constexpr pointer operator->() const noexcept
+    {
+        return Pointer{row_};
+    }
+
+    /**
+     * @brief Получение строки со смещением от текущей.
+     *
+     * @param offset Смещение
+     *
+     * @return Строка
+     */
+    [[nodiscard]] constexpr reference operator[](
+        difference_type offset) const noexcept
+    {
+        return *(*this + offset);
+    }
+
     /**
      * @brief Переход на следующую строку.
      *
      * @return Ссылка на самого себя.
      */
-    Iterator &operator++() noexcept;
+    constexpr Iterator &operator++() noexcept
+    {
+        ++row_.row_;
+        return *this;
+    }
+
+    /**
+     * @brief Переход на следующую строку.
+     *
+     * @return Итератор до перехода
+     */
+    constexpr Iterator operator++(int) noexcept
+    {
+        auto previous = *this;
+        ++row_.row_;
+        return previous;
+    }
+
+    /**
+     * @brief Переход на предыдущую строку.
+     *
+     * @return Ссылка на самого себя.
+     */
+    constexpr Iterator &operator--() noexcept
+    {
+        --row_.row_;
+        return *this;
+    }
+
+    /**
+     * @brief Переход на предыдущую строку.
+     *
+     * @return Итератор до перехода
+     */
+    constexpr Iterator operator--(int) noexcept
+    {
+        auto previous = *this;
+        --row_.row_;
+        return previous;
+    }
+
+    /**
+     * @brief Смещение итератора.
+     *
+     * @param offset Смещение
+     *
+     * @return Ссылка на самого себя.
+     */
+    constexpr Iterator &operator+=(difference_type offset) noexcept
+    {
+        row_.row_ += static_cast<int>(offset);
+        return *this;
+    }
+
+    /**
+     * @brief Смещение итератора назад.
+     *
+     * @param offset Смещение
+     *
+     * @return Ссылка на самого себя.
+     */
+    constexpr Iterator &operator-=(difference_type offset) noexcept
+    {
+        row_.row_ -= static_cast<int>(offset);
+        return *this;
+    }
+
+    /**
+     * @brief Запрос итератора со смещением.
+     *
+     * @param offset Смещение
+     *
+     * @return Итератор
+     */
+    [[nodiscard]] constexpr Iterator operator+(
+        difference_type offset) const noexcept
+    {
+        auto result = *this;
+        return result += offset;
+    }
+
+    /**
+     * @brief Запрос итератора со смещением назад.
+     *
+     * @param offset Смещение
+     *
+     * @return Итератор
+     */
+    [[nodiscard]] constexpr Iterator operator-(
+        difference_type offset) const noexcept
+    {
+        auto result = *this;
+        return result -= offset;
+    }
+
+    /**
+     * @brief Запрос расстояния между итераторами.
+     *
+     * @param rhs Итератор
+     *
+     * @return Количество строк между итераторами
+     */
+    [[nodiscard]] constexpr difference_type operator-(
+        const Iterator &rhs) const noexcept
+    {
+        return row_.row_ - rhs.row_.row_;
+    }
 
     /**
-     * @brief Сравнение текущего итератора с итератором переданным в параметрах.
+     * @brief Сравнение итераторов.
      *
      * @param rhs Итератор для сравнения
      *
      * @return Результат сравнения
      */
-    bool operator!=(const Iterator &rhs) noexcept;
+    [[nodiscard]] constexpr bool operator==(const Iterator &rhs) const noexcept
+    {
+        return row_.row_ == rhs.row_.row_ && row_.result_ == rhs.row_.result_;
+    }
 
     /**
-     * @brief Получение значения на которое указывает итератор.
-     *
-     * @return Ссылка на самого себя
+     * @copydoc operator==
+     */
+    [[nodiscard]] constexpr bool operator!=(const Iterator &rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @copydoc operator==
      */
-    const Iterator &operator*() const noexcept;
+    [[nodiscard]] constexpr bool operator<(const Iterator &rhs) const noexcept
+    {
+        return row_.row_ < rhs.row_.row_;
+    }
 
-    Iterator(const Iterator &) = delete;
-    Iterator(Iterator &&ref) noexcept = delete;
-    Iterator &operator=(const Iterator &) = delete;
-    Iterator &operator=(Iterator &&) = delete;
+    /**
+     * @copydoc operator==
+     */
+    [[nodiscard]] constexpr bool operator>(const Iterator &rhs) const noexcept
+    {
+        return rhs < *this;
+    }
+
+    /**
+     * @copydoc operator==
+     */
+    [[nodiscard]] constexpr bool operator<=(const Iterator &rhs) const noexcept
+    {
+        return !(rhs < *this);
+    }
+
+    /**
+     * @copydoc operator==
+     */
+    [[nodiscard]] constexpr bool operator>=(const Iterator &rhs) const noexcept
+    {
+        return !(*this < rhs);
+    }
+
+    /**
+     * @brief Запрос итератора со смещением.
+     *
+     * @param offset Смещение
+     * @param iterator Итератор
+     *
+     * @return Итератор
+     */
+    [[nodiscard]] friend constexpr Iterator operator+(
+        difference_type offset,
+        const Iterator &iterator) noexcept
+    {
+        return iterator + offset;
+    }
 
 private:
     /**
-     * @brief Указатель на реализацию
+     * @brief Строка, на которую указывает итератор.
      */
-    std::unique_ptr<ResultIteratorImpl> impl_;
+    Row row_{};
 };
 
 }  // namespace tasp::db::pg
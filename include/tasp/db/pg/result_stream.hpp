@@ -0,0 +1,88 @@
+/**
+ * @file
+ * @brief Интерфейсы для потокового получения результата запроса к СУБД
+ * PostgreSQL.
+ */
+#ifndef TASP_DB_PG_RESULT_STREAM_HPP_
+#define TASP_DB_PG_RESULT_STREAM_HPP_
+
+#include <memory>
+
+#include <tasp/db/pg/result.hpp>
+
+namespace tasp::db::pg
+{
+
+class ResultStreamImpl;
+
+/**
+ * @brief Интерфейс потокового получения результата запроса к СУБД PostgreSQL.
+ *
+ * Строки результата передаются порциями по мере их получения от сервера, что
+ * позволяет обрабатывать результаты любого размера с ограниченным
+ * потреблением памяти. Пока поток существует, подключение занято и не может
+ * использоваться для других запросов. Если поток удаляется до получения всех
+ * строк, выполнение запроса отменяется.
+ *
+ * Пример:
+ * @code
+ * auto stream = connection.Stream("SELECT * FROM events");
+ * while (auto rows = stream->Next())
+ * {
+ *     for (const auto &row : *rows)
+ *     {
+ *         row.Value("name");
+ *     }
+ * }
+ * @endcode
+ *
+ * Класс скрывает от пользователя реализацию с помощью идиомы PIMPL
+ * (Pointer to Implementation – указатель на реализацию).
+ */
+class [[gnu::visibility("default")]] ResultStream final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param impl Указатель на реализацию
+     */
+    explicit ResultStream(std::unique_ptr<ResultStreamImpl> impl) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~ResultStream() noexcept;
+
+    /**
+     * @brief Статус выполнения запроса к СУБД.
+     *
+     * После получения всех строк показывает, завершился ли запрос без ошибок.
+     *
+     * @return Статус
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Запрос следующей порции строк результата.
+     *
+     * @return Указатель на результат с очередной порцией строк, nullptr если
+     * строки закончились или произошла ошибка
+     */
+    [[nodiscard]] std::unique_ptr<Result> Next() const noexcept;
+
+    ResultStream(const ResultStream &) = delete;
+    ResultStream(ResultStream &&) = delete;
+    ResultStream &operator=(const ResultStream &) = delete;
+    ResultStream &operator=(ResultStream &&) = delete;
+
+private:
+    /**
+     * @brief Указатель на реализацию.
+     */
+    std::unique_ptr<ResultStreamImpl> impl_;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_RESULT_STREAM_HPP_
@@ -0,0 +1,347 @@
+/**
+ * @file
+ * @brief Лексический разбор текста SQL-запросов к СУБД PostgreSQL.
+ */
+#ifndef TASP_DB_PG_SQL_HPP_
+#define TASP_DB_PG_SQL_HPP_
+
+#include <cstddef>
+#include <string_view>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Участок SQL-запроса, внутри которого не ищутся параметры.
+ *
+ * Правила разбора общие для запросов, разбираемых во время выполнения
+ * (формат {}), и запросов, разобранных во время компиляции (Query).
+ */
+struct SqlSpan
+{
+    /**
+     * @brief Вид участка.
+     */
+    enum class Kind
+    {
+        Code,       /*!< Текст запроса вне кавычек и комментариев */
+        Literal,    /*!< Строковая константа '...' */
+        Escaped,    /*!< Строковая константа с экранированием E'...' */
+        Identifier, /*!< Идентификатор в кавычках "..." */
+        Dollar,     /*!< Строка в долларовых кавычках $tag$...$tag$ */
+        Comment,    /*!< Строчный или блочный комментарий */
+    };
+
+    /**
+     * @brief Вид участка.
+     */
+    Kind kind;
+
+    /**
+     * @brief Позиция после конца участка, для Code - начало участка.
+     */
+    size_t end;
+
+    /**
+     * @brief Участок завершен, false - запрос закончился внутри участка.
+     */
+    bool closed;
+};
+
+/**
+ * @brief Проверка символа на принадлежность идентификатору.
+ *
+ * @param symbol Символ
+ *
+ * @return Результат проверки, символы UTF-8 вне ASCII считаются буквами
+ */
+[[nodiscard]] constexpr bool IsSqlWord(char symbol) noexcept
+{
+    return (symbol >= 'a' && symbol <= 'z') ||
+           (symbol >= 'A' && symbol <= 'Z') ||
+           (symbol >= '0' && symbol <= '9') || symbol == '_' ||
+           symbol == '$' || static_cast<unsigned char>(symbol) >= 0x80;
+}
+
+/**
+ * @brief Пропуск значения в кавычках.
+ *
+ * Удвоенная кавычка внутри значения считается частью значения, в константах
+ * E'...' символ после обратной косой черты не закрывает константу.
+ *
+ * @param sql SQL-запрос
+ * @param pos Позиция открывающей кавычки
+ * @param backslash Экранирование обратной косой чертой
+ *
+ * @return Участок до закрывающей кавычки включительно
+ */
+[[nodiscard]] constexpr SqlSpan SkipSqlQuoted(std::string_view sql,
+                                              size_t pos,
+                                              bool backslash) noexcept
+{
+    const char quote{sql[pos]};
+    for (++pos; pos < sql.size(); ++pos)
+    {
+        if (backslash && sql[pos] == '\\')
+        {
+            ++pos;
+            continue;
+        }
+
+        if (sql[pos] != quote)
+        {
+            continue;
+        }
+
+        if (pos + 1 < sql.size() && sql[pos + 1] == quote)
+        {
+            ++pos;
+            continue;
+        }
+
+        return {SqlSpan::Kind::Code, pos + 1, true};
+    }
+
+    return {SqlSpan::Kind::Code, sql.size(), false};
+}
+
+/**
+ * @brief Определение участка SQL-запроса, начинающегося с позиции pos.
+ *
+ * @param sql SQL-запрос
+ * @param pos Позиция в запросе, меньше sql.size()
+ *
+ * @return Участок. Для текста вне кавычек и комментариев - Kind::Code и
+ * end == pos
+ */
+[[nodiscard]] constexpr SqlSpan FindSqlSpan(std::string_view sql,
+                                            size_t pos) noexcept
+{
+    const char symbol{sql[pos]};
+    const char next{pos + 1 < sql.size() ? sql[pos + 1] : '\0'};
+    const bool word{pos != 0 && IsSqlWord(sql[pos - 1])};
+
+    if (symbol == '-' && next == '-')
+    {
+        const auto end = sql.find('\n', pos);
+        return end == std::string_view::npos
+                   ? SqlSpan{SqlSpan::Kind::Comment, sql.size(), true}
+                   : SqlSpan{SqlSpan::Kind::Comment, end + 1, true};
+    }
+
+    if (symbol == '/' && next == '*')
+    {
+        size_t depth{0};
+        for (; pos + 1 < sql.size(); ++pos)
+        {
+            if (sql[pos] == '/' && sql[pos + 1] == '*')
+            {
+                ++depth;
+                ++pos;
+            }
+            else if (sql[pos] == '*' && sql[pos + 1] == '/')
+            {
+                ++pos;
+                if (--depth == 0)
+                {
+                    return {SqlSpan::Kind::Comment, pos + 1, true};
+                }
+            }
+        }
+
+        return {SqlSpan::Kind::Comment, sql.size(), false};
+    }
+
+    if (symbol == '\'' || symbol == '"')
+    {
+        auto span = SkipSqlQuoted(sql, pos, false);
+        span.kind = symbol == '\'' ? SqlSpan::Kind::Literal
+                                   : SqlSpan::Kind::Identifier;
+        return span;
+    }
+
+    if ((symbol == 'E' || symbol == 'e') && next == '\'' && !word)
+    {
+        auto span = SkipSqlQuoted(sql, pos + 1, true);
+        span.kind = SqlSpan::Kind::Escaped;
+        return span;
+    }
+
+    // $1 - параметр, $tag$ - начало строки в долларовых кавычках. Внутри
+    // идентификатора символ $ допустим и ничего не открывает.
+    if (symbol == '$' && !word && !(next >= '0' && next <= '9'))
+    {
+        auto tag = pos + 1;
+        while (tag < sql.size() && IsSqlWord(sql[tag]) && sql[tag] != '$')
+        {
+            ++tag;
+        }
+
+        if (tag < sql.size() && sql[tag] == '$')
+        {
+            const auto open = sql.substr(pos, tag - pos + 1);
+            const auto close = sql.find(open, tag + 1);
+            return close == std::string_view::npos
+                       ? SqlSpan{SqlSpan::Kind::Dollar, sql.size(), false}
+                       : SqlSpan{SqlSpan::Kind::Dollar,
+                                 close + open.size(),
+                                 true};
+        }
+    }
+
+    return {SqlSpan::Kind::Code, pos, true};
+}
+
+/**
+ * @brief Проверка символа на пробельный.
+ *
+ * @param symbol Символ
+ *
+ * @return Результат проверки
+ */
+[[nodiscard]] constexpr bool IsSqlSpace(char symbol) noexcept
+{
+    return symbol == ' ' || symbol == '\t' || symbol == '\n' ||
+           symbol == '\r' || symbol == '\f' || symbol == '\v';
+}
+
+/**
+ * @brief Посимвольное получение нормализованного текста SQL-запроса.
+ *
+ * Вне кавычек последовательности пробельных символов и комментариев
+ * заменяются одним пробелом, в начале и в конце запроса удаляются.
+ * Содержимое кавычек не изменяется. Текст не копируется, поэтому
+ * нормализация используется при вычислении ключа запроса без выделения
+ * памяти.
+ */
+class SqlNormalizer final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param sql SQL-запрос
+     */
+    constexpr explicit SqlNormalizer(std::string_view sql) noexcept
+    : sql_(sql)
+    {
+    }
+
+    /**
+     * @brief Получение следующего символа нормализованного запроса.
+     *
+     * @param symbol Символ
+     *
+     * @return false - запрос закончился
+     */
+    [[nodiscard]] constexpr bool Next(char &symbol) noexcept
+    {
+        while (pos_ >= verbatim_ && pos_ < sql_.size())
+        {
+            const auto span = FindSqlSpan(sql_, pos_);
+            if (span.kind == SqlSpan::Kind::Comment)
+            {
+                pos_ = span.end;
+                space_ = true;
+            }
+            else if (span.kind != SqlSpan::Kind::Code)
+            {
+                verbatim_ = span.end;
+            }
+            else if (IsSqlSpace(sql_[pos_]))
+            {
+                ++pos_;
+                space_ = true;
+            }
+            else
+            {
+                verbatim_ = pos_ + 1;
+            }
+        }
+
+        if (pos_ >= sql_.size())
+        {
+            return false;
+        }
+
+        if (space_)
+        {
+            space_ = false;
+            if (started_)
+            {
+                symbol = ' ';
+                return true;
+            }
+        }
+
+        started_ = true;
+        symbol = sql_[pos_++];
+        return true;
+    }
+
+private:
+    /**
+     * @brief SQL-запрос.
+     */
+    std::string_view sql_;
+
+    /**
+     * @brief Позиция следующего символа.
+     */
+    size_t pos_{0};
+
+    /**
+     * @brief Позиция, до которой символы передаются без изменений.
+     */
+    size_t verbatim_{0};
+
+    /**
+     * @brief Перед следующим символом пропущены пробелы или комментарии.
+     */
+    bool space_{false};
+
+    /**
+     * @brief Передан хотя бы один символ.
+     */
+    bool started_{false};
+};
+
+/**
+ * @brief Сравнение нормализованных текстов SQL-запросов.
+ *
+ * @param lhs SQL-запрос
+ * @param rhs SQL-запрос
+ *
+ * @return true - запросы отличаются только пробелами и комментариями
+ */
+[[nodiscard]] constexpr bool SqlEqual(std::string_view lhs,
+                                      std::string_view rhs) noexcept
+{
+    SqlNormalizer left{lhs};
+    SqlNormalizer right{rhs};
+
+    char first{'\0'};
+    char second{'\0'};
+    for (;;)
+    {
+        const bool more = left.Next(first);
+        if (more != right.Next(second))
+        {
+            return false;
+        }
+
+        if (!more)
+        {
+            return true;
+        }
+
+        if (first != second)
+        {
+            return false;
+        }
+    }
+}
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_SQL_HPP_
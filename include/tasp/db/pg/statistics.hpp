@@ -0,0 +1,72 @@
+/**
+ * @file
+ * @brief Интерфейс статистики выполнения запросов к СУБД PostgreSQL.
+ */
+#ifndef TASP_DB_PG_STATISTICS_HPP_
+#define TASP_DB_PG_STATISTICS_HPP_
+
+#include <jsoncpp/json/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <tasp/db/pg/histogram.hpp>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Статистика выполнения запросов к СУБД PostgreSQL.
+ *
+ * Запросы группируются по нормализованному тексту: строковые и числовые
+ * константы заменяются на ?, последовательности пробельных символов и
+ * комментарии - на один пробел. Запросы, выполнение которых длится дольше
+ * заданного в конфигурационном файле порога, записываются в журнал. По
+ * умолчанию сбор статистики и журнал медленных запросов выключены.
+ */
+class [[gnu::visibility("default")]] Statistics final
+{
+public:
+    /**
+     * @brief Статистика запроса.
+     */
+    struct Query
+    {
+        std::string sql;    /*!< Нормализованный текст запроса */
+        size_t params{0};   /*!< Количество параметров запроса */
+        uint64_t calls{0};  /*!< Количество выполнений */
+        uint64_t errors{0}; /*!< Количество ошибок выполнения */
+        uint64_t rows{0};   /*!< Количество обработанных строк */
+        uint64_t bytes{0};  /*!< Объем результатов в байтах */
+        uint64_t slow{0};   /*!< Количество медленных выполнений */
+        std::chrono::microseconds max{0}; /*!< Максимальное время */
+        Histogram latency; /*!< Время выполнения */
+    };
+
+    /**
+     * @brief Запрос статистики всех выполнявшихся запросов.
+     *
+     * @return Статистика запросов
+     */
+    [[nodiscard]] static std::vector<Query> Queries() noexcept;
+
+    /**
+     * @brief Запрос статистики в формате JSON.
+     *
+     * @return Статистика запросов, длительности - в микросекундах
+     */
+    [[nodiscard]] static Json::Value JsonValue() noexcept;
+
+    /**
+     * @brief Сброс накопленной статистики.
+     */
+    static void Reset() noexcept;
+
+    Statistics() = delete;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_DB_PG_STATISTICS_HPP_
@@ -0,0 +1,149 @@
+#include "async_connect.hpp"
+
+#include <sys/epoll.h>
+
+#include <tasp/db/pg/executor.hpp>
+#include <tasp/logging.hpp>
+
+#include "authentication.hpp"
+#include "connection_impl.hpp"
+#include "reactor.hpp"
+
+using std::make_unique;
+using std::string_view;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    AsyncConnect
+------------------------------------------------------------------------------*/
+AsyncConnect::AsyncConnect(string_view name, Callback callback) noexcept
+: uri_(auth::Manager::Instance().Uri(name))
+, callback_(std::move(callback))
+{
+}
+
+//------------------------------------------------------------------------------
+AsyncConnect::~AsyncConnect() noexcept
+{
+    // Подключение не было передано обработчику.
+    if (conn_ != nullptr)
+    {
+        PQfinish(conn_);
+    }
+}
+
+//------------------------------------------------------------------------------
+void AsyncConnect::Start(std::chrono::nanoseconds timeout) noexcept
+{
+    conn_ = PQconnectStart(uri_.c_str());
+    if (conn_ == nullptr || PQstatus(conn_) == CONNECTION_BAD)
+    {
+        Complete();
+        return;
+    }
+
+    if (!Arm(PGRES_POLLING_WRITING))
+    {
+        Complete();
+        return;
+    }
+
+    // Параметр connect_timeout при асинхронном подключении не учитывается.
+    auto expire = [weak = weak_from_this()]
+    {
+        auto self = weak.lock();
+        if (self && !self->done_)
+        {
+            Logging::Error("Истекло время подключения к БД");
+            self->Complete();
+        }
+    };
+    timer_ = Reactor::Instance().After(timeout, std::move(expire));
+
+    // Подключение могло завершиться до регистрации таймера.
+    if (done_)
+    {
+        Reactor::Instance().Cancel(timer_.exchange(0));
+    }
+}
+
+//------------------------------------------------------------------------------
+void AsyncConnect::Handle() noexcept
+{
+    if (done_)
+    {
+        return;
+    }
+
+    const auto status = PQconnectPoll(conn_);
+    if (status == PGRES_POLLING_OK || status == PGRES_POLLING_FAILED ||
+        !Arm(status))
+    {
+        Complete();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool AsyncConnect::Arm(PostgresPollingStatusType status) noexcept
+{
+    const uint32_t events =
+        status == PGRES_POLLING_READING ? EPOLLIN : EPOLLOUT;
+
+    const auto descriptor = PQsocket(conn_);
+    if (descriptor == descriptor_)
+    {
+        return Reactor::Instance().Modify(descriptor_, events);
+    }
+
+    if (descriptor_ >= 0)
+    {
+        Reactor::Instance().Remove(descriptor_);
+        descriptor_ = -1;
+    }
+
+    // Дескриптор сохраняется до регистрации, т.к. обработчик может быть
+    // вызван в потоке цикла сразу после нее.
+    descriptor_ = descriptor;
+    if (!Reactor::Instance().Watch(descriptor_,
+                                   events,
+                                   [self = shared_from_this()](uint32_t)
+                                   {
+                                       self->Handle();
+                                   }))
+    {
+        descriptor_ = -1;
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void AsyncConnect::Complete() noexcept
+{
+    if (done_.exchange(true))
+    {
+        return;
+    }
+
+    Reactor::Instance().Cancel(timer_.exchange(0));
+
+    if (descriptor_ >= 0)
+    {
+        Reactor::Instance().Remove(descriptor_);
+        descriptor_ = -1;
+    }
+
+    Executor::Dispatch(
+        [self = shared_from_this()]
+        {
+            auto *conn = self->conn_;
+            self->conn_ = nullptr;
+            self->callback_(
+                make_unique<ConnectionImpl>(std::move(self->uri_), conn));
+        });
+}
+
+}  // namespace tasp::db::pg
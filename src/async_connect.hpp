@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @brief Асинхронное подключение к СУБД PostgreSQL.
+ */
+#ifndef TASP_ASYNC_CONNECT_HPP_
+#define TASP_ASYNC_CONNECT_HPP_
+
+#include <postgresql/libpq-fe.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace tasp::db::pg
+{
+
+class ConnectionImpl;
+
+/**
+ * @brief Асинхронное подключение к БД.
+ *
+ * Устанавливает подключение функциями PQconnectStart/PQconnectPoll, сокет
+ * подключения обслуживается циклом обработки событий (Reactor), поэтому
+ * подключение (в том числе TLS и GSS) не блокирует ни один поток. Несколько
+ * подключений устанавливаются параллельно. Обработчик завершения передается
+ * установленному исполнителю (Executor).
+ */
+class AsyncConnect final : public std::enable_shared_from_this<AsyncConnect>
+{
+public:
+    /**
+     * @brief Обработчик завершения подключения, получает подключение, в том
+     * числе неудачное (Status() == false).
+     */
+    using Callback = std::function<void(std::unique_ptr<ConnectionImpl>)>;
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param name Имя подключения к БД из конф. файла
+     * @param callback Обработчик завершения подключения
+     */
+    AsyncConnect(std::string_view name, Callback callback) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~AsyncConnect() noexcept;
+
+    /**
+     * @brief Старт подключения.
+     *
+     * @param timeout Максимальное время установки подключения
+     */
+    void Start(std::chrono::nanoseconds timeout) noexcept;
+
+    AsyncConnect(const AsyncConnect &) = delete;
+    AsyncConnect(AsyncConnect &&) = delete;
+    AsyncConnect &operator=(const AsyncConnect &) = delete;
+    AsyncConnect &operator=(AsyncConnect &&) = delete;
+
+private:
+    /**
+     * @brief Обработка готовности сокета подключения.
+     */
+    void Handle() noexcept;
+
+    /**
+     * @brief Ожидание готовности сокета, запрошенной PQconnectPoll.
+     *
+     * Сокет может меняться при переборе адресов сервера, поэтому при
+     * изменении он перерегистрируется в цикле.
+     *
+     * @param status Результат PQconnectPoll
+     *
+     * @return Результат регистрации сокета
+     */
+    [[nodiscard]] bool Arm(PostgresPollingStatusType status) noexcept;
+
+    /**
+     * @brief Завершение подключения и вызов обработчика.
+     */
+    void Complete() noexcept;
+
+    /**
+     * @brief Строка подключения к БД в формате PostgreSQL URI.
+     */
+    std::string uri_;
+
+    /**
+     * @brief Обработчик завершения подключения.
+     */
+    Callback callback_;
+
+    /**
+     * @brief Подключение к СУБД библиотеки libpq.
+     */
+    PGconn *conn_{nullptr};
+
+    /**
+     * @brief Сокет подключения, зарегистрированный в цикле.
+     */
+    int descriptor_{-1};
+
+    /**
+     * @brief Таймер ограничения времени подключения, 0 - не зарегистрирован.
+     */
+    std::atomic<uint64_t> timer_{0};
+
+    /**
+     * @brief Подключение завершено (успешно, с ошибкой или по таймауту).
+     */
+    std::atomic<bool> done_{false};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_ASYNC_CONNECT_HPP_
@@ -0,0 +1,189 @@
+#include "async_query.hpp"
+
+#include <sys/epoll.h>
+
+#include <tasp/db/pg/executor.hpp>
+#include <tasp/logging.hpp>
+
+#include "connection_impl.hpp"
+#include "observers.hpp"
+#include "query_stats.hpp"
+#include "reactor.hpp"
+
+using std::make_unique;
+using std::shared_ptr;
+using std::string_view;
+using std::vector;
+using std::chrono::steady_clock;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    AsyncQuery
+------------------------------------------------------------------------------*/
+AsyncQuery::AsyncQuery(shared_ptr<const ConnectionImpl> connection,
+                       AsyncCallback callback) noexcept
+: connection_(std::move(connection))
+, callback_(std::move(callback))
+{
+}
+
+//------------------------------------------------------------------------------
+AsyncQuery::~AsyncQuery() noexcept = default;
+
+//------------------------------------------------------------------------------
+void AsyncQuery::Start(string_view query,
+                       const Params &params,
+                       Result::Format format) noexcept
+{
+    auto *conn = connection_->Native();
+
+    observed_ = Observers::Active();
+    if (observed_ || QueryStats::Instance().Enabled())
+    {
+        query_ = query;
+        params_ = params.Size();
+        start_ = steady_clock::now();
+    }
+
+    if (observed_)
+    {
+        arguments_ = params;
+        Observers::Start({query_, arguments_, connection_.get()});
+    }
+
+    if (PQsetnonblocking(conn, 1) != 0 ||
+        !connection_->Send(query, params, format))
+    {
+        Complete();
+        return;
+    }
+
+    // В неблокирующем режиме запрос может быть отправлен не полностью,
+    // остаток дописывается по готовности сокета к записи.
+    const auto flush = PQflush(conn);
+    if (flush < 0)
+    {
+        Logging::Error("Ошибка отправки запроса к БД: {}",
+                       PQerrorMessage(conn));
+        Complete();
+        return;
+    }
+
+    // Дескриптор сохраняется до регистрации, т.к. обработчик может быть
+    // вызван в потоке цикла сразу после нее.
+    descriptor_ = PQsocket(conn);
+    const uint32_t events = flush == 0 ? EPOLLIN : EPOLLIN | EPOLLOUT;
+    if (!Reactor::Instance().Watch(
+            descriptor_,
+            events,
+            [self = shared_from_this()](uint32_t ready)
+            {
+                self->Handle(ready);
+            }))
+    {
+        descriptor_ = -1;
+        Wait();
+    }
+}
+
+//------------------------------------------------------------------------------
+void AsyncQuery::Handle(uint32_t events) noexcept
+{
+    auto *conn = connection_->Native();
+
+    if ((events & EPOLLOUT) != 0)
+    {
+        const auto flush = PQflush(conn);
+        if (flush < 0)
+        {
+            Logging::Error("Ошибка отправки запроса к БД: {}",
+                           PQerrorMessage(conn));
+            Complete();
+            return;
+        }
+
+        if (flush == 0)
+        {
+            Reactor::Instance().Modify(descriptor_, EPOLLIN);
+        }
+    }
+
+    if (PQconsumeInput(conn) != 1)
+    {
+        Logging::Error("Ошибка получения результата запроса: {}",
+                       PQerrorMessage(conn));
+        Complete();
+        return;
+    }
+
+    while (PQisBusy(conn) == 0)
+    {
+        auto *result = PQgetResult(conn);
+        if (result == nullptr)
+        {
+            Complete();
+            return;
+        }
+
+        result_ = make_unique<ResultImpl>(result);
+    }
+}
+
+//------------------------------------------------------------------------------
+void AsyncQuery::Wait() noexcept
+{
+    auto *conn = connection_->Native();
+
+    PQsetnonblocking(conn, 0);
+    while (auto *result = PQgetResult(conn))
+    {
+        result_ = make_unique<ResultImpl>(result);
+    }
+
+    Complete();
+}
+
+//------------------------------------------------------------------------------
+void AsyncQuery::Complete() noexcept
+{
+    if (descriptor_ >= 0)
+    {
+        Reactor::Instance().Remove(descriptor_);
+        descriptor_ = -1;
+    }
+
+    PQsetnonblocking(connection_->Native(), 0);
+
+    if (!result_)
+    {
+        result_ = make_unique<ResultImpl>(nullptr);
+    }
+
+    if (!query_.empty())
+    {
+        const auto elapsed = steady_clock::now() - start_;
+        QueryStats::Instance().Record(query_, 0, params_, elapsed, *result_);
+
+        if (observed_)
+        {
+            Observers::Finish({query_,
+                               arguments_,
+                               connection_.get(),
+                               elapsed,
+                               result_->Error()});
+        }
+    }
+
+    // Обработчик может сразу отправить в подключение следующий запрос,
+    // поэтому вызывается после удаления сокета из цикла.
+    Executor::Dispatch(
+        [self = shared_from_this()]
+        {
+            auto callback = std::move(self->callback_);
+            callback(std::move(self->result_));
+        });
+}
+
+}  // namespace tasp::db::pg
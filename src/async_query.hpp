@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief Асинхронное выполнение запроса к СУБД PostgreSQL.
+ */
+#ifndef TASP_ASYNC_QUERY_HPP_
+#define TASP_ASYNC_QUERY_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <tasp/db/pg/params.hpp>
+#include <tasp/db/pg/result.hpp>
+
+#include "result_impl.hpp"
+
+namespace tasp::db::pg
+{
+
+class ConnectionImpl;
+
+/**
+ * @brief Обработчик завершения асинхронного запроса.
+ */
+using AsyncCallback = std::function<void(std::unique_ptr<ResultImpl>)>;
+
+/**
+ * @brief Асинхронный запрос.
+ *
+ * Отправляет запрос в неблокирующем режиме libpq и регистрирует сокет
+ * подключения в цикле обработки событий (Reactor). Результат читается в
+ * потоке цикла по мере поступления данных, после получения всех результатов
+ * обработчик завершения передается установленному исполнителю (Executor).
+ * Объект живет, пока сокет зарегистрирован в цикле.
+ */
+class AsyncQuery final : public std::enable_shared_from_this<AsyncQuery>
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param connection Подключение к БД
+     * @param callback Обработчик завершения запроса
+     */
+    AsyncQuery(std::shared_ptr<const ConnectionImpl> connection,
+               AsyncCallback callback) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~AsyncQuery() noexcept;
+
+    /**
+     * @brief Отправка запроса.
+     *
+     * При ошибке отправки обработчик завершения вызывается в текущем потоке.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     */
+    void Start(std::string_view query,
+               const Params &params,
+               Result::Format format) noexcept;
+
+    AsyncQuery(const AsyncQuery &) = delete;
+    AsyncQuery(AsyncQuery &&) = delete;
+    AsyncQuery &operator=(const AsyncQuery &) = delete;
+    AsyncQuery &operator=(AsyncQuery &&) = delete;
+
+private:
+    /**
+     * @brief Обработка событий сокета подключения.
+     *
+     * @param events Маска событий epoll
+     */
+    void Handle(uint32_t events) noexcept;
+
+    /**
+     * @brief Получение оставшихся результатов в блокирующем режиме.
+     *
+     * Используется, если сокет не удалось зарегистрировать в цикле.
+     */
+    void Wait() noexcept;
+
+    /**
+     * @brief Завершение запроса и вызов обработчика.
+     */
+    void Complete() noexcept;
+
+    /**
+     * @brief Подключение к БД.
+     */
+    std::shared_ptr<const ConnectionImpl> connection_;
+
+    /**
+     * @brief Обработчик завершения запроса.
+     */
+    AsyncCallback callback_;
+
+    /**
+     * @brief Результат последней команды запроса.
+     */
+    std::unique_ptr<ResultImpl> result_{};
+
+    /**
+     * @brief Сокет подключения, зарегистрированный в цикле, -1 - сокет не
+     * зарегистрирован.
+     */
+    int descriptor_{-1};
+
+    /**
+     * @brief SQL-запрос для статистики и наблюдателей, пустой - статистика
+     * не собирается.
+     */
+    std::string query_{};
+
+    /**
+     * @brief Количество параметров запроса.
+     */
+    size_t params_{0};
+
+    /**
+     * @brief Параметры запроса, сохраняются только для наблюдателей.
+     */
+    Params arguments_{};
+
+    /**
+     * @brief Событие запроса передается наблюдателям.
+     */
+    bool observed_{false};
+
+    /**
+     * @brief Время отправки запроса.
+     */
+    std::chrono::steady_clock::time_point start_{};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_ASYNC_QUERY_HPP_
@@ -0,0 +1,105 @@
+#include "atomic_histogram.hpp"
+
+#include <algorithm>
+
+using std::memory_order_relaxed;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Преобразование длительности в неотрицательное количество
+ * микросекунд.
+ *
+ * @param duration Длительность
+ *
+ * @return Длительность в микросекундах
+ */
+static inline microseconds Microseconds(
+    steady_clock::duration duration) noexcept
+{
+    return std::max(duration_cast<microseconds>(duration), microseconds{0});
+}
+
+/*------------------------------------------------------------------------------
+    AtomicHistogram
+------------------------------------------------------------------------------*/
+AtomicHistogram::AtomicHistogram() noexcept = default;
+
+//------------------------------------------------------------------------------
+AtomicHistogram::~AtomicHistogram() noexcept = default;
+
+//------------------------------------------------------------------------------
+void AtomicHistogram::Record(steady_clock::duration duration) noexcept
+{
+    const auto value = Microseconds(duration);
+
+    buckets_[Bucket(value)].fetch_add(1, memory_order_relaxed);
+    count_.fetch_add(1, memory_order_relaxed);
+    sum_.fetch_add(static_cast<uint64_t>(value.count()), memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void AtomicHistogram::Fill(Histogram &snapshot) const noexcept
+{
+    for (size_t index = 0; index < snapshot.buckets.size(); ++index)
+    {
+        snapshot.buckets[index] = buckets_[index].load(memory_order_relaxed);
+    }
+
+    const auto sum = sum_.load(memory_order_relaxed);
+
+    snapshot.count = count_.load(memory_order_relaxed);
+    snapshot.sum = microseconds{static_cast<microseconds::rep>(sum)};
+}
+
+//------------------------------------------------------------------------------
+void AtomicHistogram::Record(Histogram &histogram,
+                             steady_clock::duration duration) noexcept
+{
+    const auto value = Microseconds(duration);
+
+    ++histogram.buckets[Bucket(value)];
+    ++histogram.count;
+    histogram.sum += value;
+}
+
+//------------------------------------------------------------------------------
+Json::Value AtomicHistogram::JsonValue(const Histogram &histogram) noexcept
+{
+    Json::Value buckets{Json::arrayValue};
+    for (size_t index = 0; index < histogram.buckets.size(); ++index)
+    {
+        Json::Value bucket{Json::objectValue};
+        if (index < Histogram::bounds.size())
+        {
+            bucket["le"] = Json::Int64{Histogram::bounds[index].count()};
+        }
+        else
+        {
+            bucket["le"] = Json::nullValue;
+        }
+        bucket["count"] = Json::UInt64{histogram.buckets[index]};
+        buckets.append(bucket);
+    }
+
+    Json::Value json{Json::objectValue};
+    json["count"] = Json::UInt64{histogram.count};
+    json["sum"] = Json::Int64{histogram.sum.count()};
+    json["buckets"] = buckets;
+
+    return json;
+}
+
+//------------------------------------------------------------------------------
+size_t AtomicHistogram::Bucket(microseconds value) noexcept
+{
+    const auto &bounds = Histogram::bounds;
+    return static_cast<size_t>(
+        std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin());
+}
+
+}  // namespace tasp::db::pg
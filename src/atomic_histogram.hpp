@@ -0,0 +1,108 @@
+/**
+ * @file
+ * @brief Гистограмма длительностей с атомарными счетчиками.
+ */
+#ifndef TASP_ATOMIC_HISTOGRAM_HPP_
+#define TASP_ATOMIC_HISTOGRAM_HPP_
+
+#include <jsoncpp/json/json.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <tasp/db/pg/histogram.hpp>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Гистограмма длительностей с атомарными счетчиками.
+ *
+ * Значения добавляются без блокировок, поэтому снимок не согласован между
+ * отдельными счетчиками.
+ */
+class AtomicHistogram final
+{
+public:
+    /**
+     * @brief Конструктор.
+     */
+    AtomicHistogram() noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~AtomicHistogram() noexcept;
+
+    /**
+     * @brief Добавление значения.
+     *
+     * @param duration Длительность
+     */
+    void Record(std::chrono::steady_clock::duration duration) noexcept;
+
+    /**
+     * @brief Заполнение снимка гистограммы.
+     *
+     * @param snapshot Снимок гистограммы
+     */
+    void Fill(Histogram &snapshot) const noexcept;
+
+    /**
+     * @brief Добавление значения в снимок гистограммы.
+     *
+     * Используется для гистограмм, защищенных мьютексом.
+     *
+     * @param histogram Гистограмма
+     * @param duration Длительность
+     */
+    static void Record(Histogram &histogram,
+                       std::chrono::steady_clock::duration duration) noexcept;
+
+    /**
+     * @brief Преобразование снимка гистограммы в JSON.
+     *
+     * @param histogram Снимок гистограммы
+     *
+     * @return Гистограмма, длительности - в микросекундах
+     */
+    [[nodiscard]] static Json::Value JsonValue(
+        const Histogram &histogram) noexcept;
+
+    AtomicHistogram(const AtomicHistogram &) = delete;
+    AtomicHistogram(AtomicHistogram &&) = delete;
+    AtomicHistogram &operator=(const AtomicHistogram &) = delete;
+    AtomicHistogram &operator=(AtomicHistogram &&) = delete;
+
+private:
+    /**
+     * @brief Номер корзины для значения.
+     *
+     * @param value Длительность
+     *
+     * @return Номер корзины
+     */
+    [[nodiscard]] static size_t Bucket(
+        std::chrono::microseconds value) noexcept;
+
+    /**
+     * @brief Количество значений в корзинах.
+     */
+    std::array<std::atomic<uint64_t>, Histogram::bounds.size() + 1> buckets_{};
+
+    /**
+     * @brief Общее количество значений.
+     */
+    std::atomic<uint64_t> count_{0};
+
+    /**
+     * @brief Сумма значений в микросекундах.
+     */
+    std::atomic<uint64_t> sum_{0};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_ATOMIC_HISTOGRAM_HPP_
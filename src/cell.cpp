@@ -0,0 +1,1266 @@
+#include "cell.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <tasp/logging.hpp>
+
+using std::string;
+using std::string_view;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Количество микросекунд между 1970-01-01 и 2000-01-01 (эпоха
+ * PostgreSQL).
+ */
+static constexpr int64_t postgres_epoch{946684800000000};
+
+/**
+ * @brief Количество микросекунд в сутках.
+ */
+static constexpr int64_t day_microseconds{86400000000};
+
+//------------------------------------------------------------------------------
+static inline uint64_t ReadUnsigned(const char *data, size_t size) noexcept
+{
+    uint64_t value{0};
+    for (size_t index = 0; index < size; ++index)
+    {
+        value = (value << 8U) | static_cast<unsigned char>(data[index]);
+    }
+
+    return value;
+}
+
+//------------------------------------------------------------------------------
+template<typename Type>
+static inline Type ReadInteger(const char *data) noexcept
+{
+    using Unsigned = std::make_unsigned_t<Type>;
+    return static_cast<Type>(
+        static_cast<Unsigned>(ReadUnsigned(data, sizeof(Type))));
+}
+
+//------------------------------------------------------------------------------
+template<typename Type, typename Integer>
+static inline Type ReadFloat(const char *data) noexcept
+{
+    const auto bits = static_cast<Integer>(ReadUnsigned(data, sizeof(Type)));
+
+    Type value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//------------------------------------------------------------------------------
+static inline bool ParseEightDigits(const char *data, uint64_t &value) noexcept
+{
+    // Восемь символов обрабатываются как одно 64-битное число (SWAR): первый
+    // символ - в младшем байте, проверка и сложение цифр выполняются для
+    // всех байт одновременно.
+    uint64_t chunk{0};
+    std::memcpy(&chunk, data, sizeof(chunk));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+
+    if (((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+         (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) !=
+        0x3333333333333333ULL)
+    {
+        return false;
+    }
+
+    chunk = ((chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    value = ((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static inline bool ParseInteger(string_view text, int64_t &value) noexcept
+{
+    // 19 цифр вмещаются в uint64_t без переполнения.
+    static constexpr size_t max_digits{19};
+
+    const auto *data = text.data();
+    auto size = text.size();
+
+    const auto negative = size != 0 && *data == '-';
+    if (negative)
+    {
+        ++data;
+        --size;
+    }
+
+    while (size > 1 && *data == '0')
+    {
+        ++data;
+        --size;
+    }
+
+    if (size == 0 || size > max_digits)
+    {
+        return false;
+    }
+
+    uint64_t result{0};
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        uint64_t chunk{0};
+        if (!ParseEightDigits(data, chunk))
+        {
+            return false;
+        }
+        result = result * 100000000 + chunk;
+    }
+
+    for (; size != 0; ++data, --size)
+    {
+        const auto digit = static_cast<unsigned char>(*data - '0');
+        if (digit > 9)
+        {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+
+    const auto limit =
+        static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) +
+        (negative ? 1 : 0);
+    if (result > limit)
+    {
+        return false;
+    }
+
+    value = negative ? static_cast<int64_t>(0 - result)
+                     : static_cast<int64_t>(result);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<typename Type>
+static inline bool Narrow(int64_t value, Type &result) noexcept
+{
+    if (value < std::numeric_limits<Type>::min() ||
+        value > std::numeric_limits<Type>::max())
+    {
+        return false;
+    }
+
+    result = static_cast<Type>(value);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static inline bool ParseDouble(string_view text, double &value) noexcept
+{
+#if defined(__cpp_lib_to_chars)
+    const auto *end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value);
+    return error == std::errc{} && ptr == end;
+#else
+    const string copy{text};
+    char *end{nullptr};
+    value = std::strtod(copy.c_str(), &end);
+    return !copy.empty() && end == copy.c_str() + copy.size();
+#endif
+}
+
+//------------------------------------------------------------------------------
+template<typename Type>
+static inline string FormatFloat(Type value) noexcept
+{
+    if (std::isnan(value))
+    {
+        return "NaN";
+    }
+
+    if (std::isinf(value))
+    {
+        return value > 0 ? "Infinity" : "-Infinity";
+    }
+
+    std::array<char, 32> buffer{};
+#if defined(__cpp_lib_to_chars)
+    const auto [ptr, error] =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    return {buffer.data(), ptr};
+#else
+    const auto size = std::snprintf(buffer.data(),
+                                    buffer.size(),
+                                    "%.*g",
+                                    std::numeric_limits<Type>::max_digits10,
+                                    static_cast<double>(value));
+    return {buffer.data(), static_cast<size_t>(size)};
+#endif
+}
+
+//------------------------------------------------------------------------------
+static inline int64_t DaysFromCivil(int64_t year,
+                                    int64_t month,
+                                    int64_t day) noexcept
+{
+    year -= month <= 2 ? 1 : 0;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t year_of_era = year - era * 400;
+    const int64_t day_of_year =
+        (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t day_of_era =
+        year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+//------------------------------------------------------------------------------
+static inline void CivilFromDays(int64_t days,
+                                 int64_t &year,
+                                 int64_t &month,
+                                 int64_t &day) noexcept
+{
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const int64_t day_of_era = days - era * 146097;
+    const int64_t year_of_era =
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524 -
+         day_of_era / 146096) /
+        365;
+    const int64_t day_of_year =
+        day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const int64_t month_position = (5 * day_of_year + 2) / 153;
+
+    day = day_of_year - (153 * month_position + 2) / 5 + 1;
+    month = month_position < 10 ? month_position + 3 : month_position - 9;
+    year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+//------------------------------------------------------------------------------
+static inline Timestamp ToTimestamp(int64_t unix_microseconds) noexcept
+{
+    return Timestamp{
+        duration_cast<Timestamp::duration>(microseconds{unix_microseconds})};
+}
+
+//------------------------------------------------------------------------------
+static inline string FormatTimestamp(int64_t value, bool date, bool zone)
+{
+    auto days = value / day_microseconds;
+    auto time = value % day_microseconds;
+    if (time < 0)
+    {
+        time += day_microseconds;
+        --days;
+    }
+
+    int64_t year{0};
+    int64_t month{0};
+    int64_t day{0};
+    CivilFromDays(days, year, month, day);
+
+    std::array<char, 48> buffer{};
+    auto size = std::snprintf(buffer.data(),
+                              buffer.size(),
+                              "%04lld-%02lld-%02lld",
+                              static_cast<long long>(year),
+                              static_cast<long long>(month),
+                              static_cast<long long>(day));
+    if (date)
+    {
+        return {buffer.data(), static_cast<size_t>(size)};
+    }
+
+    const auto seconds = time / 1000000;
+    size += std::snprintf(buffer.data() + size,
+                          buffer.size() - static_cast<size_t>(size),
+                          " %02lld:%02lld:%02lld",
+                          static_cast<long long>(seconds / 3600),
+                          static_cast<long long>(seconds / 60 % 60),
+                          static_cast<long long>(seconds % 60));
+
+    if (const auto fraction = time % 1000000; fraction != 0)
+    {
+        size += std::snprintf(buffer.data() + size,
+                              buffer.size() - static_cast<size_t>(size),
+                              ".%06lld",
+                              static_cast<long long>(fraction));
+        while (buffer.at(static_cast<size_t>(size - 1)) == '0')
+        {
+            --size;
+        }
+    }
+
+    string text{buffer.data(), static_cast<size_t>(size)};
+    if (zone)
+    {
+        text.append("+00");
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+static inline bool ParseDigits(string_view text,
+                               size_t &pos,
+                               size_t count,
+                               int64_t &value) noexcept
+{
+    if (pos + count > text.size())
+    {
+        return false;
+    }
+
+    value = 0;
+    for (auto end = pos + count; pos < end; ++pos)
+    {
+        const auto symbol = text[pos];
+        if (symbol < '0' || symbol > '9')
+        {
+            return false;
+        }
+        value = value * 10 + (symbol - '0');
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static inline bool Expect(string_view text, size_t &pos, char symbol) noexcept
+{
+    if (pos < text.size() && text[pos] == symbol)
+    {
+        ++pos;
+        return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+static inline bool ParseTimestamp(string_view text, int64_t &value) noexcept
+{
+    size_t pos{0};
+    int64_t year{0};
+    int64_t month{0};
+    int64_t day{0};
+
+    if (!ParseDigits(text, pos, 4, year) || !Expect(text, pos, '-') ||
+        !ParseDigits(text, pos, 2, month) || !Expect(text, pos, '-') ||
+        !ParseDigits(text, pos, 2, day))
+    {
+        return false;
+    }
+
+    value = DaysFromCivil(year, month, day) * day_microseconds;
+    if (pos == text.size())
+    {
+        return true;
+    }
+
+    int64_t hour{0};
+    int64_t minute{0};
+    int64_t second{0};
+    if ((!Expect(text, pos, ' ') && !Expect(text, pos, 'T')) ||
+        !ParseDigits(text, pos, 2, hour) || !Expect(text, pos, ':') ||
+        !ParseDigits(text, pos, 2, minute) || !Expect(text, pos, ':') ||
+        !ParseDigits(text, pos, 2, second))
+    {
+        return false;
+    }
+
+    value += ((hour * 60 + minute) * 60 + second) * 1000000;
+
+    if (Expect(text, pos, '.'))
+    {
+        int64_t scale{100000};
+        for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9';
+             ++pos, scale /= 10)
+        {
+            value += (text[pos] - '0') * scale;
+        }
+    }
+
+    if (pos == text.size())
+    {
+        return true;
+    }
+
+    const auto sign = text[pos] == '-' ? -1 : 1;
+    if (!Expect(text, pos, '+') && !Expect(text, pos, '-'))
+    {
+        return false;
+    }
+
+    int64_t zone_hour{0};
+    int64_t zone_minute{0};
+    int64_t zone_second{0};
+    if (!ParseDigits(text, pos, 2, zone_hour))
+    {
+        return false;
+    }
+
+    if (Expect(text, pos, ':') && !ParseDigits(text, pos, 2, zone_minute))
+    {
+        return false;
+    }
+
+    if (Expect(text, pos, ':') && !ParseDigits(text, pos, 2, zone_second))
+    {
+        return false;
+    }
+
+    value -= sign * ((zone_hour * 60 + zone_minute) * 60 + zone_second) *
+             1000000;
+    return pos == text.size();
+}
+
+//------------------------------------------------------------------------------
+static inline int HexValue(char symbol) noexcept
+{
+    if (symbol >= '0' && symbol <= '9')
+    {
+        return symbol - '0';
+    }
+
+    if (symbol >= 'a' && symbol <= 'f')
+    {
+        return symbol - 'a' + 10;
+    }
+
+    if (symbol >= 'A' && symbol <= 'F')
+    {
+        return symbol - 'A' + 10;
+    }
+
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+static inline string FormatUuid(const char *data)
+{
+    static constexpr string_view digits{"0123456789abcdef"};
+
+    string text;
+    text.reserve(36);
+    for (size_t index = 0; index < 16; ++index)
+    {
+        if (index == 4 || index == 6 || index == 8 || index == 10)
+        {
+            text.push_back('-');
+        }
+
+        const auto byte = static_cast<unsigned char>(data[index]);
+        text.push_back(digits[byte >> 4U]);
+        text.push_back(digits[byte & 0x0FU]);
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+static inline string FormatBytea(string_view data)
+{
+    static constexpr string_view digits{"0123456789abcdef"};
+
+    string text;
+    text.reserve(2 + data.size() * 2);
+    text.append("\\x");
+    for (const auto symbol : data)
+    {
+        const auto byte = static_cast<unsigned char>(symbol);
+        text.push_back(digits[byte >> 4U]);
+        text.push_back(digits[byte & 0x0FU]);
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+static inline string FormatNumeric(const char *data, int length)
+{
+    if (length < 8)
+    {
+        return {};
+    }
+
+    const auto digits = ReadInteger<int16_t>(data);
+    const auto weight = ReadInteger<int16_t>(data + 2);
+    const auto sign = ReadInteger<uint16_t>(data + 4);
+    const auto scale = ReadInteger<int16_t>(data + 6);
+
+    switch (sign)
+    {
+        case 0xC000:
+            return "NaN";
+        case 0xD000:
+            return "Infinity";
+        case 0xF000:
+            return "-Infinity";
+        default:
+            break;
+    }
+
+    if (length < 8 + digits * 2)
+    {
+        return {};
+    }
+
+    const auto digit = [data, digits](int index) -> int
+    {
+        return index >= 0 && index < digits
+                   ? ReadInteger<int16_t>(data + 8 + index * 2)
+                   : 0;
+    };
+
+    string text;
+    if (sign == 0x4000)
+    {
+        text.push_back('-');
+    }
+
+    std::array<char, 8> buffer{};
+    if (weight < 0)
+    {
+        text.push_back('0');
+    }
+
+    for (int index = 0; index <= weight; ++index)
+    {
+        const auto size = std::snprintf(
+            buffer.data(), buffer.size(), index == 0 ? "%d" : "%04d",
+            digit(index));
+        text.append(buffer.data(), static_cast<size_t>(size));
+    }
+
+    if (scale > 0)
+    {
+        string fraction;
+        for (int index = weight + 1;
+             fraction.size() < static_cast<size_t>(scale);
+             ++index)
+        {
+            const auto size = std::snprintf(
+                buffer.data(), buffer.size(), "%04d", digit(index));
+            fraction.append(buffer.data(), static_cast<size_t>(size));
+        }
+        fraction.resize(static_cast<size_t>(scale));
+
+        text.push_back('.');
+        text.append(fraction);
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+static inline void AppendArrayElement(string &text, string_view element)
+{
+    bool quote = element.empty() || element == "NULL" || element == "null";
+    for (const auto symbol : element)
+    {
+        if (symbol == '{' || symbol == '}' || symbol == ',' || symbol == '"' ||
+            symbol == '\\' || symbol == ' ' || symbol == '\t' ||
+            symbol == '\n' || symbol == '\r')
+        {
+            quote = true;
+            break;
+        }
+    }
+
+    if (!quote)
+    {
+        text.append(element);
+        return;
+    }
+
+    text.push_back('"');
+    for (const auto symbol : element)
+    {
+        if (symbol == '"' || symbol == '\\')
+        {
+            text.push_back('\\');
+        }
+        text.push_back(symbol);
+    }
+    text.push_back('"');
+}
+
+/*------------------------------------------------------------------------------
+    Cell
+------------------------------------------------------------------------------*/
+Cell::Cell(const PGresult *result, int row, int column) noexcept
+: data_(PQgetisnull(result, row, column) != 0
+            ? nullptr
+            : PQgetvalue(result, row, column))
+, length_(PQgetlength(result, row, column))
+, type_(PQftype(result, column))
+, binary_(PQfformat(result, column) == 1)
+{
+}
+
+//------------------------------------------------------------------------------
+Cell::Cell(const char *data, int length, Oid type, bool binary) noexcept
+: data_(data)
+, length_(length)
+, type_(type)
+, binary_(binary)
+{
+}
+
+//------------------------------------------------------------------------------
+bool Cell::IsNull() const noexcept
+{
+    return data_ == nullptr;
+}
+
+//------------------------------------------------------------------------------
+Oid Cell::Type() const noexcept
+{
+    return type_;
+}
+
+//------------------------------------------------------------------------------
+string Cell::Text() const noexcept
+{
+    if (IsNull())
+    {
+        return {};
+    }
+
+    if (!binary_)
+    {
+        return string{Data()};
+    }
+
+    switch (type_)
+    {
+        case oid::boolean:
+            return length_ == 1 && data_[0] != 0 ? "t" : "f";
+        case oid::int2:
+        case oid::int4:
+        case oid::int8:
+        {
+            int64_t value{0};
+            return Get(value) ? std::to_string(value) : string{};
+        }
+        case oid::oid:
+            return length_ == 4 ? std::to_string(ReadInteger<uint32_t>(data_))
+                                : string{};
+        case oid::float4:
+            return length_ == 4 ? FormatFloat(ReadFloat<float, uint32_t>(data_))
+                                : string{};
+        case oid::float8:
+            return length_ == 8
+                       ? FormatFloat(ReadFloat<double, uint64_t>(data_))
+                       : string{};
+        case oid::numeric:
+            return FormatNumeric(data_, length_);
+        case oid::uuid:
+            return length_ == 16 ? FormatUuid(data_) : string{};
+        case oid::bytea:
+            return FormatBytea(Data());
+        case oid::date:
+            return length_ == 4
+                       ? FormatTimestamp(ReadInteger<int32_t>(data_) *
+                                                 day_microseconds +
+                                             postgres_epoch,
+                                         true,
+                                         false)
+                       : string{};
+        case oid::timestamp:
+        case oid::timestamptz:
+            return length_ == 8
+                       ? FormatTimestamp(
+                             ReadInteger<int64_t>(data_) + postgres_epoch,
+                             false,
+                             type_ == oid::timestamptz)
+                       : string{};
+        default:
+            break;
+    }
+
+    if (oid::Element(type_) != InvalidOid)
+    {
+        string text;
+        if (ArrayText(text))
+        {
+            return text;
+        }
+
+        Logging::Error("Ошибка разбора массива в двоичном формате, OID {}",
+                       type_);
+        return {};
+    }
+
+    // Байты двоичного формата неизвестного типа не являются текстом и не
+    // должны попадать в строки и JSON.
+    string_view view;
+    if (Get(view))
+    {
+        return string{view};
+    }
+
+    Logging::Error("Тип с OID {} в двоичном формате не преобразуется в текст",
+                   type_);
+    return {};
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(bool &value) const noexcept
+{
+    if (IsNull())
+    {
+        return false;
+    }
+
+    if (binary_)
+    {
+        if (type_ != oid::boolean || length_ != 1)
+        {
+            return false;
+        }
+
+        value = data_[0] != 0;
+        return true;
+    }
+
+    const auto text = Data();
+    if (text == "t" || text == "true")
+    {
+        value = true;
+        return true;
+    }
+
+    if (text == "f" || text == "false")
+    {
+        value = false;
+        return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(int16_t &value) const noexcept
+{
+    int64_t result{0};
+    return Get(result) && Narrow(result, value);
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(int32_t &value) const noexcept
+{
+    int64_t result{0};
+    return Get(result) && Narrow(result, value);
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(int64_t &value) const noexcept
+{
+    if (IsNull())
+    {
+        return false;
+    }
+
+    if (!binary_)
+    {
+        return ParseInteger(Data(), value);
+    }
+
+    switch (type_)
+    {
+        case oid::int2:
+            if (length_ != 2)
+            {
+                return false;
+            }
+            value = ReadInteger<int16_t>(data_);
+            return true;
+        case oid::int4:
+            if (length_ != 4)
+            {
+                return false;
+            }
+            value = ReadInteger<int32_t>(data_);
+            return true;
+        case oid::int8:
+            if (length_ != 8)
+            {
+                return false;
+            }
+            value = ReadInteger<int64_t>(data_);
+            return true;
+        case oid::oid:
+            if (length_ != 4)
+            {
+                return false;
+            }
+            value = ReadInteger<uint32_t>(data_);
+            return true;
+        case oid::numeric:
+            return ParseInteger(FormatNumeric(data_, length_), value);
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(float &value) const noexcept
+{
+    if (binary_ && type_ == oid::float4 && length_ == 4)
+    {
+        value = ReadFloat<float, uint32_t>(data_);
+        return true;
+    }
+
+    double result{0};
+    if (!Get(result))
+    {
+        return false;
+    }
+
+    value = static_cast<float>(result);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(double &value) const noexcept
+{
+    if (IsNull())
+    {
+        return false;
+    }
+
+    if (!binary_)
+    {
+        return ParseDouble(Data(), value);
+    }
+
+    switch (type_)
+    {
+        case oid::float4:
+            if (length_ != 4)
+            {
+                return false;
+            }
+            value = static_cast<double>(ReadFloat<float, uint32_t>(data_));
+            return true;
+        case oid::float8:
+            if (length_ != 8)
+            {
+                return false;
+            }
+            value = ReadFloat<double, uint64_t>(data_);
+            return true;
+        case oid::numeric:
+            return ParseDouble(FormatNumeric(data_, length_), value);
+        default:
+        {
+            int64_t result{0};
+            if (!Get(result))
+            {
+                return false;
+            }
+
+            value = static_cast<double>(result);
+            return true;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(string &value) const noexcept
+{
+    if (IsNull())
+    {
+        return false;
+    }
+
+    value = Text();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(string_view &value) const noexcept
+{
+    if (IsNull())
+    {
+        return false;
+    }
+
+    if (!binary_)
+    {
+        value = Data();
+        return true;
+    }
+
+    switch (type_)
+    {
+        case oid::bytea:
+        case oid::name:
+        case oid::text:
+        case oid::json:
+        case oid::bpchar:
+        case oid::varchar:
+            value = Data();
+            return true;
+        case oid::jsonb:
+            // Первый байт - версия формата jsonb.
+            if (length_ < 1)
+            {
+                return false;
+            }
+            value = Data().substr(1);
+            return true;
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(Timestamp &value) const noexcept
+{
+    if (IsNull())
+    {
+        return false;
+    }
+
+    int64_t result{0};
+    if (!binary_)
+    {
+        if (!ParseTimestamp(Data(), result))
+        {
+            return false;
+        }
+
+        value = ToTimestamp(result);
+        return true;
+    }
+
+    switch (type_)
+    {
+        case oid::timestamp:
+        case oid::timestamptz:
+            if (length_ != 8)
+            {
+                return false;
+            }
+            value = ToTimestamp(ReadInteger<int64_t>(data_) + postgres_epoch);
+            return true;
+        case oid::date:
+            if (length_ != 4)
+            {
+                return false;
+            }
+            value = ToTimestamp(ReadInteger<int32_t>(data_) * day_microseconds +
+                                postgres_epoch);
+            return true;
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Cell::Get(Uuid &value) const noexcept
+{
+    if (IsNull())
+    {
+        return false;
+    }
+
+    if (binary_)
+    {
+        if (type_ != oid::uuid || length_ != 16)
+        {
+            return false;
+        }
+
+        std::memcpy(value.data(), data_, value.size());
+        return true;
+    }
+
+    size_t byte{0};
+    int high{-1};
+    for (const auto symbol : Data())
+    {
+        if (symbol == '-' || symbol == '{' || symbol == '}')
+        {
+            continue;
+        }
+
+        const auto digit = HexValue(symbol);
+        if (digit < 0 || byte == value.size())
+        {
+            return false;
+        }
+
+        if (high < 0)
+        {
+            high = digit;
+            continue;
+        }
+
+        value.at(byte++) = static_cast<uint8_t>((high << 4) | digit);
+        high = -1;
+    }
+
+    return byte == value.size() && high < 0;
+}
+
+//------------------------------------------------------------------------------
+string_view Cell::Data() const noexcept
+{
+    return {data_, static_cast<size_t>(length_)};
+}
+
+//------------------------------------------------------------------------------
+bool Cell::ArrayText(string &text) const noexcept
+{
+    if (length_ < 12)
+    {
+        return false;
+    }
+
+    const auto dimensions = ReadInteger<int32_t>(data_);
+    const auto element_type = ReadInteger<uint32_t>(data_ + 8);
+    if (dimensions < 0 || dimensions > 6 || length_ < 12 + dimensions * 8)
+    {
+        return false;
+    }
+
+    std::array<int32_t, 6> sizes{};
+    for (int32_t dimension = 0; dimension < dimensions; ++dimension)
+    {
+        sizes.at(static_cast<size_t>(dimension)) =
+            ReadInteger<int32_t>(data_ + 12 + dimension * 8);
+    }
+
+    const auto *pos = data_ + 12 + dimensions * 8;
+    const auto *end = data_ + length_;
+
+    if (dimensions == 0)
+    {
+        text = "{}";
+        return true;
+    }
+
+    const auto append = [&](const auto &self, int32_t dimension) -> bool
+    {
+        text.push_back('{');
+        const auto size = sizes.at(static_cast<size_t>(dimension));
+        for (int32_t index = 0; index < size; ++index)
+        {
+            if (index != 0)
+            {
+                text.push_back(',');
+            }
+
+            if (dimension + 1 < dimensions)
+            {
+                if (!self(self, dimension + 1))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            if (end - pos < 4)
+            {
+                return false;
+            }
+
+            const auto length = ReadInteger<int32_t>(pos);
+            pos += 4;
+            if (length < 0)
+            {
+                text.append("NULL");
+                continue;
+            }
+
+            if (end - pos < length)
+            {
+                return false;
+            }
+
+            AppendArrayElement(text,
+                               Cell{pos, length, element_type, true}.Text());
+            pos += length;
+        }
+        text.push_back('}');
+        return true;
+    };
+
+    return append(append, 0);
+}
+
+//------------------------------------------------------------------------------
+template<typename Value>
+size_t Cell::Column(const PGresult *result,
+                    int column,
+                    ColumnValues<Value> &values) noexcept
+{
+    const auto rows = PQntuples(result);
+    const auto size = static_cast<size_t>(rows);
+
+    values.values.assign(size, {});
+    values.nulls.assign((size + 63) / 64, 0);
+
+    if (column < 0 || column >= PQnfields(result))
+    {
+        std::fill(values.nulls.begin(), values.nulls.end(), ~uint64_t{0});
+        return 0;
+    }
+
+    const auto type = PQftype(result, column);
+    const auto binary = PQfformat(result, column) == 1;
+
+    size_t failed{0};
+    const auto decode = [result, column, rows, &values, &failed](auto read)
+    {
+        for (int row = 0; row < rows; ++row)
+        {
+            const auto index = static_cast<size_t>(row);
+            const auto null = uint64_t{1} << (index % 64);
+
+            if (PQgetisnull(result, row, column) != 0)
+            {
+                values.nulls[index / 64] |= null;
+                continue;
+            }
+
+            Value value{};
+            if (!read(PQgetvalue(result, row, column),
+                      PQgetlength(result, row, column),
+                      value))
+            {
+                values.nulls[index / 64] |= null;
+                ++failed;
+                continue;
+            }
+
+            values.values[index] = value;
+        }
+    };
+
+    if constexpr (std::is_integral_v<Value> && !std::is_same_v<Value, bool>)
+    {
+        const auto fixed = [&decode](auto width)
+        {
+            using Integer = decltype(width);
+            decode(
+                [](const char *data, int length, Value &value)
+                {
+                    return static_cast<size_t>(length) == sizeof(Integer) &&
+                           Narrow(int64_t{ReadInteger<Integer>(data)}, value);
+                });
+        };
+
+        switch (binary ? type : InvalidOid)
+        {
+            case oid::int2:
+                fixed(int16_t{});
+                return failed;
+            case oid::int4:
+                fixed(int32_t{});
+                return failed;
+            case oid::int8:
+                fixed(int64_t{});
+                return failed;
+            default:
+                break;
+        }
+
+        if (!binary && (type == oid::int2 || type == oid::int4 ||
+                        type == oid::int8 || type == oid::oid))
+        {
+            decode(
+                [](const char *data, int length, Value &value)
+                {
+                    int64_t number{0};
+                    return ParseInteger({data, static_cast<size_t>(length)},
+                                        number) &&
+                           Narrow(number, value);
+                });
+            return failed;
+        }
+    }
+
+    if constexpr (std::is_same_v<Value, double>)
+    {
+        if (binary && type == oid::float8)
+        {
+            decode(
+                [](const char *data, int length, double &value)
+                {
+                    if (length != 8)
+                    {
+                        return false;
+                    }
+
+                    value = ReadFloat<double, uint64_t>(data);
+                    return true;
+                });
+            return failed;
+        }
+    }
+
+    decode(
+        [type, binary](const char *data, int length, Value &value)
+        {
+            return Cell{data, length, type, binary}.Get(value);
+        });
+    return failed;
+}
+
+template size_t Cell::Column(const PGresult *,
+                             int,
+                             ColumnValues<bool> &) noexcept;
+template size_t Cell::Column(const PGresult *,
+                             int,
+                             ColumnValues<int16_t> &) noexcept;
+template size_t Cell::Column(const PGresult *,
+                             int,
+                             ColumnValues<int32_t> &) noexcept;
+template size_t Cell::Column(const PGresult *,
+                             int,
+                             ColumnValues<int64_t> &) noexcept;
+template size_t Cell::Column(const PGresult *,
+                             int,
+                             ColumnValues<float> &) noexcept;
+template size_t Cell::Column(const PGresult *,
+                             int,
+                             ColumnValues<double> &) noexcept;
+template size_t Cell::Column(const PGresult *,
+                             int,
+                             ColumnValues<Timestamp> &) noexcept;
+
+/*------------------------------------------------------------------------------
+    Преобразование значений в формат PostgreSQL
+------------------------------------------------------------------------------*/
+int64_t PostgresTime(const Timestamp &value) noexcept
+{
+    return duration_cast<microseconds>(value.time_since_epoch()).count() -
+           postgres_epoch;
+}
+
+//------------------------------------------------------------------------------
+string TimestampText(const Timestamp &value)
+{
+    return FormatTimestamp(PostgresTime(value) + postgres_epoch, false, true);
+}
+
+//------------------------------------------------------------------------------
+string UuidText(const Uuid &value)
+{
+    return FormatUuid(reinterpret_cast<const char *>(value.data()));
+}
+
+}  // namespace tasp::db::pg
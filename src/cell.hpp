@@ -0,0 +1,303 @@
+/**
+ * @file
+ * @brief Декодирование значений ячеек результата запроса к СУБД PostgreSQL.
+ */
+#ifndef TASP_CELL_HPP_
+#define TASP_CELL_HPP_
+
+#include <postgresql/libpq-fe.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <tasp/db/pg/result.hpp>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Идентификаторы (OID) встроенных типов PostgreSQL.
+ */
+namespace oid
+{
+constexpr Oid boolean{16};
+constexpr Oid bytea{17};
+constexpr Oid name{19};
+constexpr Oid int8{20};
+constexpr Oid int2{21};
+constexpr Oid int4{23};
+constexpr Oid text{25};
+constexpr Oid oid{26};
+constexpr Oid json{114};
+constexpr Oid float4{700};
+constexpr Oid float8{701};
+constexpr Oid bpchar{1042};
+constexpr Oid varchar{1043};
+constexpr Oid date{1082};
+constexpr Oid timestamp{1114};
+constexpr Oid timestamptz{1184};
+constexpr Oid numeric{1700};
+constexpr Oid uuid{2950};
+constexpr Oid jsonb{3802};
+
+/**
+ * @brief Типы массивов встроенных типов и типы их элементов.
+ *
+ * Массивы этих типов преобразуются из двоичного формата в текстовый (Cell)
+ * и в массивы JSON (JsonType).
+ */
+constexpr std::array<std::pair<Oid, Oid>, 19> arrays{{
+    {1000, boolean},
+    {1001, bytea},
+    {1003, name},
+    {1005, int2},
+    {1007, int4},
+    {1009, text},
+    {1014, bpchar},
+    {1015, varchar},
+    {1016, int8},
+    {1021, float4},
+    {1022, float8},
+    {1028, oid},
+    {1115, timestamp},
+    {1182, date},
+    {1185, timestamptz},
+    {1231, numeric},
+    {2951, uuid},
+    {199, json},
+    {3807, jsonb},
+}};
+
+/**
+ * @brief Определение типа элементов массива.
+ *
+ * @param type OID типа данных
+ *
+ * @return OID типа элементов, InvalidOid - тип не является массивом
+ * встроенного типа
+ */
+[[nodiscard]] constexpr Oid Element(Oid type) noexcept
+{
+    for (const auto &[array, element] : arrays)
+    {
+        if (array == type)
+        {
+            return element;
+        }
+    }
+
+    return InvalidOid;
+}
+}  // namespace oid
+
+/**
+ * @brief Значение ячейки результата запроса.
+ *
+ * Не владеет данными, декодирует значение из текстового или двоичного
+ * представления libpq без промежуточных копий.
+ */
+class Cell final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param result Результат выполнения запроса к СУБД библиотеки libpq
+     * @param row Номер строки
+     * @param column Номер столбца
+     */
+    Cell(const PGresult *result, int row, int column) noexcept;
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param data Указатель на данные, nullptr - значение NULL
+     * @param length Длина данных
+     * @param type OID типа данных
+     * @param binary Данные в двоичном формате
+     */
+    Cell(const char *data, int length, Oid type, bool binary) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~Cell() noexcept = default;
+
+    /**
+     * @brief Проверка значения на NULL.
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] bool IsNull() const noexcept;
+
+    /**
+     * @brief Запрос OID типа данных.
+     *
+     * @return OID типа данных
+     */
+    [[nodiscard]] Oid Type() const noexcept;
+
+    /**
+     * @brief Запрос значения в текстовом представлении PostgreSQL.
+     *
+     * Значения в двоичном формате преобразуются в текстовое представление,
+     * bytea - в шестнадцатеричный формат \\x... Для типов, двоичный формат
+     * которых не поддерживается, записывается ошибка в журнал и возвращается
+     * пустая строка.
+     *
+     * @return Значение
+     */
+    [[nodiscard]] std::string Text() const noexcept;
+
+    /**
+     * @brief Запрос значения с преобразованием в тип переменной.
+     *
+     * @param value Переменная для значения
+     *
+     * @return Результат преобразования, false для NULL и для значений, которые
+     * нельзя преобразовать в тип переменной
+     */
+    [[nodiscard]] bool Get(bool &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(int16_t &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(int32_t &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(int64_t &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(float &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(double &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(std::string &value) const noexcept;
+
+    /**
+     * @brief Запрос значения без копирования.
+     *
+     * Возвращает данные в том виде, в котором они получены от сервера, т.е.
+     * для двоичного формата - только для строковых типов.
+     *
+     * @param value Переменная для значения
+     *
+     * @return Результат преобразования
+     */
+    [[nodiscard]] bool Get(std::string_view &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(Timestamp &value) const noexcept;
+
+    /**
+     * @copydoc Get(bool &) const
+     */
+    [[nodiscard]] bool Get(Uuid &value) const noexcept;
+
+    /**
+     * @brief Декодирование всех значений столбца.
+     *
+     * Способ преобразования выбирается один раз для столбца: целые числа в
+     * текстовом формате разбираются блоками по 8 цифр, числа в двоичном
+     * формате читаются без проверки типа для каждого значения.
+     *
+     * @param result Результат выполнения запроса к СУБД библиотеки libpq
+     * @param column Номер столбца
+     * @param values Значения столбца
+     *
+     * @return Количество значений, которые нельзя преобразовать в тип Value
+     */
+    template<typename Value>
+    [[nodiscard]] static size_t Column(const PGresult *result,
+                                       int column,
+                                       ColumnValues<Value> &values) noexcept;
+
+private:
+    /**
+     * @brief Запрос данных в виде строки.
+     *
+     * @return Данные
+     */
+    [[nodiscard]] std::string_view Data() const noexcept;
+
+    /**
+     * @brief Преобразование двоичного массива в текстовое представление.
+     *
+     * @param text Строка для результата
+     *
+     * @return Результат преобразования
+     */
+    [[nodiscard]] bool ArrayText(std::string &text) const noexcept;
+
+    /**
+     * @brief Указатель на данные, nullptr - значение NULL.
+     */
+    const char *data_;
+
+    /**
+     * @brief Длина данных.
+     */
+    int length_;
+
+    /**
+     * @brief OID типа данных.
+     */
+    Oid type_;
+
+    /**
+     * @brief Данные в двоичном формате.
+     */
+    bool binary_;
+};
+
+/**
+ * @brief Преобразование момента времени в количество микросекунд от
+ * 2000-01-01 (эпоха PostgreSQL), как в двоичном формате timestamp.
+ *
+ * @param value Момент времени
+ *
+ * @return Количество микросекунд
+ */
+[[nodiscard]] int64_t PostgresTime(const Timestamp &value) noexcept;
+
+/**
+ * @brief Текстовое представление момента времени в формате PostgreSQL (UTC).
+ *
+ * @param value Момент времени
+ *
+ * @return Строка вида 2000-01-01 00:00:00.000001+00
+ */
+[[nodiscard]] std::string TimestampText(const Timestamp &value);
+
+/**
+ * @brief Текстовое представление uuid.
+ *
+ * @param value Значение uuid
+ *
+ * @return Строка вида a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11
+ */
+[[nodiscard]] std::string UuidText(const Uuid &value);
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_CELL_HPP_
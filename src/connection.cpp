@@ -3,9 +3,11 @@
 #include "connection_impl.hpp"
 
 using std::any;
+using std::future;
 using std::make_shared;
 using std::make_unique;
 using std::shared_ptr;
+using std::string;
 using std::string_view;
 using std::unique_ptr;
 using std::vector;
@@ -34,7 +36,108 @@ Connection::~Connection() noexcept = default;
 unique_ptr<Result> Connection::Exec(string_view query,
                                     const vector<any> &params) const noexcept
 {
-    return make_unique<Result>(impl_->Exec(query, params));
+    const Params values{params};
+    return Exec(Result::Format::Text, query, values);
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<Result> Connection::Exec(Result::Format format,
+                                    string_view query,
+                                    const vector<any> &params) const noexcept
+{
+    const Params values{params};
+    return Exec(format, query, values);
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<Result> Connection::Exec(Result::Format format,
+                                    string_view query,
+                                    const Params &params) const noexcept
+{
+    return make_unique<Result>(impl_->Exec(query, params, format));
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<Result> Connection::Exec(Result::Format format,
+                                    const QueryText &query,
+                                    const Params &params) const noexcept
+{
+    return make_unique<Result>(
+        impl_->Exec(query.sql, params, format, &query));
+}
+
+//------------------------------------------------------------------------------
+future<unique_ptr<Result>> Connection::ExecAsync(
+    string_view query,
+    const vector<any> &params) const noexcept
+{
+    const Params values{params};
+    return ExecAsync(query, values);
+}
+
+//------------------------------------------------------------------------------
+future<unique_ptr<Result>> Connection::ExecAsync(
+    string_view query,
+    const Params &params) const noexcept
+{
+    auto promise = make_shared<std::promise<unique_ptr<Result>>>();
+    auto result = promise->get_future();
+
+    ExecAsync(
+        [promise](unique_ptr<Result> value)
+        {
+            promise->set_value(std::move(value));
+        },
+        Result::Format::Text,
+        query,
+        params);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void Connection::ExecAsync(Callback callback,
+                           Result::Format format,
+                           string_view query,
+                           const vector<any> &params) const noexcept
+{
+    const Params values{params};
+    ExecAsync(std::move(callback), format, query, values);
+}
+
+//------------------------------------------------------------------------------
+void Connection::ExecAsync(Callback callback,
+                           Result::Format format,
+                           string_view query,
+                           const Params &params) const noexcept
+{
+    impl_->ExecAsync(query,
+                     params,
+                     format,
+                     [callback = std::move(callback)](
+                         unique_ptr<ResultImpl> result)
+                     {
+                         callback(make_unique<Result>(std::move(result)));
+                     });
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultStream> Connection::Stream(
+    Result::Format format,
+    string_view query,
+    const vector<any> &params) const noexcept
+{
+    const Params values{params};
+    return Stream(format, query, values);
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultStream> Connection::Stream(
+    Result::Format format,
+    string_view query,
+    const Params &params) const noexcept
+{
+    return make_unique<ResultStream>(impl_->Stream(query, params, format));
 }
 
 //------------------------------------------------------------------------------
@@ -49,4 +152,37 @@ unique_ptr<Transaction> Connection::BeginTransaction() const noexcept
     return make_unique<Transaction>(impl_->BeginTransaction());
 }
 
+//------------------------------------------------------------------------------
+void Connection::BeginTransactionAsync(
+    std::function<void(unique_ptr<Transaction>)> callback) const noexcept
+{
+    impl_->BeginTransactionAsync(
+        [callback = std::move(callback)](unique_ptr<TransactionImpl> impl)
+        {
+            callback(make_unique<Transaction>(std::move(impl)));
+        });
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<Pipeline> Connection::BeginPipeline() const noexcept
+{
+    return make_unique<Pipeline>(impl_->BeginPipeline());
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<CopyIn> Connection::BeginCopyIn(string_view table,
+                                           const vector<string> &columns,
+                                           CopyIn::Format format) const noexcept
+{
+    return make_unique<CopyIn>(impl_->BeginCopyIn(table, columns, format));
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<CopyOut> Connection::BeginCopyOut(
+    string_view query,
+    CopyOut::Format format) const noexcept
+{
+    return make_unique<CopyOut>(impl_->BeginCopyOut(query, format));
+}
+
 }  // namespace tasp::db::pg
@@ -1,35 +1,71 @@
 #include "connection_impl.hpp"
 
+#include <poll.h>
+
+#include <array>
 #include <experimental/filesystem>
-#include <sstream>
 
+#include <tasp/config.hpp>
 #include <tasp/logging.hpp>
 
 #include "authentication.hpp"
+#include "observers.hpp"
+#include "query_stats.hpp"
+#include "statement.hpp"
 
 using std::any;
 using std::any_cast;
+using std::make_shared;
 using std::make_unique;
 using std::string;
 using std::string_view;
-using std::stringstream;
-using std::to_string;
 using std::type_index;
 using std::unique_ptr;
 using std::vector;
+using std::chrono::steady_clock;
 
 namespace fs = std::experimental::filesystem;
 
 namespace tasp::db::pg
 {
 
+/**
+ * @brief Код ошибки PostgreSQL: подготовленный запрос не найден.
+ */
+static constexpr string_view invalid_statement_name{"26000"};
+
 /*------------------------------------------------------------------------------
     ConnectionImpl
 ------------------------------------------------------------------------------*/
 ConnectionImpl::ConnectionImpl(string_view name) noexcept
 : uri_(auth::Manager::Instance().Uri(name))
 , conn_(PQconnectdb(uri_.c_str()), PQfinish)
+, statements_(
+      ConfigGlobal::Instance().Get<size_t>("database.statements.cache", 64),
+      ConfigGlobal::Instance().Get<size_t>("database.statements.threshold",
+                                           2))
+{
+    Observers::Configure();
+
+    Logging::Debug("Подключение к БД: {}", uri_);
+    if (!Status())
+    {
+        Logging::Error("Ошибка при подключении к БД: {}",
+                       PQerrorMessage(conn_.get()));
+    }
+}
+
+//------------------------------------------------------------------------------
+ConnectionImpl::ConnectionImpl(string uri, PGconn *conn) noexcept
+: uri_(std::move(uri))
+, conn_(conn, PQfinish)
+, statements_(
+      ConfigGlobal::Instance().Get<size_t>("database.statements.cache", 64),
+      ConfigGlobal::Instance().Get<size_t>("database.statements.threshold",
+                                           2))
 {
+    Observers::Configure();
+
     Logging::Debug("Подключение к БД: {}", uri_);
     if (!Status())
     {
@@ -56,41 +92,107 @@ bool ConnectionImpl::Status() const noexcept
 //------------------------------------------------------------------------------
 unique_ptr<ResultImpl> ConnectionImpl::Exec(
     string_view query,
-    const vector<any> &params) const noexcept
+    const Params &params,
+    Result::Format format,
+    const QueryText *compiled) const noexcept
 {
-    if (!Status())
+    if (compiled != nullptr && compiled->sql.empty())
+    {
+        Logging::Error("Запрос с ошибками разбора не выполняется");
+        return make_unique<ResultImpl>(nullptr);
+    }
+
+    auto &stats = QueryStats::Instance();
+    const auto observed = Observers::Active();
+    if (!observed && !stats.Enabled())
+    {
+        return Execute(query, params, format, compiled);
+    }
+
+    Observer::Query event{query, params, this};
+    if (observed)
     {
-        Logging::Error("Нет подключения к БД, нельзя выполнить запрос. "
-                       "Выполняется попытка переподключения к БД.");
-        if (!Reconnect())
+        Observers::Start(event);
+    }
+
+    const auto start = steady_clock::now();
+    auto result = Execute(query, params, format, compiled);
+    const auto elapsed = steady_clock::now() - start;
+
+    stats.Record(query,
+                 compiled != nullptr ? compiled->hash : 0,
+                 params.Size(),
+                 elapsed,
+                 *result);
+
+    if (observed)
+    {
+        event.duration = elapsed;
+        event.error = result->Error();
+        Observers::Finish(event);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultImpl> ConnectionImpl::Execute(
+    string_view query,
+    const Params &params,
+    Result::Format format,
+    const QueryText *compiled) const noexcept
+{
+    if (!Check())
+    {
+        return make_unique<ResultImpl>(nullptr);
+    }
+
+    if (params.Size() == 0 && format == Result::Format::Text)
+    {
+        if (compiled != nullptr)
         {
-            return make_unique<ResultImpl>(nullptr);
+            return make_unique<ResultImpl>(
+                PQexec(conn_.get(), compiled->sql.data()));
         }
+
+        return make_unique<ResultImpl>(
+            PQexec(conn_.get(), string{query}.c_str()));
     }
 
-    const string format_pattern{"{}"};
-    string sql{query};
+    if (statements_.Capacity() == 0)
+    {
+        return ExecParams(query, params, format, compiled);
+    }
 
-    for (const auto &value : params)
+    const auto hash = compiled != nullptr ? compiled->hash : QueryHash(query);
+    const auto *prepared = statements_.Find(query, hash, params.Size());
+    if (prepared == nullptr)
     {
-        const auto visitor{any_visitor_.find(type_index(value.type()))};
-        if (visitor == any_visitor_.cend())
+        if (!statements_.Hit(hash, params.Size()))
         {
-            Logging::Error("Неизвестный тип данных: {}", value.type().name());
-            return make_unique<ResultImpl>(nullptr);
+            return ExecParams(query, params, format, compiled);
         }
 
-        auto pos = sql.find(format_pattern);
-        if (pos == string::npos)
+        auto result = Prepare(query, params.Size(), compiled);
+        if (!result->Status())
         {
-            break;
+            return result;
         }
 
-        sql.replace(pos, format_pattern.length(), visitor->second(value));
+        prepared = statements_.Find(query, hash, params.Size());
     }
 
-    Logging::Debug("Выполняется запрос к БД: {}", sql);
-    return make_unique<ResultImpl>(PQexec(conn_.get(), sql.c_str()));
+    return ExecPrepared(*prepared, params, format);
+}
+
+//------------------------------------------------------------------------------
+void ConnectionImpl::ExecAsync(string_view query,
+                               const Params &params,
+                               Result::Format format,
+                               AsyncCallback callback) const noexcept
+{
+    make_shared<AsyncQuery>(shared_from_this(), std::move(callback))
+        ->Start(query, params, format);
 }
 
 //------------------------------------------------------------------------------
@@ -99,10 +201,332 @@ unique_ptr<TransactionImpl> ConnectionImpl::BeginTransaction() const noexcept
     return make_unique<TransactionImpl>(shared_from_this());
 }
 
+//------------------------------------------------------------------------------
+void ConnectionImpl::BeginTransactionAsync(
+    std::function<void(unique_ptr<TransactionImpl>)> callback) const noexcept
+{
+    Logging::Debug("Старт транзакции");
+    ExecAsync("BEGIN",
+              {},
+              Result::Format::Text,
+              [self = shared_from_this(), callback = std::move(callback)](
+                  unique_ptr<ResultImpl> result)
+              {
+                  callback(
+                      make_unique<TransactionImpl>(self, result->Status()));
+              });
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<PipelineImpl> ConnectionImpl::BeginPipeline() const noexcept
+{
+    return make_unique<PipelineImpl>(shared_from_this());
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<CopyInImpl> ConnectionImpl::BeginCopyIn(
+    string_view table,
+    const vector<string> &columns,
+    CopyIn::Format format) const noexcept
+{
+    return make_unique<CopyInImpl>(shared_from_this(), table, columns, format);
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<CopyOutImpl> ConnectionImpl::BeginCopyOut(
+    string_view query,
+    CopyOut::Format format) const noexcept
+{
+    return make_unique<CopyOutImpl>(shared_from_this(), query, format);
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultImpl> ConnectionImpl::ExecParams(
+    string_view query,
+    const Params &params,
+    Result::Format format,
+    const QueryText *compiled) const noexcept
+{
+    if (compiled != nullptr)
+    {
+        return ExecParams(*compiled, params, format);
+    }
+
+    const Statement statement{query, params.Size()};
+    CheckPlaceholders(statement, params.Size());
+
+    return ExecParams(
+        QueryText{statement.Sql(), statement.Params(), 0}, params, format);
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultImpl> ConnectionImpl::ExecParams(
+    const QueryText &statement,
+    const Params &params,
+    Result::Format format) const noexcept
+{
+    vector<const char *> values;
+    if (!Convert(params, statement.params, values))
+    {
+        return make_unique<ResultImpl>(nullptr);
+    }
+
+    return make_unique<ResultImpl>(PQexecParams(conn_.get(),
+                                                statement.sql.data(),
+                                                static_cast<int>(values.size()),
+                                                nullptr,
+                                                values.data(),
+                                                nullptr,
+                                                nullptr,
+                                                static_cast<int>(format)));
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultImpl> ConnectionImpl::ExecPrepared(
+    const StatementCache::Entry &prepared,
+    const Params &params,
+    Result::Format format) const noexcept
+{
+    vector<const char *> values;
+    if (!Convert(params, prepared.params, values))
+    {
+        return make_unique<ResultImpl>(nullptr);
+    }
+
+    auto *result = PQexecPrepared(conn_.get(),
+                                  prepared.name.c_str(),
+                                  static_cast<int>(values.size()),
+                                  values.data(),
+                                  nullptr,
+                                  nullptr,
+                                  static_cast<int>(format));
+
+    // Подготовленный запрос мог быть удален на сервере (DEALLOCATE, DISCARD),
+    // в этом случае запрос выполняется без подготовки и будет подготовлен
+    // заново при следующем вызове. Внутри транзакции ошибка прерывает
+    // транзакцию, повторное выполнение в ней невозможно, поэтому
+    // возвращается исходная ошибка.
+    const auto *state = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    if (state != nullptr && string_view{state} == invalid_statement_name)
+    {
+        Logging::Warning("Подготовленный запрос {} отсутствует на сервере",
+                         prepared.name);
+
+        const string query{prepared.query};
+        statements_.Remove(query, params.Size());
+        if (PQtransactionStatus(conn_.get()) == PQTRANS_INERROR)
+        {
+            return make_unique<ResultImpl>(result);
+        }
+
+        PQclear(result);
+        return ExecParams(query, params, format);
+    }
+
+    return make_unique<ResultImpl>(result);
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultImpl> ConnectionImpl::Prepare(
+    string_view query,
+    size_t arguments,
+    const QueryText *compiled) const noexcept
+{
+    if (compiled != nullptr)
+    {
+        return Prepare(query, arguments, *compiled);
+    }
+
+    const Statement statement{query, arguments};
+    CheckPlaceholders(statement, arguments);
+
+    return Prepare(
+        query,
+        arguments,
+        QueryText{statement.Sql(), statement.Params(), QueryHash(query)});
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultImpl> ConnectionImpl::Prepare(
+    string_view query,
+    size_t arguments,
+    const QueryText &statement) const noexcept
+{
+    auto name = statements_.NextName();
+    Logging::Debug("Подготовка запроса к БД {}", name);
+    auto result = make_unique<ResultImpl>(
+        PQprepare(conn_.get(),
+                  name.c_str(),
+                  statement.sql.data(),
+                  static_cast<int>(statement.params),
+                  nullptr));
+    if (!result->Status())
+    {
+        return result;
+    }
+
+    const auto evicted = statements_.Add(
+        query, statement.hash, arguments, statement.params, std::move(name));
+    if (!evicted.empty())
+    {
+        Logging::Debug("Удаление подготовленного запроса к БД {}", evicted);
+        PQclear(PQexec(conn_.get(), ("DEALLOCATE " + evicted).c_str()));
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultStreamImpl> ConnectionImpl::Stream(
+    string_view query,
+    const Params &params,
+    Result::Format format) const noexcept
+{
+    return make_unique<ResultStreamImpl>(
+        shared_from_this(), query, params, format);
+}
+
+//------------------------------------------------------------------------------
+bool ConnectionImpl::Send(string_view query,
+                          const Params &params,
+                          Result::Format format) const noexcept
+{
+    if (!Check())
+    {
+        return false;
+    }
+
+    // В режиме конвейера PQsendQuery не допускается.
+#if defined(LIBPQ_HAS_PIPELINING)
+    const auto simple = PQpipelineStatus(conn_.get()) == PQ_PIPELINE_OFF;
+#else
+    const auto simple = true;
+#endif
+
+    const auto *prepared = statements_.Capacity() != 0
+                               ? statements_.Find(query, params.Size())
+                               : nullptr;
+
+    int sent{0};
+    if (simple && params.Size() == 0 && format == Result::Format::Text)
+    {
+        sent = PQsendQuery(conn_.get(), string{query}.c_str());
+    }
+    else if (prepared != nullptr)
+    {
+        vector<const char *> values;
+        if (!Convert(params, prepared->params, values))
+        {
+            return false;
+        }
+
+        sent = PQsendQueryPrepared(conn_.get(),
+                                   prepared->name.c_str(),
+                                   static_cast<int>(values.size()),
+                                   values.data(),
+                                   nullptr,
+                                   nullptr,
+                                   static_cast<int>(format));
+    }
+    else
+    {
+        const Statement statement{query, params.Size()};
+        CheckPlaceholders(statement, params.Size());
+
+        vector<const char *> values;
+        if (!Convert(params, statement.Params(), values))
+        {
+            return false;
+        }
+
+        sent = PQsendQueryParams(conn_.get(),
+                                 statement.Sql().c_str(),
+                                 static_cast<int>(values.size()),
+                                 nullptr,
+                                 values.data(),
+                                 nullptr,
+                                 nullptr,
+                                 static_cast<int>(format));
+    }
+
+    if (sent != 1)
+    {
+        Logging::Error("Ошибка отправки запроса к БД: {}",
+                       PQerrorMessage(conn_.get()));
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+PGconn *ConnectionImpl::Native() const noexcept
+{
+    return conn_.get();
+}
+
+//------------------------------------------------------------------------------
+bool ConnectionImpl::Check() const noexcept
+{
+    if (Status())
+    {
+        return true;
+    }
+
+    Logging::Error("Нет подключения к БД, нельзя выполнить запрос. "
+                   "Выполняется попытка переподключения к БД.");
+    return Reconnect();
+}
+
+//------------------------------------------------------------------------------
+bool ConnectionImpl::Alive() const noexcept
+{
+    if (!Status())
+    {
+        return false;
+    }
+
+    pollfd descriptor{PQsocket(conn_.get()), POLLIN, 0};
+    if (poll(&descriptor, 1, 0) <= 0)
+    {
+        return true;
+    }
+
+    // При закрытии подключения сервером PQconsumeInput получает конец потока
+    // и переводит подключение в состояние CONNECTION_BAD.
+    return PQconsumeInput(conn_.get()) == 1 && Status();
+}
+
+//------------------------------------------------------------------------------
+std::chrono::steady_clock::time_point ConnectionImpl::Created() const noexcept
+{
+    return created_;
+}
+
+//------------------------------------------------------------------------------
+void ConnectionImpl::Cancel() const noexcept
+{
+    auto *cancel = PQgetCancel(conn_.get());
+    if (cancel == nullptr)
+    {
+        return;
+    }
+
+    std::array<char, 256> error{};
+    if (PQcancel(cancel, error.data(), static_cast<int>(error.size())) != 1)
+    {
+        Logging::Warning("Ошибка отмены запроса: {}", error.data());
+    }
+    PQfreeCancel(cancel);
+}
+
 //------------------------------------------------------------------------------
 bool ConnectionImpl::Reconnect() const noexcept
 {
+    statements_.Clear();
+
     PQreset(conn_.get());
+    created_ = std::chrono::steady_clock::now();
     if (!Status())
     {
         Logging::Error("Ошибка переподключения к БД: {}",
@@ -114,6 +538,56 @@ bool ConnectionImpl::Reconnect() const noexcept
     return true;
 }
 
+//------------------------------------------------------------------------------
+void ConnectionImpl::CheckPlaceholders(const Statement &statement,
+                                       size_t arguments) noexcept
+{
+    if (arguments != 0 && statement.Placeholders() != 0 &&
+        statement.Placeholders() != arguments)
+    {
+        Logging::Warning("Количество параметров запроса: {} не совпадает с "
+                         "количеством {{}} в запросе: {}",
+                         arguments,
+                         statement.Placeholders());
+    }
+}
+
+//------------------------------------------------------------------------------
+bool ConnectionImpl::Convert(const Params &params,
+                             size_t count,
+                             vector<const char *> &values) noexcept
+{
+    if (!params.Valid())
+    {
+        return false;
+    }
+
+    if (params.Size() < count)
+    {
+        Logging::Error("Недостаточно параметров запроса: {} из {}",
+                       params.Size(),
+                       count);
+        return false;
+    }
+
+    values = params.Pointers(count);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool ConnectionImpl::ToText(const any &value, string &text) noexcept
+{
+    const auto visitor{any_visitor_.find(type_index(value.type()))};
+    if (visitor == any_visitor_.cend())
+    {
+        Logging::Error("Неизвестный тип данных: {}", value.type().name());
+        return false;
+    }
+
+    text = visitor->second(value);
+    return true;
+}
+
 /*------------------------------------------------------------------------------
     VisitorList
 ------------------------------------------------------------------------------*/
@@ -136,18 +610,11 @@ static inline string ConvertToString(const Type &value) noexcept
 
 //------------------------------------------------------------------------------
 template<class Type>
-static inline string ConvertByStream(const Type &value) noexcept
-{
-    stringstream stream{};
-    stream.flush();
-    stream << value;
-    return stream.str();
-}
-
-//------------------------------------------------------------------------------
-static inline string ConvertByBool(const bool &value) noexcept
+static inline string ConvertByEncoder(const Type &value) noexcept
 {
-    return value ? "t" : "f";
+    string text{};
+    static_cast<void>(Encoder<Type>::Encode(value, text));
+    return text;
 }
 
 //------------------------------------------------------------------------------
@@ -160,20 +627,23 @@ static inline string ConvertByJsonValue(const Json::Value &value) noexcept
 static inline VisitorList VisitorInitialization() noexcept
 {
     VisitorList list = {
-        ToAnyVisitor<int>(static_cast<string (&)(int)>(to_string)),
-        ToAnyVisitor<unsigned>(static_cast<string (&)(unsigned)>(to_string)),
-        ToAnyVisitor<float>(static_cast<string (&)(float)>(to_string)),
-        ToAnyVisitor<double>(static_cast<string (&)(double)>(to_string)),
-        ToAnyVisitor<size_t>(static_cast<string (&)(size_t)>(to_string)),
-        ToAnyVisitor<uint16_t>(ConvertByStream<uint16_t>),
-        ToAnyVisitor<int64_t>(ConvertByStream<int64_t>),
+        ToAnyVisitor<int>(ConvertByEncoder<int>),
+        ToAnyVisitor<unsigned>(ConvertByEncoder<unsigned>),
+        ToAnyVisitor<float>(ConvertByEncoder<float>),
+        ToAnyVisitor<double>(ConvertByEncoder<double>),
+        ToAnyVisitor<size_t>(ConvertByEncoder<size_t>),
+        ToAnyVisitor<int16_t>(ConvertByEncoder<int16_t>),
+        ToAnyVisitor<uint16_t>(ConvertByEncoder<uint16_t>),
+        ToAnyVisitor<int64_t>(ConvertByEncoder<int64_t>),
         ToAnyVisitor<char *>(ConvertToString<char *>),
         ToAnyVisitor<char const *>(ConvertToString<char const *>),
         ToAnyVisitor<string>(ConvertToString<string>),
         ToAnyVisitor<string_view>(ConvertToString<string_view>),
         ToAnyVisitor<fs::path>(ConvertToString<fs::path>),
-        ToAnyVisitor<bool>(ConvertByBool),
+        ToAnyVisitor<bool>(ConvertByEncoder<bool>),
         ToAnyVisitor<Json::Value>(ConvertByJsonValue),
+        ToAnyVisitor<Timestamp>(ConvertByEncoder<Timestamp>),
+        ToAnyVisitor<Uuid>(ConvertByEncoder<Uuid>),
     };
     return list;
 }
@@ -8,6 +8,7 @@
 #include <postgresql/libpq-fe.h>
 
 #include <any>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -16,7 +17,18 @@
 #include <unordered_map>
 #include <vector>
 
+#include <tasp/db/pg/params.hpp>
+#include <tasp/db/pg/query.hpp>
+#include <tasp/db/pg/result.hpp>
+
+#include "async_query.hpp"
+#include "copy_in_impl.hpp"
+#include "copy_out_impl.hpp"
+#include "pipeline_impl.hpp"
 #include "result_impl.hpp"
+#include "result_stream_impl.hpp"
+#include "statement.hpp"
+#include "statement_cache.hpp"
 #include "transaction_impl.hpp"
 
 namespace tasp::db::pg
@@ -46,6 +58,16 @@ public:
      */
     explicit ConnectionImpl(std::string_view name = {}) noexcept;
 
+    /**
+     * @brief Конструктор для подключения, установленного асинхронно
+     * (PQconnectStart/PQconnectPoll).
+     *
+     * @param uri Строка подключения к БД в формате PostgreSQL URI
+     * @param conn Подключение к СУБД библиотеки libpq, объект становится его
+     * владельцем
+     */
+    ConnectionImpl(std::string uri, PGconn *conn) noexcept;
+
     /**
      * @brief Деструктор.
      */
@@ -61,17 +83,40 @@ public:
     /**
      * @brief Выполнение запроса у СУБД.
      *
-     * В запроса можно указать {}. Вместо этого будет подставлено значение из
-     * параметров.
+     * Параметры указываются в запросе как $1, $2, ... и передаются в СУБД
+     * отдельно от текста запроса. Для совместимости можно указать {}, такие
+     * вхождения по порядку заменяются на $1, $2, ...
      *
      * @param query SQL-запрос
      * @param params Параметры запроса
+     * @param format Формат результата
+     * @param compiled Запрос, подготовленный во время компиляции, с текстом
+     * query. Если указан, текст запроса не просматривается.
      *
      * @return Результат выполнения запроса
      */
     [[nodiscard]] std::unique_ptr<ResultImpl> Exec(
         std::string_view query,
-        const std::vector<std::any> &params = {}) const noexcept;
+        const Params &params = {},
+        Result::Format format = Result::Format::Text,
+        const QueryText *compiled = nullptr) const noexcept;
+
+    /**
+     * @brief Асинхронное выполнение запроса у СУБД.
+     *
+     * Обработчик вызывается в потоке цикла обработки событий после получения
+     * результата, при ошибке отправки запроса - в текущем потоке. До вызова
+     * обработчика подключение нельзя использовать для других запросов.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     * @param callback Обработчик завершения запроса
+     */
+    void ExecAsync(std::string_view query,
+                   const Params &params,
+                   Result::Format format,
+                   AsyncCallback callback) const noexcept;
 
     /**
      * @brief Старт транзакции.
@@ -81,6 +126,141 @@ public:
     [[nodiscard]] std::unique_ptr<TransactionImpl> BeginTransaction()
         const noexcept;
 
+    /**
+     * @brief Асинхронный старт транзакции.
+     *
+     * @param callback Обработчик, получающий транзакцию после выполнения
+     * команды BEGIN
+     */
+    void BeginTransactionAsync(
+        std::function<void(std::unique_ptr<TransactionImpl>)> callback)
+        const noexcept;
+
+    /**
+     * @brief Старт пакетного выполнения запросов в режиме конвейера.
+     *
+     * @return Указатель на конвейер
+     */
+    [[nodiscard]] std::unique_ptr<PipelineImpl> BeginPipeline() const noexcept;
+
+    /**
+     * @brief Старт массовой загрузки данных командой COPY FROM STDIN.
+     *
+     * @param table Имя таблицы
+     * @param columns Имена столбцов, пустой список - все столбцы таблицы
+     * @param format Формат передачи данных
+     *
+     * @return Указатель на загрузку
+     */
+    [[nodiscard]] std::unique_ptr<CopyInImpl> BeginCopyIn(
+        std::string_view table,
+        const std::vector<std::string> &columns,
+        CopyIn::Format format) const noexcept;
+
+    /**
+     * @brief Старт выгрузки данных командой COPY TO STDOUT.
+     *
+     * @param query SQL-запрос, результат которого выгружается
+     * @param format Формат передачи данных
+     *
+     * @return Указатель на выгрузку
+     */
+    [[nodiscard]] std::unique_ptr<CopyOutImpl> BeginCopyOut(
+        std::string_view query,
+        CopyOut::Format format) const noexcept;
+
+    /**
+     * @brief Потоковое выполнение запроса.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     *
+     * @return Указатель на поток строк результата
+     */
+    [[nodiscard]] std::unique_ptr<ResultStreamImpl> Stream(
+        std::string_view query,
+        const Params &params,
+        Result::Format format) const noexcept;
+
+    /**
+     * @brief Отправка запроса в СУБД без ожидания результата.
+     *
+     * Результат запрашивается функцией PQgetResult до получения nullptr. Если
+     * запрос уже подготовлен в этом подключении, выполняется подготовленный
+     * запрос.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     *
+     * @return Результат отправки запроса
+     */
+    [[nodiscard]] bool Send(std::string_view query,
+                            const Params &params,
+                            Result::Format format) const noexcept;
+
+    /**
+     * @brief Проверка подключения к БД с попыткой переподключения.
+     *
+     * @return Статус подключения
+     */
+    [[nodiscard]] bool Check() const noexcept;
+
+    /**
+     * @brief Быстрая проверка неиспользуемого подключения без запроса к БД.
+     *
+     * Проверяет готовность сокета к чтению: в неиспользуемом подключении
+     * данные появляются, только если сервер закрыл подключение или прислал
+     * уведомление.
+     *
+     * @return Подключение работает
+     */
+    [[nodiscard]] bool Alive() const noexcept;
+
+    /**
+     * @brief Время установки подключения.
+     *
+     * @return Время установки подключения
+     */
+    [[nodiscard]] std::chrono::steady_clock::time_point Created()
+        const noexcept;
+
+    /**
+     * @brief Отмена выполняющегося запроса.
+     *
+     * Результаты запроса после отмены нужно получить функцией PQgetResult.
+     */
+    void Cancel() const noexcept;
+
+    /**
+     * @brief Преобразование значения параметра в текстовое представление.
+     *
+     * @param value Значение
+     * @param text Строка для текстового представления
+     *
+     * @return Результат преобразования, false для неизвестного типа данных
+     */
+    [[nodiscard]] static bool ToText(const std::any &value,
+                                     std::string &text) noexcept;
+
+    /**
+     * @brief Запрос указателя на подключение к СУБД библиотеки libpq.
+     *
+     * @return Указатель на подключение
+     */
+    [[nodiscard]] PGconn *Native() const noexcept;
+
+    /**
+     * @brief Переподключение к БД.
+     *
+     * Используется также для сброса подключения, оставшегося в
+     * неопределенном состоянии (например, в режиме конвейера).
+     *
+     * @return Результат переподключения
+     */
+    [[nodiscard]] bool Reconnect() const noexcept;
+
     ConnectionImpl(const ConnectionImpl &) = delete;
     ConnectionImpl(ConnectionImpl &&) = delete;
     ConnectionImpl &operator=(const ConnectionImpl &) = delete;
@@ -88,11 +268,119 @@ public:
 
 private:
     /**
-     * @brief Переподключение к БД.
+     * @brief Выполнение запроса у СУБД без учета в статистике.
      *
-     * @return Результат переподключения
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     * @param compiled Запрос, подготовленный во время компиляции, или nullptr
+     *
+     * @return Результат выполнения запроса
      */
-    [[nodiscard]] bool Reconnect() const noexcept;
+    [[nodiscard]] std::unique_ptr<ResultImpl> Execute(
+        std::string_view query,
+        const Params &params,
+        Result::Format format,
+        const QueryText *compiled) const noexcept;
+
+    /**
+     * @brief Выполнение запроса с параметрами без подготовки.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     * @param compiled Запрос, подготовленный во время компиляции, или nullptr
+     *
+     * @return Результат выполнения запроса
+     */
+    [[nodiscard]] std::unique_ptr<ResultImpl> ExecParams(
+        std::string_view query,
+        const Params &params,
+        Result::Format format,
+        const QueryText *compiled = nullptr) const noexcept;
+
+    /**
+     * @brief Выполнение запроса с параметрами вида $n без подготовки.
+     *
+     * @param statement Запрос с параметрами вида $n
+     * @param params Параметры запроса
+     * @param format Формат результата
+     *
+     * @return Результат выполнения запроса
+     */
+    [[nodiscard]] std::unique_ptr<ResultImpl> ExecParams(
+        const QueryText &statement,
+        const Params &params,
+        Result::Format format) const noexcept;
+
+    /**
+     * @brief Выполнение подготовленного запроса.
+     *
+     * @param prepared Подготовленный запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     *
+     * @return Результат выполнения запроса
+     */
+    [[nodiscard]] std::unique_ptr<ResultImpl> ExecPrepared(
+        const StatementCache::Entry &prepared,
+        const Params &params,
+        Result::Format format) const noexcept;
+
+    /**
+     * @brief Подготовка запроса на сервере и добавление его в кэш.
+     *
+     * @param query SQL-запрос
+     * @param arguments Количество параметров запроса
+     * @param compiled Запрос, подготовленный во время компиляции, или nullptr
+     *
+     * @return Результат подготовки запроса
+     */
+    [[nodiscard]] std::unique_ptr<ResultImpl> Prepare(
+        std::string_view query,
+        size_t arguments,
+        const QueryText *compiled) const noexcept;
+
+    /**
+     * @brief Подготовка запроса с параметрами вида $n на сервере и добавление
+     * его в кэш.
+     *
+     * @param query SQL-запрос, ключ в кэше
+     * @param arguments Количество параметров запроса
+     * @param statement Запрос с параметрами вида $n и хешем текста query
+     *
+     * @return Результат подготовки запроса
+     */
+    [[nodiscard]] std::unique_ptr<ResultImpl> Prepare(
+        std::string_view query,
+        size_t arguments,
+        const QueryText &statement) const noexcept;
+
+    /**
+     * @brief Проверка соответствия количества {} в запросе количеству
+     * параметров.
+     *
+     * @param statement Запрос
+     * @param arguments Количество параметров запроса
+     */
+    static void CheckPlaceholders(const Statement &statement,
+                                  size_t arguments) noexcept;
+
+    /**
+     * @brief Формирование массива указателей на значения параметров для
+     * libpq.
+     *
+     * @param params Параметры запроса
+     * @param count Количество параметров, которые необходимо передать в СУБД
+     * @param values Указатели на значения параметров
+     *
+     * @return Результат, false - параметр не преобразован или параметров
+     * меньше count
+     */
+    [[nodiscard]] static bool Convert(
+        const Params &params,
+        size_t count,
+        std::vector<const char *> &values) noexcept;
 
     /**
      * @brief Строка подключения к БД в формате PostgreSQL URI.
@@ -104,6 +392,20 @@ private:
      */
     std::unique_ptr<PGconn, decltype(&PQfinish)> conn_;
 
+    /**
+     * @brief Кэш подготовленных запросов.
+     *
+     * Очищается при переподключении, т.к. сервер удаляет подготовленные
+     * запросы вместе с сессией.
+     */
+    mutable StatementCache statements_;
+
+    /**
+     * @brief Время установки подключения, обновляется при переподключении.
+     */
+    mutable std::chrono::steady_clock::time_point created_{
+        std::chrono::steady_clock::now()};
+
     /**
      * @brief Список типов данных поддерживаемых для формирования запроса с
      * функциями преобразования их в текстовое представление.
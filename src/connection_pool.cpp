@@ -1,8 +1,11 @@
 #include "tasp/db/pg/connection_pool.hpp"
 
 #include "connection_pool_impl.hpp"
+#include "pool_metrics.hpp"
 
 using std::make_unique;
+using std::shared_ptr;
+using std::string_view;
 using std::unique_ptr;
 
 namespace tasp::db::pg
@@ -18,14 +21,64 @@ ConnectionPool &ConnectionPool::Instance() noexcept
 }
 
 //------------------------------------------------------------------------------
-unique_ptr<Connection> ConnectionPool::GetConnection() const noexcept
+unique_ptr<Connection> ConnectionPool::GetConnection(
+    string_view name) const noexcept
 {
-    return make_unique<Connection>(impl_->GetConnection());
+    const auto pool = name.empty() ? impl_ : ConnectionPoolImpl::Instance(name);
+    return make_unique<Connection>(pool->GetConnection());
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPool::GetConnectionAsync(
+    std::function<void(unique_ptr<Connection>)> callback,
+    string_view name) const noexcept
+{
+    const auto pool = name.empty() ? impl_ : ConnectionPoolImpl::Instance(name);
+    pool->GetConnectionAsync(
+        [callback = std::move(callback)](shared_ptr<ConnectionImpl> impl)
+        {
+            callback(make_unique<Connection>(std::move(impl)));
+        });
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<Connection> ConnectionPool::GetReadConnection(
+    string_view name) const noexcept
+{
+    const auto pool = name.empty() ? impl_ : ConnectionPoolImpl::Instance(name);
+    return make_unique<Connection>(pool->GetReadConnection());
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPool::GetReadConnectionAsync(
+    std::function<void(unique_ptr<Connection>)> callback,
+    string_view name) const noexcept
+{
+    const auto pool = name.empty() ? impl_ : ConnectionPoolImpl::Instance(name);
+    pool->GetReadConnectionAsync(
+        [callback = std::move(callback)](shared_ptr<ConnectionImpl> impl)
+        {
+            callback(make_unique<Connection>(std::move(impl)));
+        });
+}
+
+//------------------------------------------------------------------------------
+ConnectionPool::Metrics ConnectionPool::GetMetrics(
+    string_view name) const noexcept
+{
+    const auto pool = name.empty() ? impl_ : ConnectionPoolImpl::Instance(name);
+    return pool->GetMetrics();
+}
+
+//------------------------------------------------------------------------------
+Json::Value ConnectionPool::GetMetricsJson(string_view name) const noexcept
+{
+    return PoolMetrics::JsonValue(GetMetrics(name));
 }
 
 //------------------------------------------------------------------------------
 ConnectionPool::ConnectionPool() noexcept
-: impl_(make_unique<ConnectionPoolImpl>())
+: impl_(ConnectionPoolImpl::Instance())
 {
 }
 
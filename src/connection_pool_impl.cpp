@@ -1,27 +1,140 @@
 #include "connection_pool_impl.hpp"
 
-#include <thread>
+#include <algorithm>
+#include <unordered_map>
 
 #include <tasp/config.hpp>
+#include <tasp/db/pg/executor.hpp>
 #include <tasp/logging.hpp>
 
+#include "async_connect.hpp"
+#include "observers.hpp"
+#include "reactor.hpp"
+
 using std::make_shared;
+using std::make_unique;
+using std::mutex;
 using std::scoped_lock;
 using std::shared_ptr;
+using std::string;
+using std::string_view;
+using std::unique_lock;
+using std::unique_ptr;
+using std::unordered_map;
+using std::vector;
+using std::weak_ptr;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::seconds;
+using std::chrono::steady_clock;
+
+using namespace std::literals::string_literals;
+
+using Event = tasp::db::pg::PoolMetrics::Event;
 
 namespace tasp::db::pg
 {
 
+/**
+ * @brief Запрос настройки пула подключений.
+ *
+ * @param name Имя подключения к БД из конф. файла
+ * @param key Имя настройки
+ * @param value Значение по умолчанию
+ *
+ * @return Значение из раздела подключения, иначе из общего раздела
+ * database.pool
+ */
+template<typename Type>
+static inline Type Setting(string_view name,
+                           string_view key,
+                           Type value) noexcept
+{
+    const auto &conf = ConfigGlobal::Instance();
+
+    const auto common = conf.Get<Type>("database.pool."s.append(key), value);
+    if (name.empty())
+    {
+        return common;
+    }
+
+    return conf.Get<Type>("database.connections."s.append(name)
+                              .append(".pool.")
+                              .append(key),
+                          common);
+}
+
+/**
+ * @brief Преобразование количества секунд из конф. файла в интервал времени.
+ *
+ * @param seconds Количество секунд, допускается дробное значение
+ *
+ * @return Интервал времени
+ */
+static inline microseconds Seconds(double seconds) noexcept
+{
+    return duration_cast<microseconds>(duration<double>(seconds));
+}
+
+/**
+ * @brief Первый интервал повторной проверки исключенной реплики.
+ */
+static constexpr seconds min_backoff{1};
+
+/**
+ * @brief Максимальный интервал повторной проверки исключенной реплики.
+ */
+static constexpr seconds max_backoff{60};
+
 /*------------------------------------------------------------------------------
     ConnectionPoolImpl
 ------------------------------------------------------------------------------*/
-ConnectionPoolImpl::ConnectionPoolImpl() noexcept
-: max_(ConfigGlobal::Instance().Get<size_t>("database.pool.max", 10))
-, timeout_(ConfigGlobal::Instance().Get<int>("database.pool.timeout", 2))
-, retry_(ConfigGlobal::Instance().Get<int>("database.pool.retry", 3))
+shared_ptr<ConnectionPoolImpl> ConnectionPoolImpl::Instance(
+    string_view name) noexcept
 {
-    connections_.reserve(max_);
-    Logging::Debug("Максимальное количество соединений в пуле БД: {}", max_);
+    static mutex pools_mutex{};
+    static unordered_map<string, shared_ptr<ConnectionPoolImpl>> pools{};
+
+    const string key{name.empty()
+                         ? ConfigGlobal::Instance().Get<string>("database.main")
+                         : string{name}};
+
+    unique_lock lock{pools_mutex};
+
+    auto &pool = pools[key];
+    if (pool != nullptr)
+    {
+        return pool;
+    }
+
+    pool = make_shared<ConnectionPoolImpl>(key);
+    auto created = pool;
+    lock.unlock();
+
+    created->Start();
+    return created;
+}
+
+//------------------------------------------------------------------------------
+ConnectionPoolImpl::ConnectionPoolImpl(string_view name) noexcept
+: name_(name)
+, max_(Setting<size_t>(name, "max", 10))
+, min_(std::min(Setting<size_t>(name, "min", 0), max_))
+, connect_(Seconds(Setting<double>(name, "connect", 10)))
+, timeout_(Seconds(Setting<double>(name, "timeout", 2)))
+, retry_(Setting<int>(name, "retry", 3))
+, idle_timeout_(Seconds(Setting<double>(name, "idle", 600)))
+, lifetime_(Seconds(Setting<double>(name, "lifetime", 3600)))
+, check_(Seconds(Setting<double>(name, "check", 30)))
+, lag_(Seconds(Setting<double>(name, "lag", 10)))
+, replica_names_(ConfigGlobal::Instance().Get<vector<string>>(
+      "database.connections."s.append(name).append(".replicas"), {}))
+{
+    idle_.reserve(max_);
+    Logging::Debug("Максимальное количество соединений в пуле БД {}: {}",
+                   name_,
+                   max_);
 }
 
 //------------------------------------------------------------------------------
@@ -30,40 +143,696 @@ ConnectionPoolImpl::~ConnectionPoolImpl() noexcept = default;
 //------------------------------------------------------------------------------
 shared_ptr<ConnectionImpl> ConnectionPoolImpl::GetConnection() noexcept
 {
-    const scoped_lock lock{mutex_};
+    const auto start = steady_clock::now();
+
+    unique_lock lock{mutex_};
+
+    if (auto connection = TakeIdle())
+    {
+        lock.unlock();
+
+        Checkout(connection.get(), start);
+        return Lease(std::move(connection));
+    }
+
+    if (total_ < max_)
+    {
+        ++total_;
+        lock.unlock();
+
+        auto connection = Open();
+        Checkout(connection.get(), start);
+        return connection;
+    }
+
+    // Поток ждет в общей очереди с асинхронными запросами, подключение или
+    // место в пуле передается ему напрямую.
+    metrics_.Count(Event::Exhausted);
+
+    Handoff handoff{};
+    const auto id = next_waiter_++;
+    waiters_.push_back({id, {}, 0, &handoff});
 
     int retry{retry_};
-    while ((retry--) != 0)
+    while (!handoff.ready)
+    {
+        if ((retry--) == 0)
+        {
+            waiters_.erase(std::find_if(waiters_.begin(),
+                                        waiters_.end(),
+                                        [id](const Waiter &current)
+                                        {
+                                            return current.id == id;
+                                        }));
+            lock.unlock();
+
+            metrics_.Count(Event::Timeout);
+            Logging::Error(
+                "Нет свободных подключений к БД. Закончился лимит попыток: {}",
+                retry_);
+            Checkout(nullptr, start);
+            return {};
+        }
+
+        Logging::Warning("Нет свободных подключений к БД, ожидаем {} сек.",
+                         duration<double>(timeout_).count());
+
+        handoff.signal.wait_for(lock,
+                                timeout_,
+                                [&handoff]
+                                {
+                                    return handoff.ready;
+                                });
+    }
+    lock.unlock();
+
+    if (handoff.connection != nullptr)
+    {
+        Checkout(handoff.connection.get(), start);
+        return Lease(std::move(handoff.connection));
+    }
+
+    auto connection = Open();
+    Checkout(connection.get(), start);
+    return connection;
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::GetConnectionAsync(Callback callback) noexcept
+{
+    Callback timed = [pool = weak_from_this(),
+                      start = steady_clock::now(),
+                      callback = std::move(callback)](
+                         shared_ptr<ConnectionImpl> connection)
+    {
+        if (auto self = pool.lock())
+        {
+            self->Checkout(connection.get(), start);
+        }
+
+        callback(std::move(connection));
+    };
+
+    unique_lock lock{mutex_};
+
+    if (auto connection = TakeIdle())
+    {
+        lock.unlock();
+
+        timed(Lease(std::move(connection)));
+        return;
+    }
+
+    if (total_ < max_)
+    {
+        ++total_;
+        lock.unlock();
+
+        OpenAsync(std::move(timed));
+        return;
+    }
+
+    const auto id = next_waiter_++;
+    const auto wait = timeout_ * retry_;
+    auto expire = [pool = weak_from_this(), id]
+    {
+        if (auto self = pool.lock())
+        {
+            self->Expire(id);
+        }
+    };
+
+    // Таймер регистрируется под блокировкой пула, чтобы запрос не был
+    // обслужен до сохранения идентификатора таймера. Цикл обработки событий
+    // не обращается к пулу под своей блокировкой.
+    const auto timer = Reactor::Instance().After(wait, std::move(expire));
+    waiters_.push_back({id, std::move(timed), timer, nullptr});
+    lock.unlock();
+
+    metrics_.Count(Event::Exhausted);
+    Logging::Warning("Нет свободных подключений к БД, ожидаем {} сек.",
+                     duration<double>(wait).count());
+
+    if (timer == 0)
+    {
+        Logging::Warning("Ожидание подключения к БД не ограничено по времени");
+    }
+}
+
+//------------------------------------------------------------------------------
+shared_ptr<ConnectionImpl> ConnectionPoolImpl::GetReadConnection() noexcept
+{
+    if (auto replica = Replica())
+    {
+        auto connection = replica->GetConnection();
+        if (connection != nullptr && connection->Status())
+        {
+            return connection;
+        }
+
+        replica->Down();
+    }
+
+    return GetConnection();
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::GetReadConnectionAsync(Callback callback) noexcept
+{
+    auto replica = Replica();
+    if (replica == nullptr)
+    {
+        GetConnectionAsync(std::move(callback));
+        return;
+    }
+
+    replica->GetConnectionAsync(
+        [pool = weak_from_this(), replica, callback = std::move(callback)](
+            shared_ptr<ConnectionImpl> connection) mutable
+        {
+            if (connection != nullptr && connection->Status())
+            {
+                callback(std::move(connection));
+                return;
+            }
+
+            replica->Down();
+
+            auto self = pool.lock();
+            if (self == nullptr)
+            {
+                callback(nullptr);
+                return;
+            }
+
+            self->GetConnectionAsync(std::move(callback));
+        });
+}
+
+//------------------------------------------------------------------------------
+ConnectionPool::Metrics ConnectionPoolImpl::GetMetrics() noexcept
+{
+    ConnectionPool::Metrics metrics{};
+    {
+        const scoped_lock lock{mutex_};
+
+        metrics.max = max_;
+        metrics.active = total_ - idle_.size();
+        metrics.idle = idle_.size();
+        metrics.waiting = waiters_.size();
+    }
+
+    metrics_.Fill(metrics);
+    return metrics;
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Start() noexcept
+{
+    Warm();
+    Schedule();
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Warm() noexcept
+{
+    size_t count{0};
+    {
+        const scoped_lock lock{mutex_};
+        count = min_ > total_ ? min_ - total_ : 0;
+        total_ += count;
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    Logging::Debug("Открытие {} подключений в пуле БД", count);
+    for (size_t index = 0; index < count; ++index)
+    {
+        make_shared<AsyncConnect>(
+            name_,
+            [pool = weak_from_this()](unique_ptr<ConnectionImpl> connection)
+            {
+                if (auto self = pool.lock())
+                {
+                    self->Add(std::move(connection));
+                }
+            })
+            ->Start(connect_);
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Schedule() noexcept
+{
+    if (check_.count() == 0)
+    {
+        return;
+    }
+
+    Reactor::Instance().After(check_,
+                              [pool = weak_from_this()]
+                              {
+                                  if (auto self = pool.lock())
+                                  {
+                                      self->Maintain();
+                                      self->Schedule();
+                                  }
+                              });
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Maintain() noexcept
+{
+    const auto now = steady_clock::now();
+
+    // Подключения закрываются вне блокировки, т.к. PQfinish отправляет
+    // серверу сообщение о завершении сеанса.
+    vector<unique_ptr<ConnectionImpl>> closed{};
+    {
+        const scoped_lock lock{mutex_};
+
+        for (auto idle = idle_.begin(); idle != idle_.end();)
+        {
+            const auto unused = idle_timeout_.count() != 0 &&
+                                now - idle->since > idle_timeout_ &&
+                                total_ > min_;
+            if (unused || Retired(*idle->connection, now) ||
+                !idle->connection->Alive())
+            {
+                closed.push_back(std::move(idle->connection));
+                idle = idle_.erase(idle);
+                --total_;
+                continue;
+            }
+            ++idle;
+        }
+    }
+
+    if (!closed.empty())
+    {
+        metrics_.Count(Event::Closed, closed.size());
+        Logging::Debug("Закрыто подключений в пуле БД: {}", closed.size());
+        closed.clear();
+    }
+
+    // Закрытые подключения заменяются новыми до минимального количества.
+    Warm();
+
+    if (replica_)
+    {
+        CheckLag();
+    }
+}
+
+//------------------------------------------------------------------------------
+shared_ptr<ConnectionPoolImpl> ConnectionPoolImpl::Replica() noexcept
+{
+    std::call_once(replicas_once_,
+                   [this]
+                   {
+                       for (const auto &name : replica_names_)
+                       {
+                           if (name == name_)
+                           {
+                               continue;
+                           }
+
+                           auto replica = Instance(name);
+                           replica->replica_ = true;
+                           replicas_.push_back(std::move(replica));
+                       }
+                   });
+
+    shared_ptr<ConnectionPoolImpl> selected{};
+    size_t least{0};
+    for (const auto &replica : replicas_)
     {
-        int current{0};
-        for (auto &&connection : connections_)
+        if (!replica->healthy_)
         {
-            current++;
-            if (connection.use_count() == 1)
+            continue;
+        }
+
+        const auto outstanding = replica->Outstanding();
+        if (outstanding >= replica->max_)
+        {
+            continue;
+        }
+
+        if (selected == nullptr || outstanding < least)
+        {
+            selected = replica;
+            least = outstanding;
+        }
+    }
+
+    return selected;
+}
+
+//------------------------------------------------------------------------------
+size_t ConnectionPoolImpl::Outstanding() noexcept
+{
+    const scoped_lock lock{mutex_};
+    return total_ - idle_.size();
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::CheckLag() noexcept
+{
+    if (healthy_)
+    {
+        // Все подключения заняты, т.е. реплика работает, а ожидание
+        // свободного подключения не должно исключать ее из выбора.
+        // Исключенная реплика проверяется всегда: иначе она не вернется в
+        // выбор, пока заняты все ее подключения.
+        const scoped_lock lock{mutex_};
+        if (idle_.empty() && total_ >= max_)
+        {
+            return;
+        }
+    }
+
+    static constexpr string_view query{
+        "SELECT CASE WHEN NOT pg_is_in_recovery() OR "
+        "pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn() THEN 0 "
+        "ELSE EXTRACT(EPOCH FROM now() - pg_last_xact_replay_timestamp()) "
+        "END::float8"};
+
+    GetConnectionAsync(
+        [pool = weak_from_this()](shared_ptr<ConnectionImpl> connection)
+        {
+            auto self = pool.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
+
+            if (connection == nullptr || !connection->Status())
             {
-                Logging::Debug(
-                    "Текущее подключение в пуле БД {} из {}", current, max_);
-                return connection;
+                self->Down();
+                return;
             }
+
+            connection->ExecAsync(
+                query,
+                {},
+                Result::Format::Text,
+                [pool](unique_ptr<ResultImpl> result)
+                {
+                    auto replica = pool.lock();
+                    if (replica == nullptr)
+                    {
+                        return;
+                    }
+
+                    if (!result->Status())
+                    {
+                        replica->Down();
+                        return;
+                    }
+
+                    const auto lag = result->Get<double>(0, 0);
+                    const auto limit = replica->lag_;
+                    if (limit.count() != 0 && Seconds(lag) > limit)
+                    {
+                        Logging::Warning("Отставание реплики БД {}: {} сек.",
+                                         replica->name_,
+                                         lag);
+                        replica->Down();
+                        return;
+                    }
+
+                    if (!replica->healthy_.exchange(true))
+                    {
+                        Logging::Debug("Реплика БД {} снова доступна",
+                                       replica->name_);
+                    }
+
+                    const scoped_lock lock{replica->mutex_};
+                    replica->backoff_ = {};
+                });
+        });
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Down() noexcept
+{
+    if (healthy_.exchange(false))
+    {
+        Logging::Warning(
+            "Реплика БД {} недоступна, запросы на чтение выполняются на "
+            "основной БД",
+            name_);
+    }
+
+    // Проверка уже запланирована, неудачная проверка планирует следующую.
+    if (probing_.exchange(true))
+    {
+        return;
+    }
+
+    microseconds delay{};
+    {
+        const scoped_lock lock{mutex_};
+        backoff_ = backoff_.count() == 0
+                       ? microseconds{min_backoff}
+                       : std::min<microseconds>(backoff_ * 2, max_backoff);
+        delay = backoff_;
+    }
+
+    auto probe = [pool = weak_from_this()]
+    {
+        if (auto self = pool.lock())
+        {
+            self->probing_ = false;
+            self->CheckLag();
         }
+    };
+    if (Reactor::Instance().After(delay, std::move(probe)) == 0)
+    {
+        probing_ = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Checkout(const ConnectionImpl *connection,
+                                  steady_clock::time_point start) noexcept
+{
+    const auto wait = steady_clock::now() - start;
+    if (connection != nullptr)
+    {
+        metrics_.Wait(wait);
+    }
+
+    if (Observers::Active())
+    {
+        Observers::Checkout({name_, connection, wait});
+    }
+}
+
+//------------------------------------------------------------------------------
+bool ConnectionPoolImpl::Retired(const ConnectionImpl &connection,
+                                 steady_clock::time_point now) const noexcept
+{
+    return !connection.Status() ||
+           (lifetime_.count() != 0 && now - connection.Created() > lifetime_);
+}
 
-        if (connections_.size() < max_)
+//------------------------------------------------------------------------------
+unique_ptr<ConnectionImpl> ConnectionPoolImpl::TakeIdle() noexcept
+{
+    while (!idle_.empty())
+    {
+        auto connection = std::move(idle_.back().connection);
+        idle_.pop_back();
+
+        if (connection->Alive())
         {
-            Logging::Debug("Новое подключение в пуле БД {} из {}",
-                           connections_.size() + 1,
-                           max_);
-            return connections_.emplace_back(make_shared<ConnectionImpl>());
+            return connection;
         }
 
-        Logging::Warning("Нет свободных подключений к БД, ожидаем {} сек.",
-                         timeout_);
-        std::this_thread::sleep_for(std::chrono::seconds(timeout_));
+        Logging::Warning("Подключение в пуле БД разорвано, будет заменено");
+        metrics_.Count(Event::Closed);
+        --total_;
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+shared_ptr<ConnectionImpl> ConnectionPoolImpl::Lease(
+    unique_ptr<ConnectionImpl> connection) noexcept
+{
+    metrics_.Count(Event::Acquired);
+    return {connection.release(),
+            [pool = weak_from_this(),
+             since = steady_clock::now()](ConnectionImpl *leased)
+            {
+                Release(pool, leased, since);
+            }};
+}
+
+//------------------------------------------------------------------------------
+shared_ptr<ConnectionImpl> ConnectionPoolImpl::Open() noexcept
+{
+    Logging::Debug("Новое подключение в пуле БД {}, максимум {}", name_, max_);
+
+    auto connection = make_unique<ConnectionImpl>(name_);
+    metrics_.Count(connection->Status() ? Event::Created : Event::Failed);
+
+    return Lease(std::move(connection));
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::OpenAsync(Callback callback) noexcept
+{
+    Logging::Debug("Новое подключение в пуле БД {}, максимум {}", name_, max_);
+    make_shared<AsyncConnect>(
+        name_,
+        [pool = weak_from_this(), callback = std::move(callback)](
+            unique_ptr<ConnectionImpl> connection)
+        {
+            auto self = pool.lock();
+            if (self == nullptr)
+            {
+                callback(nullptr);
+                return;
+            }
+
+            self->metrics_.Count(connection->Status() ? Event::Created
+                                                      : Event::Failed);
+            callback(self->Lease(std::move(connection)));
+        })
+        ->Start(connect_);
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Add(unique_ptr<ConnectionImpl> connection) noexcept
+{
+    if (!connection->Status())
+    {
+        metrics_.Count(Event::Failed);
+        Free();
+        return;
+    }
+
+    metrics_.Count(Event::Created);
+    Return(std::move(connection));
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Free() noexcept
+{
+    unique_lock lock{mutex_};
+
+    if (waiters_.empty())
+    {
+        --total_;
+        return;
+    }
+
+    // Освободившееся место отдается первому запросу в очереди.
+    auto waiter = std::move(waiters_.front());
+    waiters_.pop_front();
+
+    if (waiter.handoff != nullptr)
+    {
+        // Поток пробуждается под блокировкой: после ее снятия он может
+        // завершить ожидание и удалить handoff.
+        waiter.handoff->ready = true;
+        waiter.handoff->signal.notify_one();
+        return;
     }
+    lock.unlock();
 
-    Logging::Error(
-        "Нет свободных подключений к БД. Закончился лимит попыток: {}", retry_);
+    Reactor::Instance().Cancel(waiter.timer);
+    OpenAsync(std::move(waiter.callback));
+}
 
-    return {};
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Return(unique_ptr<ConnectionImpl> connection) noexcept
+{
+    if (Retired(*connection, steady_clock::now()))
+    {
+        metrics_.Count(Event::Closed);
+        connection.reset();
+        Free();
+        return;
+    }
+
+    unique_lock lock{mutex_};
+
+    if (waiters_.empty())
+    {
+        idle_.push_back({std::move(connection), steady_clock::now()});
+        return;
+    }
+
+    // Ожидающие запросы получают подключение напрямую, без списка свободных
+    // подключений.
+    auto waiter = std::move(waiters_.front());
+    waiters_.pop_front();
+
+    if (waiter.handoff != nullptr)
+    {
+        waiter.handoff->connection = std::move(connection);
+        waiter.handoff->ready = true;
+        waiter.handoff->signal.notify_one();
+        return;
+    }
+    lock.unlock();
+
+    Reactor::Instance().Cancel(waiter.timer);
+    Executor::Dispatch(
+        [callback = std::move(waiter.callback),
+         lease = Lease(std::move(connection))]
+        {
+            callback(lease);
+        });
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Expire(uint64_t id) noexcept
+{
+    unique_lock lock{mutex_};
+
+    const auto waiter = std::find_if(waiters_.begin(),
+                                     waiters_.end(),
+                                     [id](const Waiter &current)
+                                     {
+                                         return current.id == id;
+                                     });
+    if (waiter == waiters_.end())
+    {
+        return;
+    }
+
+    auto callback = std::move(waiter->callback);
+    waiters_.erase(waiter);
+    lock.unlock();
+
+    metrics_.Count(Event::Timeout);
+    Logging::Error("Нет свободных подключений к БД. Истекло время ожидания");
+    Executor::Dispatch(
+        [callback = std::move(callback)]
+        {
+            callback(nullptr);
+        });
+}
+
+//------------------------------------------------------------------------------
+void ConnectionPoolImpl::Release(const weak_ptr<ConnectionPoolImpl> &pool,
+                                 ConnectionImpl *connection,
+                                 steady_clock::time_point since) noexcept
+{
+    unique_ptr<ConnectionImpl> returned{connection};
+    if (auto self = pool.lock())
+    {
+        self->metrics_.Hold(steady_clock::now() - since);
+        self->Return(std::move(returned));
+    }
 }
 
 }  // namespace tasp::db::pg
@@ -6,24 +6,68 @@
 #ifndef TASP_CONNECTION_POOL_IMPL_HPP_
 #define TASP_CONNECTION_POOL_IMPL_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tasp/db/pg/connection_pool.hpp>
 
 #include "connection_impl.hpp"
+#include "pool_metrics.hpp"
 
 namespace tasp::db::pg
 {
 
 /**
  * @brief Реализация интерфейса пула подключений к СУБД PostgreSQL.
+ *
+ * Подключение выдается в аренду: указатель на подключение возвращает его в
+ * список свободных подключений при удалении последней копии указателя.
+ * Синхронные и асинхронные запросы ожидают подключения в одной очереди и
+ * обслуживаются в порядке поступления сразу при возврате подключения.
+ *
+ * Для каждого подключения к БД из конфигурационного файла создается
+ * отдельный пул со своими настройками.
  */
 class ConnectionPoolImpl final
+: public std::enable_shared_from_this<ConnectionPoolImpl>
 {
 public:
+    /**
+     * @brief Обработчик получения подключения.
+     */
+    using Callback = std::function<void(std::shared_ptr<ConnectionImpl>)>;
+
+    /**
+     * @brief Запрос пула подключений по имени подключения к БД.
+     *
+     * Пул создается и запускается при первом запросе.
+     *
+     * @param name Имя подключения к БД из конф. файла, пустое - подключение
+     * по умолчанию
+     *
+     * @return Указатель на пул подключений
+     */
+    [[nodiscard]] static std::shared_ptr<ConnectionPoolImpl> Instance(
+        std::string_view name = {}) noexcept;
+
     /**
      * @brief Конструктор.
+     *
+     * Настройки пула читаются из раздела database.connections.<name>.pool,
+     * отсутствующие - из общего раздела database.pool.
+     *
+     * @param name Имя подключения к БД из конф. файла
      */
-    ConnectionPoolImpl() noexcept;
+    explicit ConnectionPoolImpl(std::string_view name) noexcept;
 
     /**
      * @brief Деструктор.
@@ -37,21 +81,287 @@ public:
      */
     [[nodiscard]] std::shared_ptr<ConnectionImpl> GetConnection() noexcept;
 
+    /**
+     * @brief Асинхронный запрос свободного подключения из пула.
+     *
+     * Если свободных подключений нет, обработчик ставится в очередь и
+     * получает подключение при его возврате в пул, либо nullptr по истечении
+     * времени ожидания. Поток при ожидании не блокируется.
+     *
+     * @param callback Обработчик, получающий подключение, nullptr - нет
+     * свободных подключений
+     */
+    void GetConnectionAsync(Callback callback) noexcept;
+
+    /**
+     * @brief Запрос подключения для запросов только на чтение.
+     *
+     * Подключение выдается из пула наименее загруженной реплики (по
+     * количеству выданных подключений). Если реплики не настроены,
+     * недоступны, отстают от основной БД или их пулы заняты, подключение
+     * выдается из этого пула.
+     *
+     * @return Указатель на подключение к СУБД PostgreSQL
+     */
+    [[nodiscard]] std::shared_ptr<ConnectionImpl> GetReadConnection() noexcept;
+
+    /**
+     * @brief Асинхронный запрос подключения для запросов только на чтение.
+     *
+     * @param callback Обработчик, получающий подключение, nullptr - нет
+     * свободных подключений
+     *
+     * @see GetReadConnection
+     */
+    void GetReadConnectionAsync(Callback callback) noexcept;
+
+    /**
+     * @brief Запрос показателей работы пула.
+     *
+     * @return Снимок показателей
+     */
+    [[nodiscard]] ConnectionPool::Metrics GetMetrics() noexcept;
+
+    /**
+     * @brief Запуск пула: открытие минимального количества подключений и
+     * периодического обслуживания.
+     */
+    void Start() noexcept;
+
     ConnectionPoolImpl(const ConnectionPoolImpl &) = delete;
     ConnectionPoolImpl(ConnectionPoolImpl &&) = delete;
     ConnectionPoolImpl &operator=(const ConnectionPoolImpl &) = delete;
     ConnectionPoolImpl &operator=(ConnectionPoolImpl &&) = delete;
 
 private:
+    /**
+     * @brief Передача подключения потоку, ожидающему в GetConnection.
+     */
+    struct Handoff
+    {
+        /**
+         * @brief Подключение, nullptr при ready - выделено место для нового
+         * подключения.
+         */
+        std::unique_ptr<ConnectionImpl> connection{};
+
+        /**
+         * @brief Подключение или место в пуле выделено.
+         */
+        bool ready{false};
+
+        /**
+         * @brief Условная переменная для пробуждения ожидающего потока.
+         */
+        std::condition_variable signal{};
+    };
+
+    /**
+     * @brief Запрос подключения, ожидающий в очереди.
+     */
+    struct Waiter
+    {
+        uint64_t id;       /*!< Идентификатор запроса */
+        Callback callback; /*!< Обработчик асинхронного запроса */
+        uint64_t timer;    /*!< Таймер ожидания асинхронного запроса */
+        Handoff *handoff;  /*!< Ожидающий поток, nullptr - асинхронный */
+    };
+
+    /**
+     * @brief Свободное подключение.
+     */
+    struct Idle
+    {
+        std::unique_ptr<ConnectionImpl> connection; /*!< Подключение */
+        std::chrono::steady_clock::time_point since; /*!< Время возврата */
+    };
+
+    /**
+     * @brief Открытие минимального количества подключений.
+     *
+     * Подключения устанавливаются параллельно и асинхронно, вызывающий поток
+     * не блокируется. До их установки запросы подключений обслуживаются как
+     * обычно.
+     */
+    void Warm() noexcept;
+
+    /**
+     * @brief Планирование следующего обслуживания пула по таймеру цикла
+     * обработки событий.
+     */
+    void Schedule() noexcept;
+
+    /**
+     * @brief Обслуживание пула.
+     *
+     * Закрывает свободные подключения, которые не использовались дольше
+     * заданного времени (сверх минимального количества), превысили
+     * максимальное время жизни или разорваны, и открывает новые до
+     * минимального количества.
+     */
+    void Maintain() noexcept;
+
+    /**
+     * @brief Выбор реплики для запроса только на чтение.
+     *
+     * @return Пул наименее загруженной доступной реплики со свободным местом,
+     * nullptr - подходящих реплик нет
+     */
+    [[nodiscard]] std::shared_ptr<ConnectionPoolImpl> Replica() noexcept;
+
+    /**
+     * @brief Количество подключений, выданных в аренду или открываемых.
+     *
+     * @return Количество подключений
+     */
+    [[nodiscard]] size_t Outstanding() noexcept;
+
+    /**
+     * @brief Асинхронная проверка отставания реплики от основной БД.
+     *
+     * Реплика с отставанием больше допустимого или без рабочего подключения
+     * исключается из выбора до следующей успешной проверки.
+     */
+    void CheckLag() noexcept;
+
+    /**
+     * @brief Исключение недоступной реплики из выбора.
+     *
+     * Планирует повторную проверку реплики по таймеру цикла обработки
+     * событий с увеличением интервала, независимо от периода обслуживания.
+     */
+    void Down() noexcept;
+
+    /**
+     * @brief Учет выдачи подключения: время ожидания и событие для
+     * наблюдателей.
+     *
+     * @param connection Подключение, nullptr - подключение не выдано
+     * @param start Время запроса подключения
+     */
+    void Checkout(const ConnectionImpl *connection,
+                  std::chrono::steady_clock::time_point start) noexcept;
+
+    /**
+     * @brief Проверка необходимости закрыть подключение вместо возврата в
+     * пул.
+     *
+     * @param connection Подключение
+     * @param now Текущее время
+     *
+     * @return Результат проверки: подключение разорвано или превысило
+     * максимальное время жизни
+     */
+    [[nodiscard]] bool Retired(
+        const ConnectionImpl &connection,
+        std::chrono::steady_clock::time_point now) const noexcept;
+
+    /**
+     * @brief Выдача рабочего свободного подключения.
+     *
+     * Вызывается с заблокированным мьютексом. Разорванные подключения
+     * удаляются из пула.
+     *
+     * @return Подключение, nullptr - рабочих свободных подключений нет
+     */
+    [[nodiscard]] std::unique_ptr<ConnectionImpl> TakeIdle() noexcept;
+
+    /**
+     * @brief Освобождение места закрытого подключения.
+     *
+     * Место отдается первому запросу в очереди ожидания.
+     */
+    void Free() noexcept;
+
+    /**
+     * @brief Выдача подключения в аренду.
+     *
+     * @param connection Подключение
+     *
+     * @return Указатель на подключение, возвращающий его в пул при удалении
+     */
+    [[nodiscard]] std::shared_ptr<ConnectionImpl> Lease(
+        std::unique_ptr<ConnectionImpl> connection) noexcept;
+
+    /**
+     * @brief Создание нового подключения для зарезервированного места в пуле.
+     *
+     * Вызывается без блокировки мьютекса. Подключение устанавливается
+     * синхронно в вызывающем потоке: ожидание асинхронного подключения здесь
+     * может заблокировать поток исполнителя, в котором оно завершается.
+     *
+     * @return Указатель на подключение
+     */
+    [[nodiscard]] std::shared_ptr<ConnectionImpl> Open() noexcept;
+
+    /**
+     * @brief Асинхронное создание нового подключения для зарезервированного
+     * места в пуле.
+     *
+     * @param callback Обработчик, получающий подключение
+     */
+    void OpenAsync(Callback callback) noexcept;
+
+    /**
+     * @brief Добавление в пул подключения, открытого заранее.
+     *
+     * Неудачное подключение освобождает зарезервированное место в пуле.
+     *
+     * @param connection Подключение
+     */
+    void Add(std::unique_ptr<ConnectionImpl> connection) noexcept;
+
+    /**
+     * @brief Возврат подключения в пул.
+     *
+     * @param connection Подключение
+     */
+    void Return(std::unique_ptr<ConnectionImpl> connection) noexcept;
+
+    /**
+     * @brief Истечение времени ожидания асинхронного запроса.
+     *
+     * @param id Идентификатор запроса
+     */
+    void Expire(uint64_t id) noexcept;
+
+    /**
+     * @brief Удаление подключения, выданного в аренду.
+     *
+     * Если пул существует, подключение возвращается в пул, иначе удаляется.
+     *
+     * @param pool Пул подключений
+     * @param connection Подключение
+     * @param since Время выдачи подключения
+     */
+    static void Release(const std::weak_ptr<ConnectionPoolImpl> &pool,
+                        ConnectionImpl *connection,
+                        std::chrono::steady_clock::time_point since) noexcept;
+
+    /**
+     * @brief Имя подключения к БД из конф. файла.
+     */
+    std::string name_;
+
     /**
      * @brief Максимальное количество подключений к СУБД в пуле.
      */
     size_t max_;
 
+    /**
+     * @brief Минимальное количество подключений, открываемых заранее.
+     */
+    size_t min_;
+
+    /**
+     * @brief Максимальное время установки подключения.
+     */
+    std::chrono::microseconds connect_;
+
     /**
      * @brief Таймаут ожидания свободного подключения к СУБД.
      */
-    int timeout_;
+    std::chrono::microseconds timeout_;
 
     /**
      * @brief Количество попыток ожидания подключения к СУБД.
@@ -59,12 +369,99 @@ private:
     int retry_;
 
     /**
-     * @brief Пул подключений к СУБД.
+     * @brief Время, после которого неиспользуемое подключение закрывается,
+     * 0 - не закрывать.
+     */
+    std::chrono::microseconds idle_timeout_;
+
+    /**
+     * @brief Максимальное время жизни подключения, 0 - не ограничено.
+     */
+    std::chrono::microseconds lifetime_;
+
+    /**
+     * @brief Период обслуживания пула, 0 - не обслуживать.
+     */
+    std::chrono::microseconds check_;
+
+    /**
+     * @brief Допустимое отставание реплики от основной БД, 0 - не
+     * ограничено.
+     */
+    std::chrono::microseconds lag_;
+
+    /**
+     * @brief Имена подключений к репликам из конф. файла.
+     */
+    std::vector<std::string> replica_names_;
+
+    /**
+     * @brief Пулы подключений к репликам, создаются при первом запросе
+     * подключения для чтения.
+     */
+    std::vector<std::shared_ptr<ConnectionPoolImpl>> replicas_{};
+
+    /**
+     * @brief Флаг однократного создания пулов реплик.
+     */
+    std::once_flag replicas_once_{};
+
+    /**
+     * @brief Пул используется как реплика: при обслуживании проверяется
+     * отставание от основной БД.
+     */
+    std::atomic<bool> replica_{false};
+
+    /**
+     * @brief Реплика доступна для запросов на чтение.
+     */
+    std::atomic<bool> healthy_{true};
+
+    /**
+     * @brief Повторная проверка исключенной реплики запланирована.
+     */
+    std::atomic<bool> probing_{false};
+
+    /**
+     * @brief Интервал до следующей повторной проверки исключенной реплики.
+     */
+    std::chrono::microseconds backoff_{};
+
+    /**
+     * @brief Свободные подключения.
+     *
+     * Подключения выдаются с конца списка, т.е. первыми выдаются последние
+     * возвращенные подключения.
+     */
+    std::vector<Idle> idle_{};
+
+    /**
+     * @brief Количество открытых подключений, включая выданные в аренду и
+     * открываемые.
+     */
+    size_t total_{0};
+
+    /**
+     * @brief Синхронные и асинхронные запросы, ожидающие подключения, в
+     * порядке поступления.
+     *
+     * Очередь не пуста, только если свободных подключений и места в пуле
+     * нет.
+     */
+    std::deque<Waiter> waiters_{};
+
+    /**
+     * @brief Идентификатор следующего асинхронного запроса.
+     */
+    uint64_t next_waiter_{0};
+
+    /**
+     * @brief Показатели работы пула.
      */
-    std::vector<std::shared_ptr<ConnectionImpl>> connections_{};
+    PoolMetrics metrics_{};
 
     /**
-     * @brief Мьютекс для синхронизации чтения/записи и перезагрузки логов.
+     * @brief Мьютекс для синхронизации доступа к пулу.
      */
     std::mutex mutex_{};
 };
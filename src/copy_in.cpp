@@ -0,0 +1,54 @@
+#include "tasp/db/pg/copy_in.hpp"
+
+#include "copy_in_impl.hpp"
+
+using std::any;
+using std::string_view;
+using std::unique_ptr;
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    CopyIn
+------------------------------------------------------------------------------*/
+CopyIn::CopyIn(unique_ptr<CopyInImpl> impl) noexcept
+: impl_(std::move(impl))
+{
+}
+
+//------------------------------------------------------------------------------
+CopyIn::~CopyIn() noexcept = default;
+
+//------------------------------------------------------------------------------
+bool CopyIn::Status() const noexcept
+{
+    return impl_->Status();
+}
+
+//------------------------------------------------------------------------------
+bool CopyIn::WriteRow(const vector<any> &values) const noexcept
+{
+    return impl_->WriteRow(values);
+}
+
+//------------------------------------------------------------------------------
+bool CopyIn::Write(string_view data) const noexcept
+{
+    return impl_->Write(data);
+}
+
+//------------------------------------------------------------------------------
+int64_t CopyIn::End() const noexcept
+{
+    return impl_->End();
+}
+
+//------------------------------------------------------------------------------
+void CopyIn::Abort(string_view message) const noexcept
+{
+    impl_->Abort(message);
+}
+
+}  // namespace tasp::db::pg
@@ -0,0 +1,606 @@
+#include "copy_in_impl.hpp"
+
+#include <cstring>
+#include <optional>
+
+#include <tasp/config.hpp>
+#include <tasp/db/pg/sql.hpp>
+#include <tasp/logging.hpp>
+
+#include "cell.hpp"
+#include "connection_impl.hpp"
+
+using std::any;
+using std::any_cast;
+using std::nullopt_t;
+using std::nullptr_t;
+using std::shared_ptr;
+using std::string;
+using std::string_view;
+using std::type_index;
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Заголовок двоичного формата COPY: сигнатура, флаги и длина
+ * расширения заголовка.
+ */
+static constexpr string_view binary_header{
+    "PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0", 19};
+
+/**
+ * @brief Проверка значения на NULL.
+ *
+ * @param value Значение
+ *
+ * @return Результат проверки
+ */
+static inline bool IsNullValue(const any &value) noexcept
+{
+    return !value.has_value() || value.type() == typeid(nullptr_t) ||
+           value.type() == typeid(nullopt_t);
+}
+
+/**
+ * @brief Добавление целого числа в сетевом порядке байт в буфер.
+ *
+ * @param buffer Буфер
+ * @param value Значение
+ */
+template<class Type>
+static inline void AppendNetwork(string &buffer, Type value) noexcept
+{
+    using Unsigned = std::make_unsigned_t<Type>;
+    const auto bits = static_cast<Unsigned>(value);
+    for (auto shift = static_cast<int>(sizeof(Type) - 1) * 8; shift >= 0;
+         shift -= 8)
+    {
+        buffer.push_back(static_cast<char>((bits >> shift) & 0xFFU));
+    }
+}
+
+/**
+ * @brief Проверка имени на идентификатор в двойных кавычках.
+ *
+ * @param name Имя
+ *
+ * @return true - имя целиком заключено в кавычки и все кавычки внутри
+ * удвоены
+ */
+static inline bool IsQuotedIdentifier(string_view name) noexcept
+{
+    if (name.size() < 2 || name.front() != '"')
+    {
+        return false;
+    }
+
+    const auto span = SkipSqlQuoted(name, 0, false);
+    return span.closed && span.end == name.size();
+}
+
+/**
+ * @brief Поиск точки, отделяющей схему от имени таблицы.
+ *
+ * @param table Имя таблицы
+ *
+ * @return Позиция первой точки вне двойных кавычек или npos
+ */
+static inline size_t FindSchemaDot(string_view table) noexcept
+{
+    bool quoted{false};
+    for (size_t pos = 0; pos < table.size(); ++pos)
+    {
+        if (table[pos] == '"')
+        {
+            quoted = !quoted;
+        }
+        else if (table[pos] == '.' && !quoted)
+        {
+            return pos;
+        }
+    }
+
+    return string_view::npos;
+}
+
+/**
+ * @brief Добавление в запрос экранированного имени.
+ *
+ * Имя, целиком заключенное в двойные кавычки с удвоенными кавычками внутри,
+ * считается уже экранированным. Любое другое имя экранируется
+ * PQescapeIdentifier.
+ *
+ * @param conn Подключение к СУБД
+ * @param query Запрос
+ * @param name Имя
+ *
+ * @return Результат экранирования
+ */
+static inline bool AppendIdentifier(PGconn *conn,
+                                    string &query,
+                                    string_view name) noexcept
+{
+    if (IsQuotedIdentifier(name))
+    {
+        query.append(name);
+        return true;
+    }
+
+    auto *escaped = PQescapeIdentifier(conn, name.data(), name.size());
+    if (escaped == nullptr)
+    {
+        Logging::Error("Ошибка экранирования имени {}: {}",
+                       name,
+                       PQerrorMessage(conn));
+        return false;
+    }
+
+    query.append(escaped);
+    PQfreemem(escaped);
+    return true;
+}
+
+/*------------------------------------------------------------------------------
+    CopyInImpl
+------------------------------------------------------------------------------*/
+CopyInImpl::CopyInImpl(shared_ptr<const ConnectionImpl> connection,
+                       string_view table,
+                       const vector<string> &columns,
+                       CopyIn::Format format) noexcept
+: connection_(std::move(connection))
+, format_(format)
+{
+    if (!connection_->Check())
+    {
+        return;
+    }
+
+    auto *conn = connection_->Native();
+
+    string query{"COPY "};
+    const auto dot = FindSchemaDot(table);
+    if (dot != string_view::npos)
+    {
+        if (!AppendIdentifier(conn, query, table.substr(0, dot)))
+        {
+            return;
+        }
+        query.push_back('.');
+        table.remove_prefix(dot + 1);
+    }
+
+    if (!AppendIdentifier(conn, query, table))
+    {
+        return;
+    }
+
+    if (!columns.empty())
+    {
+        query.append(" (");
+        for (const auto &column : columns)
+        {
+            if (&column != &columns.front())
+            {
+                query.append(", ");
+            }
+
+            if (!AppendIdentifier(conn, query, column))
+            {
+                return;
+            }
+        }
+        query.push_back(')');
+    }
+    query.append(" FROM STDIN");
+
+    switch (format_)
+    {
+        case CopyIn::Format::Csv:
+            query.append(" (FORMAT csv)");
+            break;
+        case CopyIn::Format::Binary:
+            query.append(" (FORMAT binary)");
+            break;
+        case CopyIn::Format::Text:
+            break;
+    }
+
+    Logging::Debug("Выполняется запрос к БД: {}", query);
+
+    auto *result = PQexec(connection_->Native(), query.c_str());
+    const auto copy = PQresultStatus(result) == PGRES_COPY_IN;
+    if (!copy)
+    {
+        Logging::Error("Ошибка запуска загрузки данных: {}",
+                       PQresultErrorMessage(result));
+    }
+    PQclear(result);
+
+    if (!copy)
+    {
+        while (auto *rest = PQgetResult(connection_->Native()))
+        {
+            PQclear(rest);
+        }
+        return;
+    }
+
+    static const auto capacity =
+        ConfigGlobal::Instance().Get<size_t>("database.copy.buffer", 65536);
+    capacity_ = capacity;
+    buffer_.reserve(capacity_);
+
+    if (format_ == CopyIn::Format::Binary)
+    {
+        buffer_.append(binary_header);
+    }
+
+    active_ = true;
+    status_ = true;
+}
+
+//------------------------------------------------------------------------------
+CopyInImpl::~CopyInImpl() noexcept
+{
+    if (active_)
+    {
+        [[maybe_unused]] const auto rows = End();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool CopyInImpl::Status() const noexcept
+{
+    return status_;
+}
+
+//------------------------------------------------------------------------------
+bool CopyInImpl::WriteRow(const vector<any> &values) noexcept
+{
+    if (!active_)
+    {
+        return false;
+    }
+
+    const auto size = buffer_.size();
+
+    if (format_ == CopyIn::Format::Binary)
+    {
+        AppendNetwork(buffer_, static_cast<int16_t>(values.size()));
+    }
+
+    for (const auto &value : values)
+    {
+        bool converted{false};
+        switch (format_)
+        {
+            case CopyIn::Format::Text:
+                if (&value != &values.front())
+                {
+                    buffer_.push_back('\t');
+                }
+                converted = AppendText(value);
+                break;
+            case CopyIn::Format::Csv:
+                if (&value != &values.front())
+                {
+                    buffer_.push_back(',');
+                }
+                converted = AppendCsv(value);
+                break;
+            case CopyIn::Format::Binary:
+                converted = AppendBinary(value);
+                break;
+        }
+
+        if (!converted)
+        {
+            buffer_.resize(size);
+            return false;
+        }
+    }
+
+    if (format_ != CopyIn::Format::Binary)
+    {
+        buffer_.push_back('\n');
+    }
+
+    return buffer_.size() < capacity_ || Flush();
+}
+
+//------------------------------------------------------------------------------
+bool CopyInImpl::Write(string_view data) noexcept
+{
+    if (!active_)
+    {
+        return false;
+    }
+
+    buffer_.append(data);
+    return buffer_.size() < capacity_ || Flush();
+}
+
+//------------------------------------------------------------------------------
+int64_t CopyInImpl::End() noexcept
+{
+    if (!active_)
+    {
+        return -1;
+    }
+
+    if (format_ == CopyIn::Format::Binary)
+    {
+        AppendNetwork(buffer_, int16_t{-1});
+    }
+
+    if (!Flush())
+    {
+        Abort("Ошибка передачи данных");
+        return -1;
+    }
+
+    active_ = false;
+    if (PQputCopyEnd(connection_->Native(), nullptr) != 1)
+    {
+        Logging::Error("Ошибка завершения загрузки данных: {}",
+                       PQerrorMessage(connection_->Native()));
+        status_ = false;
+    }
+
+    return Finish();
+}
+
+//------------------------------------------------------------------------------
+void CopyInImpl::Abort(string_view message) noexcept
+{
+    if (!active_)
+    {
+        return;
+    }
+
+    Logging::Debug("Отмена загрузки данных");
+
+    active_ = false;
+    status_ = false;
+    buffer_.clear();
+
+    const string reason{message.empty() ? "Загрузка отменена" : message};
+    PQputCopyEnd(connection_->Native(), reason.c_str());
+
+    while (auto *result = PQgetResult(connection_->Native()))
+    {
+        PQclear(result);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool CopyInImpl::AppendText(const any &value) noexcept
+{
+    if (IsNullValue(value))
+    {
+        buffer_.append("\\N");
+        return true;
+    }
+
+    if (!ConnectionImpl::ToText(value, text_))
+    {
+        return false;
+    }
+
+    for (const auto symbol : text_)
+    {
+        switch (symbol)
+        {
+            case '\\':
+                buffer_.append("\\\\");
+                break;
+            case '\t':
+                buffer_.append("\\t");
+                break;
+            case '\n':
+                buffer_.append("\\n");
+                break;
+            case '\r':
+                buffer_.append("\\r");
+                break;
+            default:
+                buffer_.push_back(symbol);
+                break;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool CopyInImpl::AppendCsv(const any &value) noexcept
+{
+    if (IsNullValue(value))
+    {
+        return true;
+    }
+
+    if (!ConnectionImpl::ToText(value, text_))
+    {
+        return false;
+    }
+
+    // Пустая строка заключается в кавычки, чтобы отличаться от NULL.
+    if (!text_.empty() && text_.find_first_of(",\"\r\n") == string::npos)
+    {
+        buffer_.append(text_);
+        return true;
+    }
+
+    buffer_.push_back('"');
+    for (const auto symbol : text_)
+    {
+        if (symbol == '"')
+        {
+            buffer_.push_back('"');
+        }
+        buffer_.push_back(symbol);
+    }
+    buffer_.push_back('"');
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool CopyInImpl::AppendBinary(const any &value) noexcept
+{
+    if (IsNullValue(value))
+    {
+        AppendNetwork(buffer_, int32_t{-1});
+        return true;
+    }
+
+    const auto visitor{binary_visitor_.find(type_index(value.type()))};
+    if (visitor == binary_visitor_.cend())
+    {
+        Logging::Error("Неизвестный тип данных для двоичного формата: {}",
+                       value.type().name());
+        return false;
+    }
+
+    visitor->second(value, buffer_);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool CopyInImpl::Flush() noexcept
+{
+    if (buffer_.empty())
+    {
+        return true;
+    }
+
+    if (PQputCopyData(connection_->Native(),
+                      buffer_.data(),
+                      static_cast<int>(buffer_.size())) != 1)
+    {
+        Logging::Error("Ошибка передачи данных: {}",
+                       PQerrorMessage(connection_->Native()));
+        status_ = false;
+        return false;
+    }
+
+    buffer_.clear();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int64_t CopyInImpl::Finish() noexcept
+{
+    int64_t rows{-1};
+    while (auto *result = PQgetResult(connection_->Native()))
+    {
+        if (PQresultStatus(result) == PGRES_COMMAND_OK)
+        {
+            rows = std::strtoll(PQcmdTuples(result), nullptr, 10);
+        }
+        else
+        {
+            Logging::Error("Ошибка загрузки данных: {}",
+                           PQresultErrorMessage(result));
+            status_ = false;
+        }
+        PQclear(result);
+    }
+
+    return status_ ? rows : -1;
+}
+
+/*------------------------------------------------------------------------------
+    BinaryVisitorList
+------------------------------------------------------------------------------*/
+template<class Type, class Func>
+static inline BinaryVisitorList::value_type ToBinaryVisitor(
+    const Func &func) noexcept
+{
+    return {type_index{typeid(Type)},
+            [func](const any &value, string &buffer)
+            {
+                func(any_cast<const Type &>(value), buffer);
+            }};
+}
+
+//------------------------------------------------------------------------------
+template<class Type, class Network>
+static inline void ConvertByNetwork(const Type &value, string &buffer) noexcept
+{
+    AppendNetwork(buffer, static_cast<int32_t>(sizeof(Network)));
+    AppendNetwork(buffer, static_cast<Network>(value));
+}
+
+//------------------------------------------------------------------------------
+template<class Type, class Network>
+static inline void ConvertByBits(const Type &value, string &buffer) noexcept
+{
+    static_assert(sizeof(Type) == sizeof(Network));
+
+    Network bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    AppendNetwork(buffer, static_cast<int32_t>(sizeof(Network)));
+    AppendNetwork(buffer, bits);
+}
+
+//------------------------------------------------------------------------------
+template<class Type>
+static inline void ConvertByBytes(const Type &value, string &buffer) noexcept
+{
+    const string_view bytes{value};
+    AppendNetwork(buffer, static_cast<int32_t>(bytes.size()));
+    buffer.append(bytes);
+}
+
+//------------------------------------------------------------------------------
+static inline void ConvertByBool(const bool &value, string &buffer) noexcept
+{
+    AppendNetwork(buffer, int32_t{1});
+    buffer.push_back(value ? '\1' : '\0');
+}
+
+//------------------------------------------------------------------------------
+static inline void ConvertByTimestamp(const Timestamp &value,
+                                      string &buffer) noexcept
+{
+    AppendNetwork(buffer, static_cast<int32_t>(sizeof(int64_t)));
+    AppendNetwork(buffer, PostgresTime(value));
+}
+
+//------------------------------------------------------------------------------
+static inline void ConvertByUuid(const Uuid &value, string &buffer) noexcept
+{
+    AppendNetwork(buffer, static_cast<int32_t>(value.size()));
+    buffer.append(reinterpret_cast<const char *>(value.data()), value.size());
+}
+
+//------------------------------------------------------------------------------
+static inline BinaryVisitorList BinaryVisitorInitialization() noexcept
+{
+    BinaryVisitorList list = {
+        ToBinaryVisitor<int16_t>(ConvertByNetwork<int16_t, int16_t>),
+        ToBinaryVisitor<int>(ConvertByNetwork<int, int32_t>),
+        ToBinaryVisitor<int64_t>(ConvertByNetwork<int64_t, int64_t>),
+        ToBinaryVisitor<size_t>(ConvertByNetwork<size_t, int64_t>),
+        ToBinaryVisitor<float>(ConvertByBits<float, uint32_t>),
+        ToBinaryVisitor<double>(ConvertByBits<double, uint64_t>),
+        ToBinaryVisitor<char *>(ConvertByBytes<char *>),
+        ToBinaryVisitor<char const *>(ConvertByBytes<char const *>),
+        ToBinaryVisitor<string>(ConvertByBytes<string>),
+        ToBinaryVisitor<string_view>(ConvertByBytes<string_view>),
+        ToBinaryVisitor<bool>(ConvertByBool),
+        ToBinaryVisitor<Timestamp>(ConvertByTimestamp),
+        ToBinaryVisitor<Uuid>(ConvertByUuid),
+    };
+    return list;
+}
+
+//------------------------------------------------------------------------------
+const BinaryVisitorList CopyInImpl::binary_visitor_{
+    BinaryVisitorInitialization()};
+
+}  // namespace tasp::db::pg
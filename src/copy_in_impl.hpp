@@ -0,0 +1,191 @@
+/**
+ * @file
+ * @brief Реализация интерфейсов для массовой загрузки данных в СУБД PostgreSQL
+ * командой COPY FROM STDIN.
+ */
+#ifndef TASP_COPY_IN_IMPL_HPP_
+#define TASP_COPY_IN_IMPL_HPP_
+
+#include <any>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include <tasp/db/pg/copy_in.hpp>
+
+namespace tasp::db::pg
+{
+
+class ConnectionImpl;
+
+/**
+ * @brief Тип данных для списка типов данных поддерживаемых для двоичного
+ * формата COPY с функциями добавления их двоичного представления в буфер.
+ */
+using BinaryVisitorList =
+    std::unordered_map<std::type_index,
+                       std::function<void(const std::any &, std::string &)>>;
+
+/**
+ * @brief Реализация интерфейса массовой загрузки данных.
+ */
+class CopyInImpl final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * Выполняет команду COPY FROM STDIN.
+     *
+     * @param connection Подключение к БД
+     * @param table Имя таблицы
+     * @param columns Имена столбцов, пустой список - все столбцы таблицы
+     * @param format Формат передачи данных
+     */
+    CopyInImpl(std::shared_ptr<const ConnectionImpl> connection,
+               std::string_view table,
+               const std::vector<std::string> &columns,
+               CopyIn::Format format) noexcept;
+
+    /**
+     * @brief Деструктор.
+     *
+     * Завершает загрузку, если она не была завершена или отменена.
+     */
+    ~CopyInImpl() noexcept;
+
+    /**
+     * @brief Статус загрузки.
+     *
+     * @return Статус
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Запись строки.
+     *
+     * @param values Значения столбцов
+     *
+     * @return Результат записи
+     */
+    bool WriteRow(const std::vector<std::any> &values) noexcept;
+
+    /**
+     * @brief Запись данных, уже подготовленных в формате загрузки.
+     *
+     * @param data Данные
+     *
+     * @return Результат записи
+     */
+    bool Write(std::string_view data) noexcept;
+
+    /**
+     * @brief Завершение загрузки.
+     *
+     * @return Количество загруженных строк, -1 при ошибке
+     */
+    [[nodiscard]] int64_t End() noexcept;
+
+    /**
+     * @brief Отмена загрузки.
+     *
+     * @param message Причина отмены
+     */
+    void Abort(std::string_view message) noexcept;
+
+    CopyInImpl(const CopyInImpl &) = delete;
+    CopyInImpl(CopyInImpl &&) = delete;
+    CopyInImpl &operator=(const CopyInImpl &) = delete;
+    CopyInImpl &operator=(CopyInImpl &&) = delete;
+
+private:
+    /**
+     * @brief Добавление значения в текстовом формате в буфер.
+     *
+     * @param value Значение
+     *
+     * @return Результат преобразования
+     */
+    [[nodiscard]] bool AppendText(const std::any &value) noexcept;
+
+    /**
+     * @brief Добавление значения в формате CSV в буфер.
+     *
+     * @param value Значение
+     *
+     * @return Результат преобразования
+     */
+    [[nodiscard]] bool AppendCsv(const std::any &value) noexcept;
+
+    /**
+     * @brief Добавление значения в двоичном формате в буфер.
+     *
+     * @param value Значение
+     *
+     * @return Результат преобразования
+     */
+    [[nodiscard]] bool AppendBinary(const std::any &value) noexcept;
+
+    /**
+     * @brief Передача накопленных данных серверу.
+     *
+     * @return Результат передачи
+     */
+    [[nodiscard]] bool Flush() noexcept;
+
+    /**
+     * @brief Получение результата выполнения команды COPY.
+     *
+     * @return Количество загруженных строк, -1 при ошибке
+     */
+    [[nodiscard]] int64_t Finish() noexcept;
+
+    /**
+     * @brief Подключение к БД.
+     */
+    std::shared_ptr<const ConnectionImpl> connection_;
+
+    /**
+     * @brief Формат передачи данных.
+     */
+    CopyIn::Format format_;
+
+    /**
+     * @brief Буфер данных для передачи серверу.
+     */
+    std::string buffer_{};
+
+    /**
+     * @brief Размер буфера, при достижении которого данные передаются серверу.
+     */
+    size_t capacity_{0};
+
+    /**
+     * @brief Временная строка для текстового представления значения.
+     */
+    std::string text_{};
+
+    /**
+     * @brief Загрузка выполняется.
+     */
+    bool active_{false};
+
+    /**
+     * @brief Статус загрузки.
+     */
+    bool status_{false};
+
+    /**
+     * @brief Список типов данных поддерживаемых для двоичного формата.
+     */
+    static const BinaryVisitorList binary_visitor_;
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_COPY_IN_IMPL_HPP_
@@ -0,0 +1,55 @@
+#include "tasp/db/pg/copy_out.hpp"
+
+#include "copy_out_impl.hpp"
+
+using std::optional;
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    CopyOut
+------------------------------------------------------------------------------*/
+CopyOut::CopyOut(unique_ptr<CopyOutImpl> impl) noexcept
+: impl_(std::move(impl))
+{
+}
+
+//------------------------------------------------------------------------------
+CopyOut::~CopyOut() noexcept = default;
+
+//------------------------------------------------------------------------------
+bool CopyOut::Status() const noexcept
+{
+    return impl_->Status();
+}
+
+//------------------------------------------------------------------------------
+string_view CopyOut::Next() const noexcept
+{
+    return impl_->Next();
+}
+
+//------------------------------------------------------------------------------
+bool CopyOut::NextRow(vector<optional<string>> &row) const noexcept
+{
+    return impl_->NextRow(row);
+}
+
+//------------------------------------------------------------------------------
+int64_t CopyOut::WriteTo(int descriptor) const noexcept
+{
+    return impl_->WriteTo(descriptor);
+}
+
+//------------------------------------------------------------------------------
+int64_t CopyOut::Rows() const noexcept
+{
+    return impl_->Rows();
+}
+
+}  // namespace tasp::db::pg
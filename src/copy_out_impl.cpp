@@ -0,0 +1,342 @@
+#include "copy_out_impl.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <tasp/logging.hpp>
+
+#include "connection_impl.hpp"
+
+using std::nullopt;
+using std::optional;
+using std::shared_ptr;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Проверка символа на восьмеричную цифру.
+ *
+ * @param symbol Символ
+ *
+ * @return Результат проверки
+ */
+static inline bool IsOctal(char symbol) noexcept
+{
+    return symbol >= '0' && symbol <= '7';
+}
+
+/**
+ * @brief Значение шестнадцатеричной цифры.
+ *
+ * @param symbol Символ
+ *
+ * @return Значение, -1 - символ не является шестнадцатеричной цифрой
+ */
+static inline int HexDigit(char symbol) noexcept
+{
+    if (symbol >= '0' && symbol <= '9')
+    {
+        return symbol - '0';
+    }
+    if (symbol >= 'a' && symbol <= 'f')
+    {
+        return symbol - 'a' + 10;
+    }
+    if (symbol >= 'A' && symbol <= 'F')
+    {
+        return symbol - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Разбор значения столбца в текстовом формате COPY.
+ *
+ * @param field Значение с экранированием
+ *
+ * @return Значение, std::nullopt - значение NULL
+ */
+static inline optional<string> UnescapeField(string_view field) noexcept
+{
+    if (field == "\\N")
+    {
+        return nullopt;
+    }
+
+    string value;
+    value.reserve(field.size());
+    for (size_t index = 0; index < field.size(); ++index)
+    {
+        if (field[index] != '\\' || index + 1 == field.size())
+        {
+            value.push_back(field[index]);
+            continue;
+        }
+
+        const auto symbol = field[++index];
+        switch (symbol)
+        {
+            case 'b':
+                value.push_back('\b');
+                break;
+            case 'f':
+                value.push_back('\f');
+                break;
+            case 'n':
+                value.push_back('\n');
+                break;
+            case 'r':
+                value.push_back('\r');
+                break;
+            case 't':
+                value.push_back('\t');
+                break;
+            case 'v':
+                value.push_back('\v');
+                break;
+            case 'x':
+            {
+                int code{0};
+                size_t digits{0};
+                while (digits < 2 && index + 1 < field.size() &&
+                       HexDigit(field[index + 1]) >= 0)
+                {
+                    code = code * 16 + HexDigit(field[++index]);
+                    ++digits;
+                }
+                value.push_back(digits == 0 ? 'x' : static_cast<char>(code));
+                break;
+            }
+            default:
+                if (IsOctal(symbol))
+                {
+                    int code{symbol - '0'};
+                    for (size_t digits = 1; digits < 3 &&
+                                            index + 1 < field.size() &&
+                                            IsOctal(field[index + 1]);
+                         ++digits)
+                    {
+                        code = code * 8 + (field[++index] - '0');
+                    }
+                    value.push_back(static_cast<char>(code));
+                }
+                else
+                {
+                    value.push_back(symbol);
+                }
+                break;
+        }
+    }
+
+    return value;
+}
+
+/*------------------------------------------------------------------------------
+    CopyOutImpl
+------------------------------------------------------------------------------*/
+CopyOutImpl::CopyOutImpl(shared_ptr<const ConnectionImpl> connection,
+                         string_view query,
+                         CopyOut::Format format) noexcept
+: connection_(std::move(connection))
+, format_(format)
+, chunk_(nullptr, PQfreemem)
+{
+    if (!connection_->Check())
+    {
+        return;
+    }
+
+    string copy{"COPY ("};
+    copy.append(query);
+    copy.append(") TO STDOUT");
+
+    switch (format_)
+    {
+        case CopyOut::Format::Csv:
+            copy.append(" (FORMAT csv)");
+            break;
+        case CopyOut::Format::Binary:
+            copy.append(" (FORMAT binary)");
+            break;
+        case CopyOut::Format::Text:
+            break;
+    }
+
+    Logging::Debug("Выполняется запрос к БД: {}", copy);
+
+    auto *result = PQexec(connection_->Native(), copy.c_str());
+    const auto started = PQresultStatus(result) == PGRES_COPY_OUT;
+    if (!started)
+    {
+        Logging::Error("Ошибка запуска выгрузки данных: {}",
+                       PQresultErrorMessage(result));
+    }
+    PQclear(result);
+
+    if (!started)
+    {
+        Finish();
+        status_ = false;
+        return;
+    }
+
+    active_ = true;
+    status_ = true;
+}
+
+//------------------------------------------------------------------------------
+CopyOutImpl::~CopyOutImpl() noexcept
+{
+    if (!active_)
+    {
+        return;
+    }
+
+    Logging::Debug("Отмена выгрузки данных");
+
+    connection_->Cancel();
+
+    char *buffer{nullptr};
+    while (PQgetCopyData(connection_->Native(), &buffer, 0) > 0)
+    {
+        PQfreemem(buffer);
+    }
+
+    active_ = false;
+    Finish();
+}
+
+//------------------------------------------------------------------------------
+bool CopyOutImpl::Status() const noexcept
+{
+    return status_;
+}
+
+//------------------------------------------------------------------------------
+string_view CopyOutImpl::Next() noexcept
+{
+    chunk_.reset();
+    if (!active_)
+    {
+        return {};
+    }
+
+    char *buffer{nullptr};
+    const auto length = PQgetCopyData(connection_->Native(), &buffer, 0);
+    if (length > 0)
+    {
+        chunk_.reset(buffer);
+        return {chunk_.get(), static_cast<size_t>(length)};
+    }
+
+    if (length == -2)
+    {
+        Logging::Error("Ошибка получения данных: {}",
+                       PQerrorMessage(connection_->Native()));
+        status_ = false;
+    }
+
+    Finish();
+    return {};
+}
+
+//------------------------------------------------------------------------------
+bool CopyOutImpl::NextRow(vector<optional<string>> &row) noexcept
+{
+    if (format_ != CopyOut::Format::Text)
+    {
+        Logging::Error("Разбор строк поддерживается только для текстового "
+                       "формата выгрузки");
+        return false;
+    }
+
+    auto line = Next();
+    if (line.empty())
+    {
+        return false;
+    }
+
+    if (line.back() == '\n')
+    {
+        line.remove_suffix(1);
+    }
+
+    row.clear();
+    for (;;)
+    {
+        const auto tab = line.find('\t');
+        row.push_back(UnescapeField(line.substr(0, tab)));
+        if (tab == string_view::npos)
+        {
+            break;
+        }
+        line.remove_prefix(tab + 1);
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int64_t CopyOutImpl::WriteTo(int descriptor) noexcept
+{
+    int64_t total{0};
+    for (auto chunk = Next(); !chunk.empty(); chunk = Next())
+    {
+        while (!chunk.empty())
+        {
+            const auto written = write(descriptor, chunk.data(), chunk.size());
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                Logging::Error("Ошибка записи данных: {}",
+                               std::strerror(errno));
+                return -1;
+            }
+
+            chunk.remove_prefix(static_cast<size_t>(written));
+            total += written;
+        }
+    }
+
+    return status_ ? total : -1;
+}
+
+//------------------------------------------------------------------------------
+int64_t CopyOutImpl::Rows() const noexcept
+{
+    return rows_;
+}
+
+//------------------------------------------------------------------------------
+void CopyOutImpl::Finish() noexcept
+{
+    while (auto *result = PQgetResult(connection_->Native()))
+    {
+        if (PQresultStatus(result) == PGRES_COMMAND_OK)
+        {
+            rows_ = std::strtoll(PQcmdTuples(result), nullptr, 10);
+        }
+        else if (active_)
+        {
+            Logging::Error("Ошибка выгрузки данных: {}",
+                           PQresultErrorMessage(result));
+            status_ = false;
+        }
+        PQclear(result);
+    }
+
+    active_ = false;
+}
+
+}  // namespace tasp::db::pg
@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @brief Реализация интерфейсов для выгрузки данных из СУБД PostgreSQL
+ * командой COPY TO STDOUT.
+ */
+#ifndef TASP_COPY_OUT_IMPL_HPP_
+#define TASP_COPY_OUT_IMPL_HPP_
+
+#include <postgresql/libpq-fe.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tasp/db/pg/copy_out.hpp>
+
+namespace tasp::db::pg
+{
+
+class ConnectionImpl;
+
+/**
+ * @brief Реализация интерфейса выгрузки данных.
+ */
+class CopyOutImpl final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * Выполняет команду COPY (query) TO STDOUT.
+     *
+     * @param connection Подключение к БД
+     * @param query SQL-запрос, результат которого выгружается
+     * @param format Формат передачи данных
+     */
+    CopyOutImpl(std::shared_ptr<const ConnectionImpl> connection,
+                std::string_view query,
+                CopyOut::Format format) noexcept;
+
+    /**
+     * @brief Деструктор.
+     *
+     * Если получены не все данные, выгрузка отменяется.
+     */
+    ~CopyOutImpl() noexcept;
+
+    /**
+     * @brief Статус выгрузки.
+     *
+     * @return Статус
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Запрос следующего блока данных.
+     *
+     * @return Блок данных, пустой блок - данные закончились
+     */
+    [[nodiscard]] std::string_view Next() noexcept;
+
+    /**
+     * @brief Запрос следующей строки с разбором на значения столбцов.
+     *
+     * @param row Значения столбцов
+     *
+     * @return Результат
+     */
+    [[nodiscard]] bool NextRow(
+        std::vector<std::optional<std::string>> &row) noexcept;
+
+    /**
+     * @brief Запись всех оставшихся данных в файловый дескриптор.
+     *
+     * @param descriptor Файловый дескриптор
+     *
+     * @return Количество записанных байт, -1 при ошибке
+     */
+    [[nodiscard]] int64_t WriteTo(int descriptor) noexcept;
+
+    /**
+     * @brief Количество выгруженных строк.
+     *
+     * @return Количество строк
+     */
+    [[nodiscard]] int64_t Rows() const noexcept;
+
+    CopyOutImpl(const CopyOutImpl &) = delete;
+    CopyOutImpl(CopyOutImpl &&) = delete;
+    CopyOutImpl &operator=(const CopyOutImpl &) = delete;
+    CopyOutImpl &operator=(CopyOutImpl &&) = delete;
+
+private:
+    /**
+     * @brief Получение результата выполнения команды COPY.
+     */
+    void Finish() noexcept;
+
+    /**
+     * @brief Подключение к БД.
+     */
+    std::shared_ptr<const ConnectionImpl> connection_;
+
+    /**
+     * @brief Формат передачи данных.
+     */
+    CopyOut::Format format_;
+
+    /**
+     * @brief Последний полученный блок данных, память выделена libpq.
+     */
+    std::unique_ptr<char, decltype(&PQfreemem)> chunk_;
+
+    /**
+     * @brief Количество выгруженных строк.
+     */
+    int64_t rows_{-1};
+
+    /**
+     * @brief Выгрузка выполняется, и не все данные получены.
+     */
+    bool active_{false};
+
+    /**
+     * @brief Статус выгрузки.
+     */
+    bool status_{false};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_COPY_OUT_IMPL_HPP_
@@ -0,0 +1,53 @@
+#include "tasp/db/pg/executor.hpp"
+
+#include <mutex>
+
+using std::function;
+using std::mutex;
+using std::scoped_lock;
+using std::shared_ptr;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Установленный исполнитель.
+ */
+static shared_ptr<Executor> global_executor{};
+
+/**
+ * @brief Мьютекс для синхронизации доступа к исполнителю.
+ */
+static mutex global_executor_mutex{};
+
+/*------------------------------------------------------------------------------
+    Executor
+------------------------------------------------------------------------------*/
+Executor::~Executor() noexcept = default;
+
+//------------------------------------------------------------------------------
+void Executor::Set(shared_ptr<Executor> executor) noexcept
+{
+    const scoped_lock lock{global_executor_mutex};
+    global_executor = std::move(executor);
+}
+
+//------------------------------------------------------------------------------
+void Executor::Dispatch(function<void()> task) noexcept
+{
+    shared_ptr<Executor> executor{};
+    {
+        const scoped_lock lock{global_executor_mutex};
+        executor = global_executor;
+    }
+
+    if (executor)
+    {
+        executor->Post(std::move(task));
+        return;
+    }
+
+    task();
+}
+
+}  // namespace tasp::db::pg
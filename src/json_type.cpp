@@ -0,0 +1,473 @@
+#include "json_type.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cell.hpp"
+#include "json_writer.hpp"
+
+using std::pair;
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Таблица представления встроенных типов PostgreSQL. Массивы
+ * определяются по типу элементов (oid::arrays).
+ */
+static constexpr std::array<pair<Oid, JsonType::Kind>, 18> json_types{{
+    {oid::boolean, JsonType::Kind::Boolean},
+    {oid::int2, JsonType::Kind::Integer},
+    {oid::int4, JsonType::Kind::Integer},
+    {oid::int8, JsonType::Kind::Integer},
+    {oid::oid, JsonType::Kind::Integer},
+    {oid::float4, JsonType::Kind::Float},
+    {oid::float8, JsonType::Kind::Float},
+    {oid::numeric, JsonType::Kind::Numeric},
+    {oid::json, JsonType::Kind::Json},
+    {oid::jsonb, JsonType::Kind::Json},
+    {oid::bytea, JsonType::Kind::String},
+    {oid::name, JsonType::Kind::String},
+    {oid::text, JsonType::Kind::String},
+    {oid::bpchar, JsonType::Kind::String},
+    {oid::varchar, JsonType::Kind::String},
+    {oid::date, JsonType::Kind::String},
+    {oid::timestamp, JsonType::Kind::String},
+    {oid::timestamptz, JsonType::Kind::String},
+}};
+
+/**
+ * @brief Разбор документа json.
+ *
+ * @param text Текст документа
+ * @param value Переменная для значения
+ *
+ * @return Результат разбора
+ */
+static inline bool ParseJson(string_view text, Json::Value &value) noexcept
+{
+    thread_local const unique_ptr<Json::CharReader> reader{
+        Json::CharReaderBuilder{}.newCharReader()};
+
+    return reader->parse(
+        text.data(), text.data() + text.size(), &value, nullptr);
+}
+
+/**
+ * @brief Преобразование текста скалярного значения в Json::Value.
+ *
+ * @param text Текст значения
+ * @param kind Вид значения
+ *
+ * @return Значение JSON
+ */
+static inline Json::Value ScalarValue(string_view text,
+                                      JsonType::Kind kind) noexcept
+{
+    switch (kind)
+    {
+        case JsonType::Kind::Boolean:
+        {
+            bool value{false};
+            if (JsonType::Parse(text, value))
+            {
+                return value;
+            }
+            break;
+        }
+        case JsonType::Kind::Integer:
+        {
+            int64_t value{0};
+            if (JsonType::Parse(text, value))
+            {
+                return Json::Value{static_cast<Json::Int64>(value)};
+            }
+            break;
+        }
+        case JsonType::Kind::Float:
+        {
+            double value{0};
+            if (JsonType::Parse(text, value))
+            {
+                return value;
+            }
+            break;
+        }
+        case JsonType::Kind::Json:
+        {
+            Json::Value value{};
+            if (ParseJson(text, value))
+            {
+                return value;
+            }
+            break;
+        }
+        case JsonType::Kind::Numeric:
+        case JsonType::Kind::String:
+            break;
+    }
+
+    return Json::Value{text.data(), text.data() + text.size()};
+}
+
+/**
+ * @brief Запись текста скалярного значения в формате JSON.
+ *
+ * @param text Текст значения
+ * @param kind Вид значения
+ * @param buffer Строка для записи
+ */
+static inline void WriteScalar(string_view text,
+                               JsonType::Kind kind,
+                               string &buffer) noexcept
+{
+    switch (kind)
+    {
+        case JsonType::Kind::Boolean:
+        {
+            bool value{false};
+            if (JsonType::Parse(text, value))
+            {
+                buffer.append(value ? "true" : "false");
+                return;
+            }
+            break;
+        }
+        case JsonType::Kind::Integer:
+        {
+            int64_t value{0};
+            if (JsonType::Parse(text, value))
+            {
+                buffer.append(text);
+                return;
+            }
+            break;
+        }
+        case JsonType::Kind::Float:
+        case JsonType::Kind::Numeric:
+        {
+            double value{0};
+            if (JsonType::Parse(text, value))
+            {
+                buffer.append(text);
+                return;
+            }
+            break;
+        }
+        case JsonType::Kind::Json:
+            if (!text.empty())
+            {
+                buffer.append(text);
+                return;
+            }
+            break;
+        case JsonType::Kind::String:
+            break;
+    }
+
+    JsonWriter::WriteString(text, buffer);
+}
+
+/**
+ * @brief Построение Json::Value из литерала массива.
+ */
+class ArrayValue final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param kind Вид элементов массива
+     */
+    explicit ArrayValue(JsonType::Kind kind) noexcept
+    : kind_(kind)
+    {
+    }
+
+    /**
+     * @brief Начало массива.
+     */
+    void Begin() noexcept
+    {
+        stack_.emplace_back(Json::arrayValue);
+    }
+
+    /**
+     * @brief Конец массива.
+     */
+    void End() noexcept
+    {
+        auto array = std::move(stack_.back());
+        stack_.pop_back();
+
+        if (stack_.empty())
+        {
+            root_ = std::move(array);
+            return;
+        }
+
+        stack_.back().append(std::move(array));
+    }
+
+    /**
+     * @brief Элемент массива.
+     *
+     * @param value Текст элемента
+     * @param null Элемент - NULL
+     */
+    void Element(string_view value, bool null) noexcept
+    {
+        stack_.back().append(null ? Json::Value{} : ScalarValue(value, kind_));
+    }
+
+    /**
+     * @brief Запрос построенного массива.
+     *
+     * @return Массив
+     */
+    [[nodiscard]] Json::Value &Root() noexcept
+    {
+        return root_;
+    }
+
+private:
+    /**
+     * @brief Вид элементов массива.
+     */
+    JsonType::Kind kind_;
+
+    /**
+     * @brief Незавершенные массивы, последний - текущий.
+     */
+    vector<Json::Value> stack_{};
+
+    /**
+     * @brief Построенный массив.
+     */
+    Json::Value root_{};
+};
+
+/**
+ * @brief Запись литерала массива в формате JSON.
+ */
+class ArrayWriter final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param kind Вид элементов массива
+     * @param buffer Строка для записи
+     */
+    ArrayWriter(JsonType::Kind kind, string &buffer) noexcept
+    : kind_(kind)
+    , buffer_(buffer)
+    {
+    }
+
+    /**
+     * @brief Начало массива.
+     */
+    void Begin() noexcept
+    {
+        Separate();
+        buffer_.push_back('[');
+        first_ = true;
+    }
+
+    /**
+     * @brief Конец массива.
+     */
+    void End() noexcept
+    {
+        buffer_.push_back(']');
+        first_ = false;
+    }
+
+    /**
+     * @brief Элемент массива.
+     *
+     * @param value Текст элемента
+     * @param null Элемент - NULL
+     */
+    void Element(string_view value, bool null) noexcept
+    {
+        Separate();
+        if (null)
+        {
+            buffer_.append("null");
+            return;
+        }
+
+        WriteScalar(value, kind_, buffer_);
+    }
+
+private:
+    /**
+     * @brief Запись разделителя перед элементом, кроме первого.
+     */
+    void Separate() noexcept
+    {
+        if (!first_)
+        {
+            buffer_.push_back(',');
+        }
+        first_ = false;
+    }
+
+    /**
+     * @brief Вид элементов массива.
+     */
+    JsonType::Kind kind_;
+
+    /**
+     * @brief Строка для записи.
+     */
+    string &buffer_;
+
+    /**
+     * @brief Следующий элемент - первый в текущем массиве.
+     */
+    bool first_{true};
+};
+
+/*------------------------------------------------------------------------------
+    JsonType
+------------------------------------------------------------------------------*/
+JsonType JsonType::Of(Oid type) noexcept
+{
+    const auto element = oid::Element(type);
+    const auto scalar = element != InvalidOid ? element : type;
+
+    for (const auto &[key, kind] : json_types)
+    {
+        if (key == scalar)
+        {
+            return {kind, element != InvalidOid};
+        }
+    }
+
+    return {Kind::String, element != InvalidOid};
+}
+
+//------------------------------------------------------------------------------
+string_view JsonType::Text(const PGresult *result,
+                           int row,
+                           int column,
+                           string &scratch) noexcept
+{
+    if (PQfformat(result, column) == 0)
+    {
+        return {PQgetvalue(result, row, column),
+                static_cast<size_t>(PQgetlength(result, row, column))};
+    }
+
+    scratch = Cell{result, row, column}.Text();
+    return scratch;
+}
+
+//------------------------------------------------------------------------------
+Json::Value JsonType::Value(string_view text) const noexcept
+{
+    if (!array)
+    {
+        return ScalarValue(text, kind);
+    }
+
+    string scratch{};
+    ArrayValue visitor{kind};
+    if (!ParseArray(text, visitor, scratch))
+    {
+        return Json::Value{text.data(), text.data() + text.size()};
+    }
+
+    return std::move(visitor.Root());
+}
+
+//------------------------------------------------------------------------------
+void JsonType::Write(string_view text, string &buffer) const noexcept
+{
+    if (!array)
+    {
+        WriteScalar(text, kind, buffer);
+        return;
+    }
+
+    // При ошибке разбора массив записывается строкой.
+    const auto size = buffer.size();
+
+    string scratch{};
+    ArrayWriter visitor{kind, buffer};
+    if (!ParseArray(text, visitor, scratch))
+    {
+        buffer.resize(size);
+        JsonWriter::WriteString(text, buffer);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool JsonType::Parse(string_view text, bool &value) noexcept
+{
+    if (text == "t" || text == "true")
+    {
+        value = true;
+        return true;
+    }
+
+    if (text == "f" || text == "false")
+    {
+        value = false;
+        return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool JsonType::Parse(string_view text, int64_t &value) noexcept
+{
+    const auto *end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value);
+    return error == std::errc{} && ptr == end;
+}
+
+//------------------------------------------------------------------------------
+bool JsonType::Parse(string_view text, double &value) noexcept
+{
+    // Формат JSON не допускает знак + и точку без цифр перед ней, from_chars
+    // допускает inf и nan.
+    if (text.empty() || text.front() == '+' || text.front() == '.')
+    {
+        return false;
+    }
+
+#if defined(__cpp_lib_to_chars)
+    const auto *end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value);
+    if (error != std::errc{} || ptr != end)
+    {
+        return false;
+    }
+#else
+    const string copy{text};
+    char *end{nullptr};
+    value = std::strtod(copy.c_str(), &end);
+    if (end != copy.c_str() + copy.size())
+    {
+        return false;
+    }
+#endif
+
+    return std::isfinite(value);
+}
+
+}  // namespace tasp::db::pg
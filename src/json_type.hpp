@@ -0,0 +1,302 @@
+/**
+ * @file
+ * @brief Преобразование значений типов PostgreSQL в значения JSON.
+ */
+#ifndef TASP_JSON_TYPE_HPP_
+#define TASP_JSON_TYPE_HPP_
+
+#include <jsoncpp/json/json.h>
+#include <postgresql/libpq-fe.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Способ представления значения типа PostgreSQL в JSON.
+ *
+ * Определяется по OID типа столбца по таблице встроенных типов и их
+ * массивов. Типы, отсутствующие в таблице, представляются строками.
+ */
+struct JsonType
+{
+    /**
+     * @brief Вид значения JSON.
+     */
+    enum class Kind
+    {
+        Boolean, /*!< Логическое значение */
+        Integer, /*!< Целое число */
+        Float,   /*!< Число с плавающей точкой */
+        Numeric, /*!< Число numeric, в Json::Value - строка */
+        Json,    /*!< Документ json, jsonb */
+        String,  /*!< Строка */
+    };
+
+    /**
+     * @brief Вид значения или элементов массива.
+     */
+    Kind kind{Kind::String};
+
+    /**
+     * @brief Значение - массив элементов вида kind.
+     */
+    bool array{false};
+
+    /**
+     * @brief Определение способа представления типа.
+     *
+     * @param type OID типа данных
+     *
+     * @return Способ представления
+     */
+    [[nodiscard]] static JsonType Of(Oid type) noexcept;
+
+    /**
+     * @brief Запрос текста значения ячейки.
+     *
+     * Значения в текстовом формате возвращаются без копирования, значения в
+     * двоичном формате преобразуются в текстовое представление в scratch.
+     *
+     * @param result Результат выполнения запроса к СУБД библиотеки libpq
+     * @param row Номер строки
+     * @param column Номер столбца
+     * @param scratch Строка для преобразованного значения
+     *
+     * @return Текст значения
+     */
+    [[nodiscard]] static std::string_view Text(const PGresult *result,
+                                               int row,
+                                               int column,
+                                               std::string &scratch) noexcept;
+
+    /**
+     * @brief Преобразование текста значения в Json::Value.
+     *
+     * Значения, которые нельзя преобразовать в значение своего вида,
+     * например, NaN, представляются строками. Значения numeric
+     * представляются строками, так как Json::Value хранит числа в double и
+     * теряет точность.
+     *
+     * @param text Текст значения, не NULL
+     *
+     * @return Значение JSON
+     */
+    [[nodiscard]] Json::Value Value(std::string_view text) const noexcept;
+
+    /**
+     * @brief Запись текста значения в формате JSON.
+     *
+     * Числа и документы json записываются без промежуточного
+     * преобразования, в том виде, в котором получены от сервера.
+     *
+     * @param text Текст значения, не NULL
+     * @param buffer Строка для записи
+     */
+    void Write(std::string_view text, std::string &buffer) const noexcept;
+
+    /**
+     * @brief Разбор логического значения в текстовом формате PostgreSQL.
+     *
+     * @param text Текст значения
+     * @param value Переменная для значения
+     *
+     * @return Результат разбора
+     */
+    [[nodiscard]] static bool Parse(std::string_view text,
+                                    bool &value) noexcept;
+
+    /**
+     * @brief Разбор целого числа.
+     *
+     * @param text Текст значения
+     * @param value Переменная для значения
+     *
+     * @return Результат разбора
+     */
+    [[nodiscard]] static bool Parse(std::string_view text,
+                                    int64_t &value) noexcept;
+
+    /**
+     * @brief Разбор конечного числа с плавающей точкой.
+     *
+     * @param text Текст значения
+     * @param value Переменная для значения
+     *
+     * @return Результат разбора, false для NaN и Infinity
+     */
+    [[nodiscard]] static bool Parse(std::string_view text,
+                                    double &value) noexcept;
+};
+
+/**
+ * @brief Разбор литерала массива PostgreSQL за один проход.
+ *
+ * Поддерживаются вложенные массивы, элементы в кавычках, экранирование
+ * обратной косой чертой, элементы NULL и указание границ измерений вида
+ * [1:2]=. Для элементов без экранирования visitor получает участок исходной
+ * строки без копирования.
+ *
+ * Visitor должен содержать методы:
+ * - Begin() - начало массива;
+ * - End() - конец массива;
+ * - Element(std::string_view value, bool null) - элемент массива.
+ *
+ * @param text Литерал массива
+ * @param visitor Обработчик элементов
+ * @param scratch Строка для элементов с экранированием
+ *
+ * @return Результат разбора. При ошибке visitor может получить часть
+ * элементов
+ */
+template<typename Visitor>
+[[nodiscard]] bool ParseArray(std::string_view text,
+                              Visitor &visitor,
+                              std::string &scratch) noexcept
+{
+    const auto space = [](char symbol)
+    {
+        return symbol == ' ' || symbol == '\t' || symbol == '\n' ||
+               symbol == '\r' || symbol == '\v' || symbol == '\f';
+    };
+
+    size_t index{0};
+    if (!text.empty() && text.front() == '[')
+    {
+        index = text.find('=');
+        if (index == std::string_view::npos)
+        {
+            return false;
+        }
+        ++index;
+    }
+
+    if (index >= text.size() || text[index] != '{')
+    {
+        return false;
+    }
+
+    size_t depth{0};
+    while (index < text.size())
+    {
+        const auto symbol = text[index];
+
+        if (symbol == '{')
+        {
+            visitor.Begin();
+            ++depth;
+            ++index;
+            continue;
+        }
+
+        if (symbol == '}')
+        {
+            visitor.End();
+            ++index;
+            if (--depth == 0)
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (symbol == ',' || space(symbol))
+        {
+            ++index;
+            continue;
+        }
+
+        const auto quoted = symbol == '"';
+        if (quoted)
+        {
+            ++index;
+        }
+
+        // Элемент копируется в scratch только при наличии экранирования.
+        const auto begin = index;
+        auto escaped = false;
+        size_t last{index};
+        while (index < text.size())
+        {
+            const auto current = text[index];
+            if (current == '\\')
+            {
+                if (!escaped)
+                {
+                    escaped = true;
+                    scratch.assign(text.substr(begin, index - begin));
+                }
+                if (++index == text.size())
+                {
+                    return false;
+                }
+                scratch.push_back(text[index++]);
+                last = scratch.size();
+                continue;
+            }
+
+            if (quoted ? current == '"'
+                       : current == ',' || current == '}')
+            {
+                break;
+            }
+
+            if (escaped)
+            {
+                scratch.push_back(current);
+            }
+            ++index;
+            if (quoted || !space(current))
+            {
+                last = escaped ? scratch.size() : index;
+            }
+        }
+
+        if (index == text.size())
+        {
+            return false;
+        }
+
+        if (quoted)
+        {
+            ++index;
+            visitor.Element(escaped ? std::string_view{scratch}
+                                    : text.substr(begin, last - begin),
+                            false);
+            continue;
+        }
+
+        // Пробелы в конце элемента без кавычек не относятся к значению.
+        const auto value = escaped ? std::string_view{scratch}.substr(0, last)
+                                   : text.substr(begin, last - begin);
+        const auto null = !escaped && value.size() == 4 &&
+                          std::equal(value.cbegin(),
+                                     value.cend(),
+                                     "null",
+                                     [](char lhs, char rhs)
+                                     {
+                                         return (lhs | 0x20) == rhs;
+                                     });
+        visitor.Element(null ? std::string_view{} : value, null);
+    }
+
+    if (depth != 0)
+    {
+        return false;
+    }
+
+    while (index < text.size() && space(text[index]))
+    {
+        ++index;
+    }
+
+    return index == text.size();
+}
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_JSON_TYPE_HPP_
@@ -0,0 +1,197 @@
+#include "json_writer.hpp"
+
+#include <array>
+#include <charconv>
+#include <ostream>
+
+using std::string;
+using std::string_view;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Объем данных в строке, после которого они передаются в поток.
+ */
+static constexpr size_t flush_size{65536};
+
+/*------------------------------------------------------------------------------
+    JsonWriter
+------------------------------------------------------------------------------*/
+JsonWriter::JsonWriter(const ResultImpl &result,
+                       string &buffer,
+                       std::ostream *stream) noexcept
+: result_(result)
+, buffer_(buffer)
+, stream_(stream)
+{
+    const auto columns = result_.Columns();
+
+    types_.reserve(static_cast<size_t>(columns));
+    names_.reserve(static_cast<size_t>(columns));
+    for (auto column = 0; column < columns; ++column)
+    {
+        types_.push_back(JsonType::Of(PQftype(result_.Native(), column)));
+
+        string name{};
+        WriteString(PQfname(result_.Native(), column), name);
+        names_.push_back(std::move(name));
+    }
+}
+
+//------------------------------------------------------------------------------
+JsonWriter::~JsonWriter() noexcept = default;
+
+//------------------------------------------------------------------------------
+void JsonWriter::Write(Result::JsonShape shape) noexcept
+{
+    const auto rows = result_.Rows();
+
+    if (stream_ == nullptr)
+    {
+        buffer_.reserve(buffer_.size() + result_.Size());
+    }
+
+    std::array<char, 16> count{};
+    const auto [end, error] =
+        std::to_chars(count.data(), count.data() + count.size(), rows);
+
+    buffer_.append(R"({"count":)");
+    buffer_.append(count.data(), end);
+
+    if (shape == Result::JsonShape::Arrays)
+    {
+        buffer_.append(R"(,"columns":[)");
+        for (size_t column = 0; column < names_.size(); ++column)
+        {
+            if (column != 0)
+            {
+                buffer_.push_back(',');
+            }
+            buffer_.append(names_[column]);
+        }
+        buffer_.push_back(']');
+    }
+
+    buffer_.append(R"(,"data":[)");
+    for (auto row = 0; row < rows; ++row)
+    {
+        if (row != 0)
+        {
+            buffer_.push_back(',');
+        }
+
+        WriteRow(row, shape);
+        Flush(false);
+    }
+    buffer_.append("]}");
+
+    Flush(true);
+}
+
+//------------------------------------------------------------------------------
+void JsonWriter::WriteString(string_view value, string &buffer) noexcept
+{
+    static constexpr string_view hex{"0123456789abcdef"};
+
+    buffer.push_back('"');
+
+    // Символы, не требующие экранирования, копируются участками.
+    size_t begin{0};
+    for (size_t index = 0; index < value.size(); ++index)
+    {
+        const auto symbol = static_cast<unsigned char>(value[index]);
+        if (symbol >= 0x20 && symbol != '"' && symbol != '\\')
+        {
+            continue;
+        }
+
+        buffer.append(value.data() + begin, index - begin);
+        begin = index + 1;
+
+        switch (symbol)
+        {
+            case '"':
+                buffer.append(R"(\")");
+                break;
+            case '\\':
+                buffer.append(R"(\\)");
+                break;
+            case '\b':
+                buffer.append(R"(\b)");
+                break;
+            case '\f':
+                buffer.append(R"(\f)");
+                break;
+            case '\n':
+                buffer.append(R"(\n)");
+                break;
+            case '\r':
+                buffer.append(R"(\r)");
+                break;
+            case '\t':
+                buffer.append(R"(\t)");
+                break;
+            default:
+                buffer.append(R"(\u00)");
+                buffer.push_back(hex[symbol >> 4U]);
+                buffer.push_back(hex[symbol & 0x0FU]);
+                break;
+        }
+    }
+    buffer.append(value.data() + begin, value.size() - begin);
+
+    buffer.push_back('"');
+}
+
+//------------------------------------------------------------------------------
+void JsonWriter::WriteRow(int row, Result::JsonShape shape) noexcept
+{
+    const auto objects = shape == Result::JsonShape::Objects;
+
+    buffer_.push_back(objects ? '{' : '[');
+    for (size_t column = 0; column < types_.size(); ++column)
+    {
+        if (column != 0)
+        {
+            buffer_.push_back(',');
+        }
+
+        if (objects)
+        {
+            buffer_.append(names_[column]);
+            buffer_.push_back(':');
+        }
+
+        WriteValue(row, static_cast<int>(column));
+    }
+    buffer_.push_back(objects ? '}' : ']');
+}
+
+//------------------------------------------------------------------------------
+void JsonWriter::WriteValue(int row, int column) noexcept
+{
+    if (result_.IsNull(row, column))
+    {
+        buffer_.append("null");
+        return;
+    }
+
+    types_[static_cast<size_t>(column)].Write(
+        JsonType::Text(result_.Native(), row, column, scratch_), buffer_);
+}
+
+//------------------------------------------------------------------------------
+void JsonWriter::Flush(bool force) noexcept
+{
+    if (stream_ == nullptr || (!force && buffer_.size() < flush_size))
+    {
+        return;
+    }
+
+    stream_->write(buffer_.data(),
+                   static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
+
+}  // namespace tasp::db::pg
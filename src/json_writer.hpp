@@ -0,0 +1,128 @@
+/**
+ * @file
+ * @brief Запись результата запроса к СУБД PostgreSQL в формате JSON.
+ */
+#ifndef TASP_JSON_WRITER_HPP_
+#define TASP_JSON_WRITER_HPP_
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tasp/db/pg/result.hpp>
+
+#include "json_type.hpp"
+#include "result_impl.hpp"
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Запись результата запроса в формате JSON без построения
+ * Json::Value.
+ *
+ * Значения записываются напрямую из результата libpq с экранированием за
+ * один проход. Способ представления определяется один раз для каждого
+ * столбца по его типу, имена столбцов экранируются один раз для всего
+ * результата.
+ */
+class JsonWriter final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param result Результат запроса
+     * @param buffer Строка для записи, данные добавляются в конец
+     * @param stream Поток, в который передается содержимое строки при ее
+     * заполнении, nullptr - все данные остаются в строке
+     */
+    JsonWriter(const ResultImpl &result,
+               std::string &buffer,
+               std::ostream *stream = nullptr) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~JsonWriter() noexcept;
+
+    /**
+     * @brief Запись результата.
+     *
+     * @param shape Структура данных
+     */
+    void Write(Result::JsonShape shape) noexcept;
+
+    /**
+     * @brief Запись строки JSON с экранированием.
+     *
+     * @param value Значение
+     * @param buffer Строка для записи
+     */
+    static void WriteString(std::string_view value,
+                            std::string &buffer) noexcept;
+
+    JsonWriter(const JsonWriter &) = delete;
+    JsonWriter(JsonWriter &&) = delete;
+    JsonWriter &operator=(const JsonWriter &) = delete;
+    JsonWriter &operator=(JsonWriter &&) = delete;
+
+private:
+    /**
+     * @brief Запись строки результата.
+     *
+     * @param row Номер строки
+     * @param shape Структура данных
+     */
+    void WriteRow(int row, Result::JsonShape shape) noexcept;
+
+    /**
+     * @brief Запись значения ячейки.
+     *
+     * @param row Номер строки
+     * @param column Номер столбца
+     */
+    void WriteValue(int row, int column) noexcept;
+
+    /**
+     * @brief Передача содержимого строки в поток.
+     *
+     * @param force Передать независимо от объема данных
+     */
+    void Flush(bool force) noexcept;
+
+    /**
+     * @brief Результат запроса.
+     */
+    const ResultImpl &result_;
+
+    /**
+     * @brief Строка для записи.
+     */
+    std::string &buffer_;
+
+    /**
+     * @brief Поток для записи, nullptr - запись только в строку.
+     */
+    std::ostream *stream_;
+
+    /**
+     * @brief Способ представления значений столбцов.
+     */
+    std::vector<JsonType> types_{};
+
+    /**
+     * @brief Экранированные имена столбцов в кавычках.
+     */
+    std::vector<std::string> names_{};
+
+    /**
+     * @brief Строка для значений, преобразованных из двоичного формата.
+     */
+    std::string scratch_{};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_JSON_WRITER_HPP_
@@ -0,0 +1,183 @@
+#include "observers.hpp"
+
+#include <algorithm>
+
+#include <tasp/config.hpp>
+#include <tasp/logging.hpp>
+
+using std::make_shared;
+using std::scoped_lock;
+using std::shared_ptr;
+using std::chrono::duration;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Наблюдатель, записывающий запросы в журнал с уровнем Debug.
+ */
+class LogObserver final : public Observer
+{
+public:
+    /**
+     * @brief Начало выполнения запроса.
+     *
+     * @param query Событие
+     */
+    void OnStart(const Query &query) noexcept override
+    {
+        Logging::Debug("Выполняется запрос к БД: {}", query.sql);
+    }
+
+    /**
+     * @brief Завершение запроса.
+     *
+     * @param query Событие
+     */
+    void OnFinish(const Query &query) noexcept override
+    {
+        Logging::Debug("Запрос к БД выполнен за {} сек.",
+                       duration<double>(query.duration).count());
+    }
+};
+
+/*------------------------------------------------------------------------------
+    Observer
+------------------------------------------------------------------------------*/
+Observer::~Observer() noexcept = default;
+
+//------------------------------------------------------------------------------
+void Observer::OnStart(const Query & /*query*/) noexcept
+{
+}
+
+//------------------------------------------------------------------------------
+void Observer::OnFinish(const Query & /*query*/) noexcept
+{
+}
+
+//------------------------------------------------------------------------------
+void Observer::OnError(const Query & /*query*/) noexcept
+{
+}
+
+//------------------------------------------------------------------------------
+void Observer::OnCheckout(const Checkout & /*checkout*/) noexcept
+{
+}
+
+//------------------------------------------------------------------------------
+void Observer::Add(shared_ptr<Observer> observer) noexcept
+{
+    Observers::Add(std::move(observer));
+}
+
+//------------------------------------------------------------------------------
+void Observer::Remove(const shared_ptr<Observer> &observer) noexcept
+{
+    Observers::Remove(observer);
+}
+
+/*------------------------------------------------------------------------------
+    Observers
+------------------------------------------------------------------------------*/
+void Observers::Configure() noexcept
+{
+    static std::once_flag configured{};
+    std::call_once(configured,
+                   []
+                   {
+                       if (ConfigGlobal::Instance().Get<bool>(
+                               "database.log.queries", false))
+                       {
+                           Add(make_shared<LogObserver>());
+                       }
+                   });
+}
+
+//------------------------------------------------------------------------------
+void Observers::Add(shared_ptr<Observer> observer) noexcept
+{
+    if (observer == nullptr)
+    {
+        return;
+    }
+
+    const scoped_lock lock{mutex_};
+
+    auto list = list_ ? make_shared<List>(*list_) : make_shared<List>();
+    list->push_back(std::move(observer));
+
+    list_ = std::move(list);
+    active_ = true;
+}
+
+//------------------------------------------------------------------------------
+void Observers::Remove(const shared_ptr<Observer> &observer) noexcept
+{
+    const scoped_lock lock{mutex_};
+
+    if (!list_)
+    {
+        return;
+    }
+
+    auto list = make_shared<List>(*list_);
+    list->erase(std::remove(list->begin(), list->end(), observer),
+                list->end());
+
+    active_ = !list->empty();
+    list_ = std::move(list);
+}
+
+//------------------------------------------------------------------------------
+void Observers::Start(const Observer::Query &query) noexcept
+{
+    if (const auto list = Current())
+    {
+        for (const auto &observer : *list)
+        {
+            observer->OnStart(query);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Observers::Finish(const Observer::Query &query) noexcept
+{
+    if (const auto list = Current())
+    {
+        for (const auto &observer : *list)
+        {
+            if (query.error.empty())
+            {
+                observer->OnFinish(query);
+            }
+            else
+            {
+                observer->OnError(query);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Observers::Checkout(const Observer::Checkout &checkout) noexcept
+{
+    if (const auto list = Current())
+    {
+        for (const auto &observer : *list)
+        {
+            observer->OnCheckout(checkout);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+shared_ptr<const Observers::List> Observers::Current() noexcept
+{
+    const scoped_lock lock{mutex_};
+    return list_;
+}
+
+}  // namespace tasp::db::pg
@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @brief Список наблюдателей за выполнением запросов к СУБД PostgreSQL.
+ */
+#ifndef TASP_OBSERVERS_HPP_
+#define TASP_OBSERVERS_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <tasp/db/pg/observer.hpp>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Список зарегистрированных наблюдателей.
+ *
+ * Список заменяется целиком при изменении (copy-on-write), поэтому события
+ * рассылаются без блокировки на время вызова наблюдателей. Проверка наличия
+ * наблюдателей - одно чтение атомарного флага, события формируются только
+ * при его установке.
+ */
+class Observers final
+{
+public:
+    /**
+     * @brief Проверка наличия зарегистрированных наблюдателей.
+     *
+     * @return Результат проверки
+     */
+    [[nodiscard]] static bool Active() noexcept
+    {
+        return active_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Регистрация наблюдателей из конфигурационного файла.
+     *
+     * Выполняется один раз, при повторных вызовах ничего не делает.
+     */
+    static void Configure() noexcept;
+
+    /**
+     * @brief Регистрация наблюдателя.
+     *
+     * @param observer Наблюдатель
+     */
+    static void Add(std::shared_ptr<Observer> observer) noexcept;
+
+    /**
+     * @brief Удаление наблюдателя.
+     *
+     * @param observer Наблюдатель
+     */
+    static void Remove(const std::shared_ptr<Observer> &observer) noexcept;
+
+    /**
+     * @brief Рассылка события начала выполнения запроса.
+     *
+     * @param query Событие
+     */
+    static void Start(const Observer::Query &query) noexcept;
+
+    /**
+     * @brief Рассылка события завершения запроса.
+     *
+     * В зависимости от наличия сообщения об ошибке вызывается OnFinish или
+     * OnError.
+     *
+     * @param query Событие
+     */
+    static void Finish(const Observer::Query &query) noexcept;
+
+    /**
+     * @brief Рассылка события выдачи подключения из пула.
+     *
+     * @param checkout Событие
+     */
+    static void Checkout(const Observer::Checkout &checkout) noexcept;
+
+    Observers() = delete;
+
+private:
+    /**
+     * @brief Список наблюдателей.
+     */
+    using List = std::vector<std::shared_ptr<Observer>>;
+
+    /**
+     * @brief Запрос текущего списка наблюдателей.
+     *
+     * @return Указатель на список
+     */
+    [[nodiscard]] static std::shared_ptr<const List> Current() noexcept;
+
+    /**
+     * @brief Наличие зарегистрированных наблюдателей.
+     */
+    static inline std::atomic<bool> active_{false};
+
+    /**
+     * @brief Текущий список наблюдателей.
+     */
+    static inline std::shared_ptr<const List> list_{};
+
+    /**
+     * @brief Мьютекс для синхронизации изменения списка.
+     */
+    static inline std::mutex mutex_{};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_OBSERVERS_HPP_
@@ -0,0 +1,203 @@
+#include "tasp/db/pg/params.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#include "cell.hpp"
+#include "connection_impl.hpp"
+
+using std::any;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Запись числа с плавающей точкой.
+ *
+ * @param value Значение
+ * @param buffer Строка для записи
+ *
+ * @return Результат преобразования
+ */
+template<typename Type>
+static inline bool EncodeFloat(Type value, string &buffer) noexcept
+{
+    if (std::isnan(value))
+    {
+        buffer.append("NaN");
+        return true;
+    }
+
+    if (std::isinf(value))
+    {
+        buffer.append(value > 0 ? "Infinity" : "-Infinity");
+        return true;
+    }
+
+    std::array<char, 32> text{};
+#if defined(__cpp_lib_to_chars)
+    const auto [end, error] =
+        std::to_chars(text.data(), text.data() + text.size(), value);
+    buffer.append(text.data(), end);
+    return error == std::errc{};
+#else
+    const auto size = std::snprintf(text.data(),
+                                    text.size(),
+                                    "%.*g",
+                                    std::numeric_limits<Type>::max_digits10,
+                                    static_cast<double>(value));
+    buffer.append(text.data(), static_cast<size_t>(size));
+    return size > 0;
+#endif
+}
+
+/*------------------------------------------------------------------------------
+    Encoder
+------------------------------------------------------------------------------*/
+bool Encoder<float>::Encode(float value, string &buffer) noexcept
+{
+    return EncodeFloat(value, buffer);
+}
+
+//------------------------------------------------------------------------------
+bool Encoder<double>::Encode(double value, string &buffer) noexcept
+{
+    return EncodeFloat(value, buffer);
+}
+
+//------------------------------------------------------------------------------
+bool Encoder<Timestamp>::Encode(const Timestamp &value, string &buffer) noexcept
+{
+    buffer.append(TimestampText(value));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool Encoder<Uuid>::Encode(const Uuid &value, string &buffer) noexcept
+{
+    buffer.append(UuidText(value));
+    return true;
+}
+
+/*------------------------------------------------------------------------------
+    Params
+------------------------------------------------------------------------------*/
+Params::Params() noexcept = default;
+
+//------------------------------------------------------------------------------
+Params::Params(const vector<any> &values) noexcept
+{
+    Reserve(values.size());
+    for (const auto &value : values)
+    {
+        Add(value);
+    }
+}
+
+//------------------------------------------------------------------------------
+Params::~Params() noexcept = default;
+
+//------------------------------------------------------------------------------
+void Params::Add(const any &value) noexcept
+{
+    string text{};
+    const auto encoded = ConnectionImpl::ToText(value, text);
+
+    offsets_.push_back(data_.size());
+    data_.append(text);
+    End(encoded);
+}
+
+//------------------------------------------------------------------------------
+void Params::AddNull() noexcept
+{
+    offsets_.push_back(string::npos);
+}
+
+//------------------------------------------------------------------------------
+void Params::Reserve(size_t count) noexcept
+{
+    // Оценка среднего размера текстового значения параметра.
+    static constexpr size_t value_size{16};
+
+    offsets_.reserve(offsets_.size() + count);
+    data_.reserve(data_.size() + count * value_size);
+}
+
+//------------------------------------------------------------------------------
+size_t Params::Size() const noexcept
+{
+    return offsets_.size();
+}
+
+//------------------------------------------------------------------------------
+bool Params::Valid() const noexcept
+{
+    return valid_;
+}
+
+//------------------------------------------------------------------------------
+bool Params::IsNull(size_t index) const noexcept
+{
+    return index >= offsets_.size() || offsets_[index] == string::npos;
+}
+
+//------------------------------------------------------------------------------
+string_view Params::Value(size_t index) const noexcept
+{
+    if (IsNull(index))
+    {
+        return {};
+    }
+
+    return data_.c_str() + offsets_[index];
+}
+
+//------------------------------------------------------------------------------
+vector<const char *> Params::Pointers(size_t count) const noexcept
+{
+    count = std::min(count, offsets_.size());
+
+    vector<const char *> pointers{};
+    pointers.reserve(count);
+    for (size_t index = 0; index < count; ++index)
+    {
+        pointers.push_back(offsets_[index] == string::npos
+                               ? nullptr
+                               : data_.c_str() + offsets_[index]);
+    }
+
+    return pointers;
+}
+
+//------------------------------------------------------------------------------
+void Params::End(bool encoded) noexcept
+{
+    data_.push_back('\0');
+    if (!encoded)
+    {
+        valid_ = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void Params::Append(const Params &params) noexcept
+{
+    const auto base = data_.size();
+
+    offsets_.reserve(offsets_.size() + params.offsets_.size());
+    for (const auto offset : params.offsets_)
+    {
+        offsets_.push_back(offset == string::npos ? offset : base + offset);
+    }
+
+    data_.append(params.data_);
+    valid_ = valid_ && params.valid_;
+}
+
+}  // namespace tasp::db::pg
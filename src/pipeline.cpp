@@ -0,0 +1,69 @@
+#include "tasp/db/pg/pipeline.hpp"
+
+#include "pipeline_impl.hpp"
+
+using std::any;
+using std::make_unique;
+using std::string_view;
+using std::unique_ptr;
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    Pipeline
+------------------------------------------------------------------------------*/
+Pipeline::Pipeline(unique_ptr<PipelineImpl> impl) noexcept
+: impl_(std::move(impl))
+{
+}
+
+//------------------------------------------------------------------------------
+Pipeline::~Pipeline() noexcept = default;
+
+//------------------------------------------------------------------------------
+bool Pipeline::Status() const noexcept
+{
+    return impl_->Status();
+}
+
+//------------------------------------------------------------------------------
+bool Pipeline::Add(Result::Format format,
+                   string_view query,
+                   const vector<any> &params) const noexcept
+{
+    const Params values{params};
+    return Add(format, query, values);
+}
+
+//------------------------------------------------------------------------------
+bool Pipeline::Add(Result::Format format,
+                   string_view query,
+                   const Params &params) const noexcept
+{
+    return impl_->Add(query, params, format);
+}
+
+//------------------------------------------------------------------------------
+size_t Pipeline::Size() const noexcept
+{
+    return impl_->Size();
+}
+
+//------------------------------------------------------------------------------
+vector<unique_ptr<Result>> Pipeline::Results() const noexcept
+{
+    auto impls = impl_->Results();
+
+    vector<unique_ptr<Result>> results;
+    results.reserve(impls.size());
+    for (auto &impl : impls)
+    {
+        results.push_back(make_unique<Result>(std::move(impl)));
+    }
+
+    return results;
+}
+
+}  // namespace tasp::db::pg
@@ -0,0 +1,237 @@
+#include "pipeline_impl.hpp"
+
+#include <tasp/logging.hpp>
+
+#include "connection_impl.hpp"
+#include "observers.hpp"
+
+using std::make_unique;
+using std::shared_ptr;
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+using std::vector;
+using std::chrono::steady_clock;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    PipelineImpl
+------------------------------------------------------------------------------*/
+PipelineImpl::PipelineImpl(shared_ptr<const ConnectionImpl> connection) noexcept
+: connection_(std::move(connection))
+{
+    if (!connection_->Check())
+    {
+        status_ = false;
+        return;
+    }
+
+#if defined(LIBPQ_HAS_PIPELINING)
+    if (PQenterPipelineMode(connection_->Native()) == 1)
+    {
+        active_ = true;
+        return;
+    }
+#endif
+
+    Logging::Warning("Не удалось включить режим конвейера, запросы будут "
+                     "выполняться последовательно");
+}
+
+//------------------------------------------------------------------------------
+PipelineImpl::~PipelineImpl() noexcept
+{
+    if (!active_)
+    {
+        return;
+    }
+
+    if (queued_ != 0)
+    {
+        [[maybe_unused]] const auto results = Results();
+    }
+
+#if defined(LIBPQ_HAS_PIPELINING)
+    // Подключение возвращается в пул, поэтому оно не должно остаться в
+    // режиме конвейера с непрочитанными результатами.
+    if (!broken_ && PQexitPipelineMode(connection_->Native()) == 1)
+    {
+        return;
+    }
+
+    Logging::Error("Ошибка выключения режима конвейера, выполняется "
+                   "переподключение к БД: {}",
+                   PQerrorMessage(connection_->Native()));
+    static_cast<void>(connection_->Reconnect());
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool PipelineImpl::Status() const noexcept
+{
+    return status_;
+}
+
+//------------------------------------------------------------------------------
+bool PipelineImpl::Add(string_view query,
+                       const Params &params,
+                       Result::Format format) noexcept
+{
+    if (!active_)
+    {
+        results_.push_back(connection_->Exec(query, params, format));
+        return true;
+    }
+
+    const auto observed = Observers::Active();
+    if (observed)
+    {
+        const auto &event = observed_.emplace_back(
+            Observed{queued_, string{query}, params, steady_clock::now()});
+        Observers::Start({event.query, event.params, connection_.get()});
+    }
+
+    if (!connection_->Send(query, params, format))
+    {
+        if (observed)
+        {
+            const auto &event = observed_.back();
+            Observers::Finish({event.query,
+                               event.params,
+                               connection_.get(),
+                               steady_clock::now() - event.start,
+                               PQerrorMessage(connection_->Native())});
+            observed_.pop_back();
+        }
+        return false;
+    }
+
+    ++queued_;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+size_t PipelineImpl::Size() const noexcept
+{
+    return active_ ? queued_ : results_.size();
+}
+
+//------------------------------------------------------------------------------
+vector<unique_ptr<ResultImpl>> PipelineImpl::Results() noexcept
+{
+    auto results = std::move(results_);
+    results_.clear();
+
+#if defined(LIBPQ_HAS_PIPELINING)
+    if (!active_ || queued_ == 0)
+    {
+        return results;
+    }
+
+    auto *conn = connection_->Native();
+    results.reserve(queued_);
+
+    // Без точки синхронизации результаты пакета не будут получены, и
+    // подключение останется в режиме конвейера.
+    if (PQpipelineSync(conn) != 1)
+    {
+        Logging::Error("Ошибка отправки пакета запросов: {}",
+                       PQerrorMessage(conn));
+        status_ = false;
+        broken_ = true;
+    }
+
+    // Результат каждого запроса завершается nullptr, результат пакета -
+    // PGRES_PIPELINE_SYNC.
+    for (; queued_ != 0 && !broken_; --queued_)
+    {
+        auto *result = PQgetResult(conn);
+        if (result == nullptr)
+        {
+            Logging::Error("Ошибка получения результата пакета запросов: {}",
+                           PQerrorMessage(conn));
+            status_ = false;
+            broken_ = true;
+            break;
+        }
+
+        if (PQresultStatus(result) == PGRES_PIPELINE_SYNC)
+        {
+            Logging::Error("Нарушен порядок результатов пакета запросов");
+            PQclear(result);
+            status_ = false;
+            broken_ = true;
+            break;
+        }
+
+        results.push_back(make_unique<ResultImpl>(result));
+        while (auto *rest = PQgetResult(conn))
+        {
+            PQclear(rest);
+        }
+    }
+
+    for (; queued_ != 0; --queued_)
+    {
+        results.push_back(make_unique<ResultImpl>(nullptr));
+    }
+
+    const auto now = steady_clock::now();
+    for (const auto &query : observed_)
+    {
+        const auto &result = *results[query.index];
+        Observers::Finish({query.query,
+                           query.params,
+                           connection_.get(),
+                           now - query.start,
+                           result.Native() != nullptr
+                               ? result.Error()
+                               : "Результат пакета запросов не получен"});
+    }
+    observed_.clear();
+
+    if (!broken_ && !Synchronize(conn))
+    {
+        Logging::Error("Не получен конец пакета запросов: {}",
+                       PQerrorMessage(conn));
+        status_ = false;
+        broken_ = true;
+    }
+#endif
+
+    return results;
+}
+
+//------------------------------------------------------------------------------
+bool PipelineImpl::Synchronize([[maybe_unused]] PGconn *conn) noexcept
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+    // nullptr разделяет результаты запросов, два nullptr подряд означают,
+    // что результатов больше нет.
+    for (auto empty = 0; empty < 2;)
+    {
+        auto *result = PQgetResult(conn);
+        if (result == nullptr)
+        {
+            ++empty;
+            continue;
+        }
+
+        empty = 0;
+        const auto status = PQresultStatus(result);
+        PQclear(result);
+        if (status == PGRES_PIPELINE_SYNC)
+        {
+            return true;
+        }
+
+        Logging::Warning("Лишний результат пакета запросов пропущен");
+    }
+#endif
+
+    return false;
+}
+
+}  // namespace tasp::db::pg
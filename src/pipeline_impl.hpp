@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief Реализация интерфейсов для пакетного выполнения запросов к СУБД
+ * PostgreSQL в режиме конвейера.
+ */
+#ifndef TASP_PIPELINE_IMPL_HPP_
+#define TASP_PIPELINE_IMPL_HPP_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tasp/db/pg/params.hpp>
+#include <tasp/db/pg/result.hpp>
+
+#include "result_impl.hpp"
+
+namespace tasp::db::pg
+{
+
+class ConnectionImpl;
+
+/**
+ * @brief Реализация интерфейса пакетного выполнения запросов.
+ *
+ * Наблюдатели получают событие начала при добавлении запроса в пакет и
+ * событие завершения при получении его результата, время выполнения
+ * отсчитывается от добавления запроса.
+ */
+class PipelineImpl final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * Включает режим конвейера в подключении.
+     *
+     * @param connection Подключение к БД
+     */
+    explicit PipelineImpl(
+        std::shared_ptr<const ConnectionImpl> connection) noexcept;
+
+    /**
+     * @brief Деструктор.
+     *
+     * Получает результаты оставшихся запросов и выключает режим конвейера.
+     */
+    ~PipelineImpl() noexcept;
+
+    /**
+     * @brief Статус конвейера.
+     *
+     * @return Статус
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Добавление запроса в пакет.
+     *
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     *
+     * @return Результат отправки запроса
+     */
+    bool Add(std::string_view query,
+             const Params &params,
+             Result::Format format) noexcept;
+
+    /**
+     * @brief Количество запросов в пакете, ожидающих результата.
+     *
+     * @return Количество запросов
+     */
+    [[nodiscard]] size_t Size() const noexcept;
+
+    /**
+     * @brief Выполнение пакета и получение результатов.
+     *
+     * @return Результаты запросов в порядке добавления
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<ResultImpl>> Results() noexcept;
+
+    PipelineImpl(const PipelineImpl &) = delete;
+    PipelineImpl(PipelineImpl &&) = delete;
+    PipelineImpl &operator=(const PipelineImpl &) = delete;
+    PipelineImpl &operator=(PipelineImpl &&) = delete;
+
+private:
+    /**
+     * @brief Запрос пакета, переданный наблюдателям.
+     */
+    struct Observed
+    {
+        /**
+         * @brief Номер запроса в пакете.
+         */
+        size_t index;
+
+        /**
+         * @brief SQL-запрос.
+         */
+        std::string query;
+
+        /**
+         * @brief Параметры запроса.
+         */
+        Params params;
+
+        /**
+         * @brief Время добавления запроса.
+         */
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief Чтение оставшихся результатов пакета до PGRES_PIPELINE_SYNC.
+     *
+     * @param conn Подключение к СУБД
+     *
+     * @return Результат, false - конец пакета не получен
+     */
+    [[nodiscard]] static bool Synchronize(PGconn *conn) noexcept;
+
+    /**
+     * @brief Подключение к БД.
+     */
+    std::shared_ptr<const ConnectionImpl> connection_;
+
+    /**
+     * @brief Количество отправленных запросов, ожидающих результата.
+     */
+    size_t queued_{0};
+
+    /**
+     * @brief Запросы пакета, о завершении которых нужно сообщить
+     * наблюдателям, в порядке добавления.
+     */
+    std::vector<Observed> observed_{};
+
+    /**
+     * @brief Результаты запросов, выполненных без конвейера.
+     */
+    std::vector<std::unique_ptr<ResultImpl>> results_{};
+
+    /**
+     * @brief Режим конвейера включен.
+     */
+    bool active_{false};
+
+    /**
+     * @brief Статус конвейера.
+     */
+    bool status_{true};
+
+    /**
+     * @brief Результаты пакета не дочитаны до PGRES_PIPELINE_SYNC,
+     * подключение нужно переподключить.
+     */
+    bool broken_{false};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_PIPELINE_IMPL_HPP_
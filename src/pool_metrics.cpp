@@ -0,0 +1,78 @@
+#include "pool_metrics.hpp"
+
+using std::memory_order_relaxed;
+using std::chrono::steady_clock;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    PoolMetrics
+------------------------------------------------------------------------------*/
+PoolMetrics::PoolMetrics() noexcept = default;
+
+//------------------------------------------------------------------------------
+PoolMetrics::~PoolMetrics() noexcept = default;
+
+//------------------------------------------------------------------------------
+void PoolMetrics::Count(Event event, uint64_t count) noexcept
+{
+    events_[static_cast<size_t>(event)].fetch_add(count, memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void PoolMetrics::Wait(steady_clock::duration duration) noexcept
+{
+    wait_.Record(duration);
+}
+
+//------------------------------------------------------------------------------
+void PoolMetrics::Hold(steady_clock::duration duration) noexcept
+{
+    hold_.Record(duration);
+}
+
+//------------------------------------------------------------------------------
+void PoolMetrics::Fill(ConnectionPool::Metrics &metrics) const noexcept
+{
+    const auto event = [this](Event index)
+    {
+        return events_[static_cast<size_t>(index)].load(memory_order_relaxed);
+    };
+
+    metrics.acquired = event(Event::Acquired);
+    metrics.created = event(Event::Created);
+    metrics.failed = event(Event::Failed);
+    metrics.closed = event(Event::Closed);
+    metrics.exhausted = event(Event::Exhausted);
+    metrics.timeouts = event(Event::Timeout);
+
+    wait_.Fill(metrics.wait);
+    hold_.Fill(metrics.hold);
+}
+
+//------------------------------------------------------------------------------
+Json::Value PoolMetrics::JsonValue(
+    const ConnectionPool::Metrics &metrics) noexcept
+{
+    Json::Value json{Json::objectValue};
+
+    json["max"] = Json::UInt64{metrics.max};
+    json["active"] = Json::UInt64{metrics.active};
+    json["idle"] = Json::UInt64{metrics.idle};
+    json["waiting"] = Json::UInt64{metrics.waiting};
+
+    json["acquired"] = Json::UInt64{metrics.acquired};
+    json["created"] = Json::UInt64{metrics.created};
+    json["failed"] = Json::UInt64{metrics.failed};
+    json["closed"] = Json::UInt64{metrics.closed};
+    json["exhausted"] = Json::UInt64{metrics.exhausted};
+    json["timeouts"] = Json::UInt64{metrics.timeouts};
+
+    json["wait"] = AtomicHistogram::JsonValue(metrics.wait);
+    json["hold"] = AtomicHistogram::JsonValue(metrics.hold);
+
+    return json;
+}
+
+}  // namespace tasp::db::pg
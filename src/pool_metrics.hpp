@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @brief Показатели работы пула подключений к СУБД PostgreSQL.
+ */
+#ifndef TASP_POOL_METRICS_HPP_
+#define TASP_POOL_METRICS_HPP_
+
+#include <jsoncpp/json/json.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <tasp/db/pg/connection_pool.hpp>
+
+#include "atomic_histogram.hpp"
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Счетчики и гистограммы пула подключений.
+ *
+ * Значения обновляются атомарными операциями без блокировок, поэтому снимок
+ * не согласован между отдельными показателями.
+ */
+class PoolMetrics final
+{
+public:
+    /**
+     * @brief Счетчик событий пула.
+     */
+    enum class Event
+    {
+        Acquired,  /*!< Подключение выдано */
+        Created,   /*!< Подключение установлено */
+        Failed,    /*!< Неудачная попытка подключения */
+        Closed,    /*!< Подключение закрыто пулом */
+        Exhausted, /*!< Запрос не получил подключение сразу */
+        Timeout,   /*!< Запрос не дождался подключения */
+    };
+
+    /**
+     * @brief Конструктор.
+     */
+    PoolMetrics() noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~PoolMetrics() noexcept;
+
+    /**
+     * @brief Учет события.
+     *
+     * @param event Событие
+     * @param count Количество событий
+     */
+    void Count(Event event, uint64_t count = 1) noexcept;
+
+    /**
+     * @brief Учет времени ожидания подключения.
+     *
+     * @param duration Время ожидания
+     */
+    void Wait(std::chrono::steady_clock::duration duration) noexcept;
+
+    /**
+     * @brief Учет времени аренды подключения.
+     *
+     * @param duration Время аренды
+     */
+    void Hold(std::chrono::steady_clock::duration duration) noexcept;
+
+    /**
+     * @brief Заполнение снимка значениями счетчиков и гистограмм.
+     *
+     * @param metrics Снимок показателей
+     */
+    void Fill(ConnectionPool::Metrics &metrics) const noexcept;
+
+    /**
+     * @brief Преобразование снимка показателей в JSON.
+     *
+     * @param metrics Снимок показателей
+     *
+     * @return Показатели, длительности - в микросекундах
+     */
+    [[nodiscard]] static Json::Value JsonValue(
+        const ConnectionPool::Metrics &metrics) noexcept;
+
+    PoolMetrics(const PoolMetrics &) = delete;
+    PoolMetrics(PoolMetrics &&) = delete;
+    PoolMetrics &operator=(const PoolMetrics &) = delete;
+    PoolMetrics &operator=(PoolMetrics &&) = delete;
+
+private:
+    /**
+     * @brief Счетчики событий, индекс - значение Event.
+     */
+    std::array<std::atomic<uint64_t>, 6> events_{};
+
+    /**
+     * @brief Время ожидания подключения.
+     */
+    AtomicHistogram wait_{};
+
+    /**
+     * @brief Время аренды подключения.
+     */
+    AtomicHistogram hold_{};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_POOL_METRICS_HPP_
@@ -0,0 +1,252 @@
+#include "query_stats.hpp"
+
+#include <algorithm>
+
+#include <tasp/config.hpp>
+#include <tasp/db/pg/sql.hpp>
+#include <tasp/logging.hpp>
+
+#include "atomic_histogram.hpp"
+
+using std::scoped_lock;
+using std::string;
+using std::string_view;
+using std::vector;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Нормализация текста запроса с передачей символов в функцию.
+ *
+ * Участки запроса определяются по тем же правилам, что и при замене {}
+ * (FindSqlSpan): комментарии заменяются пробелом, строковые константы, в
+ * том числе E'...' и $tag$...$tag$, - символом ?, идентификаторы в кавычках
+ * не изменяются.
+ *
+ * @param query SQL-запрос
+ * @param append Функция, получающая символы нормализованного текста
+ */
+template<typename Append>
+static inline void Normalize(string_view query, Append &&append)
+{
+    char last{'\0'};
+    const auto put = [&append, &last](char symbol)
+    {
+        append(symbol);
+        last = symbol;
+    };
+
+    bool space{false};
+    size_t index{0};
+    while (index < query.size())
+    {
+        const auto span = FindSqlSpan(query, index);
+        const auto symbol = query[index];
+
+        if (span.kind == SqlSpan::Kind::Comment || IsSqlSpace(symbol))
+        {
+            space = true;
+            index = std::max(span.end, index + 1);
+            continue;
+        }
+
+        if (space && last != '\0')
+        {
+            put(' ');
+        }
+        space = false;
+
+        switch (span.kind)
+        {
+            case SqlSpan::Kind::Literal:
+            case SqlSpan::Kind::Escaped:
+            case SqlSpan::Kind::Dollar:
+                index = span.end;
+                put('?');
+                continue;
+            case SqlSpan::Kind::Identifier:
+                for (; index < span.end; ++index)
+                {
+                    put(query[index]);
+                }
+                continue;
+            case SqlSpan::Kind::Code:
+            case SqlSpan::Kind::Comment:
+                break;
+        }
+
+        if (symbol >= '0' && symbol <= '9' && !IsSqlWord(last))
+        {
+            while (index < query.size() &&
+                   (IsSqlWord(query[index]) || query[index] == '.'))
+            {
+                ++index;
+            }
+            put('?');
+            continue;
+        }
+
+        put(symbol);
+        ++index;
+    }
+}
+
+/**
+ * @brief Вычисление хеша нормализованного текста запроса без построения
+ * строки (FNV-1a).
+ *
+ * @param query SQL-запрос
+ *
+ * @return Хеш
+ */
+static inline uint64_t NormalizedHash(string_view query) noexcept
+{
+    uint64_t hash{14695981039346656037ULL};
+    Normalize(query,
+              [&hash](char symbol)
+              {
+                  hash ^= static_cast<unsigned char>(symbol);
+                  hash *= 1099511628211ULL;
+              });
+
+    return hash;
+}
+
+/*------------------------------------------------------------------------------
+    QueryStats
+------------------------------------------------------------------------------*/
+QueryStats &QueryStats::Instance() noexcept
+{
+    static QueryStats instance{};
+    return instance;
+}
+
+//------------------------------------------------------------------------------
+bool QueryStats::Enabled() const noexcept
+{
+    return enabled_ || slow_.count() != 0;
+}
+
+//------------------------------------------------------------------------------
+void QueryStats::Record(string_view query,
+                        uint64_t key,
+                        size_t params,
+                        steady_clock::duration time,
+                        const ResultImpl &result) noexcept
+{
+    if (!Enabled())
+    {
+        return;
+    }
+
+    const auto elapsed = duration_cast<microseconds>(time);
+
+    const auto slow = slow_.count() != 0 && elapsed >= slow_;
+    if (slow)
+    {
+        Logging::Warning("Медленный запрос к БД ({} сек., параметров {}): {}",
+                         duration<double>(elapsed).count(),
+                         params,
+                         Normalize(query));
+    }
+
+    if (!enabled_)
+    {
+        return;
+    }
+
+    if (key == 0)
+    {
+        key = NormalizedHash(query);
+    }
+
+    auto &shard = shards_[key % shards_.size()];
+    const scoped_lock lock{shard.mutex};
+
+    // Текст запроса нормализуется только при первом выполнении.
+    auto found = shard.queries.find(key);
+    if (found == shard.queries.end())
+    {
+        if (shard.queries.size() >= capacity_)
+        {
+            return;
+        }
+
+        found = shard.queries.emplace(key, Statistics::Query{}).first;
+        found->second.sql = Normalize(query);
+        found->second.params = params;
+    }
+
+    auto &statistics = found->second;
+    ++statistics.calls;
+    if (!result.Status())
+    {
+        ++statistics.errors;
+    }
+    if (slow)
+    {
+        ++statistics.slow;
+    }
+    statistics.rows += result.Affected();
+    statistics.bytes += result.Size();
+    statistics.max = std::max(statistics.max, elapsed);
+    AtomicHistogram::Record(statistics.latency, time);
+}
+
+//------------------------------------------------------------------------------
+vector<Statistics::Query> QueryStats::Queries() const noexcept
+{
+    vector<Statistics::Query> queries{};
+    for (const auto &shard : shards_)
+    {
+        const scoped_lock lock{shard.mutex};
+        for (const auto &[key, statistics] : shard.queries)
+        {
+            queries.push_back(statistics);
+        }
+    }
+
+    return queries;
+}
+
+//------------------------------------------------------------------------------
+void QueryStats::Reset() noexcept
+{
+    for (auto &shard : shards_)
+    {
+        const scoped_lock lock{shard.mutex};
+        shard.queries.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+string QueryStats::Normalize(string_view query)
+{
+    string sql{};
+    sql.reserve(query.size());
+    pg::Normalize(query, [&sql](char symbol) { sql.push_back(symbol); });
+
+    return sql;
+}
+
+//------------------------------------------------------------------------------
+QueryStats::QueryStats() noexcept
+: enabled_(ConfigGlobal::Instance().Get<bool>("database.statistics.enable",
+                                              false))
+, slow_(duration_cast<microseconds>(duration<double>(
+      ConfigGlobal::Instance().Get<double>("database.statistics.slow", 0))))
+{
+    const auto max =
+        ConfigGlobal::Instance().Get<size_t>("database.statistics.max", 1000);
+    capacity_ = max / shards_.size() + 1;
+}
+
+//------------------------------------------------------------------------------
+QueryStats::~QueryStats() noexcept = default;
+
+}  // namespace tasp::db::pg
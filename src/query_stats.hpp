@@ -0,0 +1,152 @@
+/**
+ * @file
+ * @brief Сбор статистики выполнения запросов к СУБД PostgreSQL.
+ */
+#ifndef TASP_QUERY_STATS_HPP_
+#define TASP_QUERY_STATS_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <tasp/db/pg/statistics.hpp>
+
+#include "result_impl.hpp"
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Сбор статистики выполнения запросов и журнал медленных запросов.
+ *
+ * Статистика хранится в нескольких независимых разделах с отдельными
+ * мьютексами, раздел выбирается по ключу запроса, поэтому параллельные
+ * запросы из разных потоков редко ожидают друг друга. Ключом служит хеш
+ * нормализованного текста, вычисляемый без построения строки, или хеш
+ * запроса, разобранного во время компиляции. Текст нормализуется только при
+ * первом выполнении запроса и для журнала медленных запросов.
+ *
+ * По умолчанию сбор статистики и журнал медленных запросов выключены, и
+ * время выполнения запросов не замеряется.
+ */
+class QueryStats final
+{
+public:
+    /**
+     * @brief Запрос ссылки на глобальную статистику.
+     *
+     * @return Ссылка на статистику
+     */
+    static QueryStats &Instance() noexcept;
+
+    /**
+     * @brief Проверка необходимости замера времени выполнения запросов.
+     *
+     * @return Сбор статистики или журнал медленных запросов включен
+     */
+    [[nodiscard]] bool Enabled() const noexcept;
+
+    /**
+     * @brief Учет выполненного запроса.
+     *
+     * @param query SQL-запрос
+     * @param key Ключ запроса, QueryText::hash для запроса, разобранного во
+     * время компиляции, 0 - вычислить по нормализованному тексту
+     * @param params Количество параметров запроса
+     * @param time Время выполнения
+     * @param result Результат выполнения запроса
+     */
+    void Record(std::string_view query,
+                uint64_t key,
+                size_t params,
+                std::chrono::steady_clock::duration time,
+                const ResultImpl &result) noexcept;
+
+    /**
+     * @brief Запрос статистики всех выполнявшихся запросов.
+     *
+     * @return Статистика запросов
+     */
+    [[nodiscard]] std::vector<Statistics::Query> Queries() const noexcept;
+
+    /**
+     * @brief Сброс накопленной статистики.
+     */
+    void Reset() noexcept;
+
+    /**
+     * @brief Нормализация текста запроса.
+     *
+     * Строковые (в том числе E'...' и $tag$...$tag$) и числовые константы
+     * заменяются на ?, последовательности пробельных символов и комментарии
+     * - на один пробел. Параметры вида $n и идентификаторы в двойных
+     * кавычках не изменяются.
+     *
+     * @param query SQL-запрос
+     *
+     * @return Нормализованный текст запроса
+     */
+    [[nodiscard]] static std::string Normalize(std::string_view query);
+
+    QueryStats(const QueryStats &) = delete;
+    QueryStats(QueryStats &&) = delete;
+    QueryStats &operator=(const QueryStats &) = delete;
+    QueryStats &operator=(QueryStats &&) = delete;
+
+private:
+    /**
+     * @brief Раздел статистики.
+     */
+    struct Shard
+    {
+        /**
+         * @brief Мьютекс для синхронизации доступа к разделу.
+         */
+        mutable std::mutex mutex;
+
+        /**
+         * @brief Статистика запросов по ключу запроса.
+         */
+        std::unordered_map<uint64_t, Statistics::Query> queries;
+    };
+
+    /**
+     * @brief Конструктор.
+     */
+    QueryStats() noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~QueryStats() noexcept;
+
+    /**
+     * @brief Сбор статистики включен.
+     */
+    bool enabled_;
+
+    /**
+     * @brief Порог времени выполнения медленного запроса, 0 - не записывать
+     * медленные запросы в журнал.
+     */
+    std::chrono::microseconds slow_;
+
+    /**
+     * @brief Максимальное количество запросов в одном разделе.
+     */
+    size_t capacity_{0};
+
+    /**
+     * @brief Разделы статистики.
+     */
+    std::array<Shard, 16> shards_{};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_QUERY_STATS_HPP_
@@ -0,0 +1,339 @@
+#include "reactor.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <tasp/logging.hpp>
+
+using std::make_shared;
+using std::scoped_lock;
+using std::shared_ptr;
+using std::vector;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Максимальное количество событий за один вызов epoll_wait.
+ */
+static constexpr size_t max_events{64};
+
+/**
+ * @brief Упаковка дескриптора и номера его регистрации в данные события
+ * epoll.
+ *
+ * @param descriptor Файловый дескриптор
+ * @param generation Номер регистрации
+ *
+ * @return Данные события
+ */
+static constexpr uint64_t Pack(int descriptor, uint32_t generation) noexcept
+{
+    return (uint64_t{generation} << 32U) | static_cast<uint32_t>(descriptor);
+}
+
+/*------------------------------------------------------------------------------
+    Reactor
+------------------------------------------------------------------------------*/
+Reactor &Reactor::Instance() noexcept
+{
+    static Reactor instance{};
+    return instance;
+}
+
+//------------------------------------------------------------------------------
+Reactor::Reactor() noexcept
+: epoll_(epoll_create1(EPOLL_CLOEXEC))
+, wakeup_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+, timer_(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK))
+{
+    if (epoll_ < 0 || wakeup_ < 0 || timer_ < 0)
+    {
+        Logging::Error("Ошибка создания цикла обработки событий: {}",
+                       std::strerror(errno));
+        return;
+    }
+
+    for (const auto descriptor : {wakeup_, timer_})
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = Pack(descriptor, 0);
+        if (epoll_ctl(epoll_, EPOLL_CTL_ADD, descriptor, &event) != 0)
+        {
+            Logging::Error("Ошибка создания цикла обработки событий: {}",
+                           std::strerror(errno));
+            return;
+        }
+    }
+
+    thread_ = std::thread{&Reactor::Run, this};
+}
+
+//------------------------------------------------------------------------------
+Reactor::~Reactor() noexcept
+{
+    stop_ = true;
+
+    if (thread_.joinable())
+    {
+        const uint64_t value{1};
+        [[maybe_unused]] const auto written =
+            write(wakeup_, &value, sizeof(value));
+        thread_.join();
+    }
+
+    if (timer_ >= 0)
+    {
+        close(timer_);
+    }
+
+    if (wakeup_ >= 0)
+    {
+        close(wakeup_);
+    }
+
+    if (epoll_ >= 0)
+    {
+        close(epoll_);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Reactor::Watch(int descriptor, uint32_t events, Handler handler) noexcept
+{
+    const scoped_lock lock{mutex_};
+
+    const auto generation = generation_;
+    generation_ = generation_ == UINT32_MAX ? 1 : generation_ + 1;
+
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = Pack(descriptor, generation);
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, descriptor, &event) != 0)
+    {
+        Logging::Error("Ошибка регистрации дескриптора {}: {}",
+                       descriptor,
+                       std::strerror(errno));
+        return false;
+    }
+
+    handlers_[descriptor] = {generation,
+                             make_shared<Handler>(std::move(handler))};
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool Reactor::Modify(int descriptor, uint32_t events) noexcept
+{
+    const scoped_lock lock{mutex_};
+
+    const auto found = handlers_.find(descriptor);
+    if (found == handlers_.end())
+    {
+        Logging::Error("Дескриптор {} не зарегистрирован", descriptor);
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = Pack(descriptor, found->second.generation);
+    if (epoll_ctl(epoll_, EPOLL_CTL_MOD, descriptor, &event) != 0)
+    {
+        Logging::Error("Ошибка изменения событий дескриптора {}: {}",
+                       descriptor,
+                       std::strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void Reactor::Remove(int descriptor) noexcept
+{
+    shared_ptr<Handler> handler{};
+    {
+        const scoped_lock lock{mutex_};
+
+        epoll_ctl(epoll_, EPOLL_CTL_DEL, descriptor, nullptr);
+
+        const auto found = handlers_.find(descriptor);
+        if (found != handlers_.end())
+        {
+            // Обработчик удаляется вне блокировки, т.к. его удаление может
+            // освобождать объекты, которые сами обращаются к циклу.
+            handler = std::move(found->second.handler);
+            handlers_.erase(found);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+uint64_t Reactor::After(std::chrono::nanoseconds delay, Task task) noexcept
+{
+    if (timer_ < 0)
+    {
+        Logging::Error("Ошибка создания таймера: цикл не запущен");
+        return 0;
+    }
+
+    const auto deadline = steady_clock::now() + delay;
+
+    const scoped_lock lock{mutex_};
+
+    const auto id = next_timer_++;
+    const auto timer =
+        timers_.emplace(Deadline{deadline, id}, std::move(task)).first;
+    deadlines_.emplace(id, deadline);
+
+    // timerfd перевзводится, только если новый таймер стал ближайшим.
+    if (timer == timers_.begin())
+    {
+        Arm();
+    }
+
+    return id;
+}
+
+//------------------------------------------------------------------------------
+void Reactor::Cancel(uint64_t timer) noexcept
+{
+    Task task{};
+    {
+        const scoped_lock lock{mutex_};
+
+        const auto deadline = deadlines_.find(timer);
+        if (deadline == deadlines_.end())
+        {
+            return;
+        }
+
+        // Задача удаляется вне блокировки, т.к. ее удаление может освобождать
+        // объекты, которые сами обращаются к циклу.
+        const auto found = timers_.find({deadline->second, timer});
+        task = std::move(found->second);
+        timers_.erase(found);
+        deadlines_.erase(deadline);
+    }
+}
+
+//------------------------------------------------------------------------------
+void Reactor::Expire() noexcept
+{
+    uint64_t expirations{0};
+    [[maybe_unused]] const auto read_bytes =
+        read(timer_, &expirations, sizeof(expirations));
+
+    vector<Task> tasks{};
+    {
+        const scoped_lock lock{mutex_};
+
+        const auto now = steady_clock::now();
+        while (!timers_.empty() && timers_.begin()->first.first <= now)
+        {
+            const auto timer = timers_.begin();
+            deadlines_.erase(timer->first.second);
+            tasks.push_back(std::move(timer->second));
+            timers_.erase(timer);
+        }
+
+        Arm();
+    }
+
+    for (const auto &task : tasks)
+    {
+        task();
+    }
+}
+
+//------------------------------------------------------------------------------
+void Reactor::Arm() noexcept
+{
+    if (timers_.empty())
+    {
+        return;
+    }
+
+    // Срок задается абсолютным временем CLOCK_MONOTONIC (steady_clock).
+    // Нулевое значение выключает таймер, поэтому срок не меньше 1 нс.
+    const auto deadline = std::max<int64_t>(
+        duration_cast<nanoseconds>(
+            timers_.begin()->first.first.time_since_epoch())
+            .count(),
+        1);
+
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000);
+    spec.it_value.tv_nsec = static_cast<long>(deadline % 1000000000);
+    if (timerfd_settime(timer_, TFD_TIMER_ABSTIME, &spec, nullptr) != 0)
+    {
+        Logging::Error("Ошибка установки таймера: {}", std::strerror(errno));
+    }
+}
+
+//------------------------------------------------------------------------------
+void Reactor::Run() noexcept
+{
+    std::array<epoll_event, max_events> events{};
+
+    while (!stop_)
+    {
+        const auto count = epoll_wait(
+            epoll_, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            Logging::Error("Ошибка ожидания событий: {}", std::strerror(errno));
+            return;
+        }
+
+        for (size_t index = 0; index < static_cast<size_t>(count); ++index)
+        {
+            const auto data = events[index].data.u64;
+            const auto descriptor = static_cast<int>(data & UINT32_MAX);
+            const auto generation = static_cast<uint32_t>(data >> 32U);
+            if (generation == 0)
+            {
+                if (descriptor == timer_)
+                {
+                    Expire();
+                }
+                continue;
+            }
+
+            // Событие удаленного дескриптора, номер которого уже занят
+            // новой регистрацией, пропускается.
+            shared_ptr<Handler> handler{};
+            {
+                const scoped_lock lock{mutex_};
+                const auto found = handlers_.find(descriptor);
+                if (found == handlers_.end() ||
+                    found->second.generation != generation)
+                {
+                    continue;
+                }
+                handler = found->second.handler;
+            }
+
+            (*handler)(events[index].events);
+        }
+    }
+}
+
+}  // namespace tasp::db::pg
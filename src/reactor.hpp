@@ -0,0 +1,224 @@
+/**
+ * @file
+ * @brief Цикл обработки событий файловых дескрипторов для асинхронного
+ * выполнения запросов.
+ */
+#ifndef TASP_REACTOR_HPP_
+#define TASP_REACTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Цикл обработки событий на основе epoll.
+ *
+ * Владеет одним потоком, в котором вызываются обработчики событий
+ * зарегистрированных файловых дескрипторов. Обработчики не должны
+ * блокироваться, т.к. задерживают обработку событий остальных дескрипторов.
+ * Регистрация и удаление дескрипторов допускаются из любого потока, в том
+ * числе из обработчика.
+ *
+ * Все таймеры обслуживаются одним дескриптором timerfd, который взводится
+ * на ближайший срок.
+ */
+class Reactor final
+{
+public:
+    /**
+     * @brief Обработчик событий дескриптора, принимает маску событий epoll.
+     */
+    using Handler = std::function<void(uint32_t)>;
+
+    /**
+     * @brief Отложенная задача.
+     */
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Запрос ссылки на глобальный цикл обработки событий.
+     *
+     * Поток обработки событий запускается при первом вызове.
+     *
+     * @return Ссылка на цикл обработки событий
+     */
+    static Reactor &Instance() noexcept;
+
+    /**
+     * @brief Регистрация дескриптора.
+     *
+     * @param descriptor Файловый дескриптор
+     * @param events Маска ожидаемых событий epoll (EPOLLIN, EPOLLOUT)
+     * @param handler Обработчик событий
+     *
+     * @return Результат регистрации
+     */
+    [[nodiscard]] bool Watch(int descriptor,
+                             uint32_t events,
+                             Handler handler) noexcept;
+
+    /**
+     * @brief Изменение маски ожидаемых событий дескриптора.
+     *
+     * @param descriptor Файловый дескриптор
+     * @param events Маска ожидаемых событий epoll
+     *
+     * @return Результат изменения
+     */
+    bool Modify(int descriptor, uint32_t events) noexcept;
+
+    /**
+     * @brief Удаление дескриптора.
+     *
+     * После возврата обработчик дескриптора больше не вызывается, кроме уже
+     * выполняющегося вызова.
+     *
+     * @param descriptor Файловый дескриптор
+     */
+    void Remove(int descriptor) noexcept;
+
+    /**
+     * @brief Выполнение задачи в потоке цикла через заданное время.
+     *
+     * @param delay Задержка
+     * @param task Задача
+     *
+     * @return Идентификатор таймера для Cancel, 0 - ошибка регистрации
+     */
+    uint64_t After(std::chrono::nanoseconds delay, Task task) noexcept;
+
+    /**
+     * @brief Отмена таймера.
+     *
+     * Задача удаляется без вызова. Отмена сработавшего или уже отмененного
+     * таймера ничего не делает.
+     *
+     * @param timer Идентификатор таймера
+     */
+    void Cancel(uint64_t timer) noexcept;
+
+    Reactor(const Reactor &) = delete;
+    Reactor(Reactor &&) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+    Reactor &operator=(Reactor &&) = delete;
+
+private:
+    /**
+     * @brief Зарегистрированный дескриптор.
+     */
+    struct Registration
+    {
+        uint32_t generation;              /*!< Номер регистрации */
+        std::shared_ptr<Handler> handler; /*!< Обработчик событий */
+    };
+
+    /**
+     * @brief Срок таймера и его идентификатор.
+     */
+    using Deadline =
+        std::pair<std::chrono::steady_clock::time_point, uint64_t>;
+
+    /**
+     * @brief Конструктор.
+     */
+    Reactor() noexcept;
+
+    /**
+     * @brief Деструктор.
+     *
+     * Останавливает поток обработки событий.
+     */
+    ~Reactor() noexcept;
+
+    /**
+     * @brief Цикл обработки событий.
+     */
+    void Run() noexcept;
+
+    /**
+     * @brief Выполнение задач сработавших таймеров.
+     */
+    void Expire() noexcept;
+
+    /**
+     * @brief Взведение timerfd на срок ближайшего таймера.
+     *
+     * Вызывается с заблокированным мьютексом.
+     */
+    void Arm() noexcept;
+
+    /**
+     * @brief Дескриптор epoll.
+     */
+    int epoll_{-1};
+
+    /**
+     * @brief Дескриптор eventfd для пробуждения потока при остановке.
+     */
+    int wakeup_{-1};
+
+    /**
+     * @brief Дескриптор timerfd для всех таймеров.
+     */
+    int timer_{-1};
+
+    /**
+     * @brief Признак остановки потока.
+     */
+    std::atomic<bool> stop_{false};
+
+    /**
+     * @brief Обработчики событий зарегистрированных дескрипторов.
+     *
+     * Номер регистрации передается в epoll вместе с дескриптором: событие,
+     * полученное до удаления дескриптора, не передается обработчику нового
+     * сокета с тем же номером дескриптора.
+     */
+    std::unordered_map<int, Registration> handlers_{};
+
+    /**
+     * @brief Номер следующей регистрации дескриптора, 0 - служебные
+     * дескрипторы цикла.
+     */
+    uint32_t generation_{1};
+
+    /**
+     * @brief Задачи таймеров в порядке срока.
+     */
+    std::map<Deadline, Task> timers_{};
+
+    /**
+     * @brief Сроки таймеров по идентификатору.
+     */
+    std::unordered_map<uint64_t, std::chrono::steady_clock::time_point>
+        deadlines_{};
+
+    /**
+     * @brief Идентификатор следующего таймера.
+     */
+    uint64_t next_timer_{1};
+
+    /**
+     * @brief Мьютекс для синхронизации доступа к обработчикам и таймерам.
+     */
+    std::mutex mutex_{};
+
+    /**
+     * @brief Поток обработки событий.
+     */
+    std::thread thread_{};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_REACTOR_HPP_
@@ -1,7 +1,11 @@
 #include "tasp/db/pg/result.hpp"
 
+#include <ostream>
+
+#include "json_writer.hpp"
 #include "result_impl.hpp"
 
+using std::optional;
 using std::string;
 using std::string_view;
 using std::unique_ptr;
@@ -10,7 +14,7 @@ namespace tasp::db::pg
 {
 
 /*------------------------------------------------------------------------------
-    Result::Iterator
+    Result
 ------------------------------------------------------------------------------*/
 Result::Result(unique_ptr<ResultImpl> impl) noexcept
 : impl_(std::move(impl))
@@ -26,12 +30,78 @@ bool Result::Status() const noexcept
     return impl_->Status();
 }
 
+//------------------------------------------------------------------------------
+Result::Field Result::Find(string_view name) const noexcept
+{
+    return Field{impl_->Column(name)};
+}
+
 //------------------------------------------------------------------------------
 string Result::Value(string_view name) const noexcept
 {
     return impl_->Value(0, name);
 }
 
+//------------------------------------------------------------------------------
+bool Result::IsNull(string_view name) const noexcept
+{
+    const auto column = impl_->Column(name);
+    return column == -1 || impl_->IsNull(0, column);
+}
+
+//------------------------------------------------------------------------------
+string Result::Value(Field field) const noexcept
+{
+    return field.Valid() ? impl_->Value(0, field.Index()) : string{};
+}
+
+//------------------------------------------------------------------------------
+bool Result::IsNull(Field field) const noexcept
+{
+    return !field.Valid() || impl_->IsNull(0, field.Index());
+}
+
+//------------------------------------------------------------------------------
+int Result::Rows() const noexcept
+{
+    return impl_->Rows();
+}
+
+//------------------------------------------------------------------------------
+int Result::Columns() const noexcept
+{
+    return impl_->Columns();
+}
+
+//------------------------------------------------------------------------------
+Result::Row Result::operator[](int row) const noexcept
+{
+    return {impl_.get(), row};
+}
+
+//------------------------------------------------------------------------------
+template<typename Type>
+Type Result::Decode(const ResultImpl *result,
+                    int row,
+                    string_view name) noexcept
+{
+    return result->Get<Type>(row, name);
+}
+
+//------------------------------------------------------------------------------
+template<typename Type>
+Type Result::Decode(const ResultImpl *result, int row, int column) noexcept
+{
+    return result->Get<Type>(row, column);
+}
+
+//------------------------------------------------------------------------------
+template<typename Type>
+ColumnValues<Type> Result::Values(int column) const noexcept
+{
+    return impl_->Values<Type>(column);
+}
+
 //------------------------------------------------------------------------------
 Json::Value Result::JsonValue() const noexcept
 {
@@ -39,54 +109,97 @@ Json::Value Result::JsonValue() const noexcept
 }
 
 //------------------------------------------------------------------------------
-Result::Iterator Result::begin() const
+void Result::WriteJson(string &buffer, JsonShape shape) const noexcept
 {
-    return Iterator(impl_->begin());
+    JsonWriter{*impl_, buffer}.Write(shape);
 }
 
 //------------------------------------------------------------------------------
-Result::Iterator Result::end() const
+void Result::WriteJson(std::ostream &stream, JsonShape shape) const noexcept
 {
-    return Iterator(impl_->end());
+    string buffer{};
+    JsonWriter{*impl_, buffer, &stream}.Write(shape);
 }
 
-/*------------------------------------------------------------------------------
-    Result
-------------------------------------------------------------------------------*/
-Result::Iterator::Iterator(unique_ptr<ResultIteratorImpl> impl) noexcept
-: impl_(std::move(impl))
+//------------------------------------------------------------------------------
+Result::Iterator Result::begin() const noexcept
 {
+    return {impl_.get(), 0};
 }
 
 //------------------------------------------------------------------------------
-Result::Iterator::~Iterator()
+Result::Iterator Result::end() const noexcept
 {
-    impl_.reset(nullptr);
+    return {impl_.get(), impl_->Rows()};
 }
 
-//------------------------------------------------------------------------------
-string Result::Iterator::Value(string_view name) const noexcept
+/*------------------------------------------------------------------------------
+    Result::Row
+------------------------------------------------------------------------------*/
+string Result::Row::Value(string_view name) const noexcept
 {
-    return impl_->Value(name);
+    return result_->Value(row_, name);
 }
 
 //------------------------------------------------------------------------------
-Result::Iterator &Result::Iterator::operator++() noexcept
+bool Result::Row::IsNull(string_view name) const noexcept
 {
-    impl_->operator++();
-    return *this;
+    const auto column = result_->Column(name);
+    return column == -1 || result_->IsNull(row_, column);
 }
 
 //------------------------------------------------------------------------------
-bool Result::Iterator::operator!=(const Result::Iterator &rhs) noexcept
+string Result::Row::Value(Result::Field field) const noexcept
 {
-    return impl_->operator!=(*rhs.impl_);
+    return field.Valid() ? result_->Value(row_, field.Index()) : string{};
 }
 
 //------------------------------------------------------------------------------
-const Result::Iterator &Result::Iterator::operator*() const noexcept
+bool Result::Row::IsNull(Result::Field field) const noexcept
 {
-    return *this;
+    return !field.Valid() || result_->IsNull(row_, field.Index());
 }
 
+/*------------------------------------------------------------------------------
+    Поддерживаемые типы значений
+------------------------------------------------------------------------------*/
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define TASP_RESULT_GET(Type)                                                  \
+    template Type Result::Decode<Type>(const ResultImpl *, int, string_view)   \
+        noexcept;                                                              \
+    template optional<Type> Result::Decode<optional<Type>>(                    \
+        const ResultImpl *, int, string_view) noexcept;                        \
+    template Type Result::Decode<Type>(const ResultImpl *, int, int) noexcept; \
+    template optional<Type> Result::Decode<optional<Type>>(                    \
+        const ResultImpl *, int, int) noexcept;
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+TASP_RESULT_GET(bool)
+TASP_RESULT_GET(int16_t)
+TASP_RESULT_GET(int32_t)
+TASP_RESULT_GET(int64_t)
+TASP_RESULT_GET(float)
+TASP_RESULT_GET(double)
+TASP_RESULT_GET(string)
+TASP_RESULT_GET(string_view)
+TASP_RESULT_GET(Timestamp)
+TASP_RESULT_GET(Uuid)
+
+#undef TASP_RESULT_GET
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define TASP_RESULT_COLUMN(Type)                                               \
+    template ColumnValues<Type> Result::Values<Type>(int) const noexcept;
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+TASP_RESULT_COLUMN(bool)
+TASP_RESULT_COLUMN(int16_t)
+TASP_RESULT_COLUMN(int32_t)
+TASP_RESULT_COLUMN(int64_t)
+TASP_RESULT_COLUMN(float)
+TASP_RESULT_COLUMN(double)
+TASP_RESULT_COLUMN(Timestamp)
+
+#undef TASP_RESULT_COLUMN
+
 }  // namespace tasp::db::pg
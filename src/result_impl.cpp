@@ -1,13 +1,16 @@
 #include "result_impl.hpp"
 
+#include <cstdlib>
 #include <string>
+#include <vector>
 
 #include <tasp/logging.hpp>
 
-using std::make_unique;
+#include "json_type.hpp"
+
 using std::string;
 using std::string_view;
-using std::unique_ptr;
+using std::vector;
 
 namespace tasp::db::pg
 {
@@ -23,6 +26,15 @@ ResultImpl::ResultImpl(PGresult *result) noexcept
         return;
     }
 
+#if defined(LIBPQ_HAS_PIPELINING)
+    if (PQresultStatus(result) == PGRES_PIPELINE_ABORTED)
+    {
+        Logging::Warning("Запрос не выполнен из-за ошибки в предыдущем запросе "
+                         "пакета");
+        return;
+    }
+#endif
+
     if (!Status())
     {
         Logging::Error("Ошибка выполнения запроса: {}",
@@ -36,8 +48,18 @@ ResultImpl::~ResultImpl() noexcept = default;
 //------------------------------------------------------------------------------
 bool ResultImpl::Status() const noexcept
 {
-    return (PQresultStatus(result_.get()) == PGRES_TUPLES_OK) ||
-           (PQresultStatus(result_.get()) == PGRES_COMMAND_OK);
+    switch (PQresultStatus(result_.get()))
+    {
+        case PGRES_TUPLES_OK:
+        case PGRES_COMMAND_OK:
+        case PGRES_SINGLE_TUPLE:
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+        case PGRES_TUPLES_CHUNK:
+#endif
+            return true;
+        default:
+            return false;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -53,136 +75,157 @@ int ResultImpl::Columns() const noexcept
 }
 
 //------------------------------------------------------------------------------
-string ResultImpl::Value(int row, int column) const noexcept
+uint64_t ResultImpl::Affected() const noexcept
 {
-    if (row >= Rows())
+    if (PQnfields(result_.get()) > 0)
     {
-        Logging::Error("Запрашивается строка: {} всего строк: {}", row, Rows());
+        return static_cast<uint64_t>(PQntuples(result_.get()));
     }
 
-    return PQgetvalue(result_.get(), row, column);
+    return std::strtoull(PQcmdTuples(result_.get()), nullptr, 10);
 }
 
 //------------------------------------------------------------------------------
-string ResultImpl::Value(int row, string_view name) const noexcept
+size_t ResultImpl::Size() const noexcept
 {
-    const int column = PQfnumber(result_.get(), name.data());
-    if (column == -1)
-    {
-        Logging::Error("Отсутствует колонка: {}", name);
-        return "";
-    }
-
-    return Value(row, column);
+    return PQresultMemorySize(result_.get());
 }
 
 //------------------------------------------------------------------------------
-Json::Value ResultImpl::ValueArray(int row, int column) const noexcept
+string_view ResultImpl::Error() const noexcept
 {
-    auto array = Value(row, column);
-
-    Json::Value root;
+    if (Status())
+    {
+        return {};
+    }
 
-    size_t current{1};
-    size_t sep{0};
-    while ((sep = array.find_first_of(",}", current)) != string::npos)
+    const string_view message{PQresultErrorMessage(result_.get())};
+    if (message.empty())
     {
-        auto value = array.substr(current, sep - current);
-        root.append(value);
-        current = sep + 1;
+        return "Нет результата выполнения запроса";
     }
 
-    return root;
+    return message;
 }
 
 //------------------------------------------------------------------------------
-Json::Value ResultImpl::ValueBoolean(int row, int column) const noexcept
+const PGresult *ResultImpl::Native() const noexcept
 {
-    return Value(row, column) == "t";
+    return result_.get();
 }
 
 //------------------------------------------------------------------------------
-Json::Value ResultImpl::ValueInt(int row, int column) const noexcept
+string ResultImpl::Value(int row, int column) const noexcept
 {
-    return std::stoi(Value(row, column));
+    if (row >= Rows())
+    {
+        Logging::Error("Запрашивается строка: {} всего строк: {}", row, Rows());
+    }
+
+    return Cell{result_.get(), row, column}.Text();
 }
 
 //------------------------------------------------------------------------------
-Json::Value ResultImpl::ConvertValue(int row, int column) const noexcept
+string ResultImpl::Value(int row, string_view name) const noexcept
 {
-    switch (PQftype(result_.get(), column))
+    const int column = Column(name);
+    if (column == -1)
     {
-        case 16:
-            return ValueBoolean(row, column);
-        case 21:
-            return ValueInt(row, column);
-        case 1009:
-            return ValueArray(row, column);
-        default:
-            return Value(row, column);
+        return "";
     }
+
+    return Value(row, column);
 }
 
 //------------------------------------------------------------------------------
-Json::Value ResultImpl::JsonValue() const noexcept
+int ResultImpl::Column(string_view name) const noexcept
 {
-    Json::Value root;
-    root["count"] = Rows();
-    root["data"] = Json::arrayValue;
-
-    for (auto row = 0; row < Rows(); ++row)
+    // Для небольших результатов и порций потока из одной строки построение
+    // таблицы дороже, чем просмотр имен столбцов.
+    if (Rows() <= 1 || Columns() <= indexed_columns)
     {
-        Json::Value tuple;
         for (auto column = 0; column < Columns(); ++column)
         {
-            auto *key = PQfname(result_.get(), column);
-            tuple[key] = ConvertValue(row, column);
+            if (name == PQfname(result_.get(), column))
+            {
+                return column;
+            }
+        }
+    }
+    else
+    {
+        std::call_once(
+            columns_flag_,
+            [this]()
+            {
+                columns_.reserve(static_cast<size_t>(Columns()));
+                for (auto column = 0; column < Columns(); ++column)
+                {
+                    columns_.try_emplace(PQfname(result_.get(), column),
+                                         column);
+                }
+            });
+
+        if (const auto found = columns_.find(name); found != columns_.cend())
+        {
+            return found->second;
         }
-        root["data"].append(tuple);
     }
 
-    return root;
+    const int column = PQfnumber(result_.get(), string{name}.c_str());
+    if (column == -1)
+    {
+        Logging::Error("Отсутствует колонка: {}", name);
+    }
+
+    return column;
 }
 
 //------------------------------------------------------------------------------
-unique_ptr<ResultIteratorImpl> ResultImpl::begin() const
+bool ResultImpl::IsNull(int row, int column) const noexcept
 {
-    return make_unique<ResultIteratorImpl>(this);
+    return PQgetisnull(result_.get(), row, column) != 0;
 }
 
 //------------------------------------------------------------------------------
-unique_ptr<ResultIteratorImpl> ResultImpl::end() const
+Json::Value ResultImpl::JsonValue() const noexcept
 {
-    return make_unique<ResultIteratorImpl>(this, Rows());
-}
+    const auto rows = Rows();
+    const auto columns = Columns();
 
-/*------------------------------------------------------------------------------
-    ResultIteratorImpl
-------------------------------------------------------------------------------*/
-ResultIteratorImpl::ResultIteratorImpl(const ResultImpl *result,
-                                       int row) noexcept
-: result_(result)
-, row_(row)
-{
-}
+    vector<JsonType> types{};
+    vector<const char *> names{};
+    types.reserve(static_cast<size_t>(columns));
+    names.reserve(static_cast<size_t>(columns));
+    for (auto column = 0; column < columns; ++column)
+    {
+        types.push_back(JsonType::Of(PQftype(result_.get(), column)));
+        names.emplace_back(PQfname(result_.get(), column));
+    }
 
-//------------------------------------------------------------------------------
-string ResultIteratorImpl::Value(string_view name) const noexcept
-{
-    return result_->Value(row_, name);
-}
+    Json::Value root;
+    root["count"] = rows;
+    auto &data = root["data"] = Json::arrayValue;
 
-//------------------------------------------------------------------------------
-ResultIteratorImpl &ResultIteratorImpl::operator++() noexcept
-{
-    row_++;
-    return *this;
-}
+    string scratch{};
+    for (auto row = 0; row < rows; ++row)
+    {
+        auto &tuple = data.append(Json::objectValue);
+        for (auto column = 0; column < columns; ++column)
+        {
+            const auto index = static_cast<size_t>(column);
+            if (IsNull(row, column))
+            {
+                tuple[names[index]] = Json::nullValue;
+                continue;
+            }
+
+            tuple[names[index]] = types[index].Value(
+                JsonType::Text(result_.get(), row, column, scratch));
+        }
+    }
 
-//------------------------------------------------------------------------------
-bool ResultIteratorImpl::operator!=(const ResultIteratorImpl &rhs) noexcept
-{
-    return (rhs.row_ != row_) || (rhs.result_ != result_);
+    return root;
 }
 
 }  // namespace tasp::db::pg
@@ -9,14 +9,22 @@
 #include <jsoncpp/json/json.h>
 #include <postgresql/libpq-fe.h>
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include <tasp/db/pg/params.hpp>
+#include <tasp/logging.hpp>
+
+#include "cell.hpp"
 
 namespace tasp::db::pg
 {
 
-class ResultIteratorImpl;
-
 /**
  * @brief Реализация интерфейса для работы с результатом запроса к СУБД
  * PostgreSQL.
@@ -57,6 +65,36 @@ public:
      */
     [[nodiscard]] int Columns() const noexcept;
 
+    /**
+     * @brief Запрос количества обработанных строк: строк результата или
+     * строк, измененных командой (INSERT, UPDATE, DELETE, ...).
+     *
+     * @return Количество строк
+     */
+    [[nodiscard]] uint64_t Affected() const noexcept;
+
+    /**
+     * @brief Запрос объема памяти, занимаемого результатом.
+     *
+     * @return Объем памяти в байтах
+     */
+    [[nodiscard]] size_t Size() const noexcept;
+
+    /**
+     * @brief Запрос сообщения об ошибке выполнения запроса.
+     *
+     * @return Сообщение об ошибке, пустое при успешном выполнении
+     */
+    [[nodiscard]] std::string_view Error() const noexcept;
+
+    /**
+     * @brief Запрос указателя на результат выполнения запроса библиотеки
+     * libpq.
+     *
+     * @return Указатель на результат
+     */
+    [[nodiscard]] const PGresult *Native() const noexcept;
+
     /**
      * @brief Запрос значения ячейки таблицы по номеру столбца.
      *
@@ -102,62 +140,122 @@ public:
                                     std::string_view name) const noexcept;
 
     /**
-     * @brief Конвертирование типов PostgreSQL в тип Json.
+     * @brief Запрос номера столбца по имени.
      *
-     * @param row Номер строки
-     * @param column Номер столбца
+     * Если в результате больше одной строки и больше indexed_columns
+     * столбцов, поиск выполняется по таблице имен, построенной при первом
+     * поиске, иначе имена столбцов просматриваются по порядку. Если имя не
+     * найдено, используется PQfnumber, который учитывает регистр и кавычки в
+     * имени.
      *
-     * @return JSON значение.
+     * @param name Название столбца
+     *
+     * @return Номер столбца, -1 если столбец отсутствует
      */
-    [[nodiscard]] Json::Value ConvertValue(int row, int column) const noexcept;
+    [[nodiscard]] int Column(std::string_view name) const noexcept;
 
     /**
-     * @brief Конвертация массива формата PostgreSQL в массив JSON.
+     * @brief Проверка значения ячейки на NULL.
      *
      * @param row Номер строки
      * @param column Номер столбца
      *
-     * @return JSON-массив.
+     * @return Результат проверки
      */
-    [[nodiscard]] Json::Value ValueArray(int row, int column) const noexcept;
+    [[nodiscard]] bool IsNull(int row, int column) const noexcept;
 
     /**
-     * @brief Конвертация bool PostgreSQL в JSON.
+     * @brief Запрос значения ячейки с преобразованием в тип Type.
      *
      * @param row Номер строки
      * @param column Номер столбца
      *
-     * @return JSON значение.
+     * @return Значение. Для NULL и значений, которые нельзя преобразовать в
+     * тип Type, значение по умолчанию.
      */
-    [[nodiscard]] Json::Value ValueBoolean(int row, int column) const noexcept;
+    template<typename Type>
+    [[nodiscard]] Type Get(int row, int column) const noexcept
+    {
+        const Cell cell{result_.get(), row, column};
+
+        if constexpr (IsOptional<Type>::value)
+        {
+            if (cell.IsNull())
+            {
+                return std::nullopt;
+            }
+
+            typename Type::value_type value{};
+            if (!cell.Get(value))
+            {
+                Logging::Error(
+                    "Ошибка преобразования значения строки {} колонки {}",
+                    row,
+                    column);
+                return std::nullopt;
+            }
+
+            return value;
+        }
+        else
+        {
+            Type value{};
+            if (!cell.IsNull() && !cell.Get(value))
+            {
+                Logging::Error(
+                    "Ошибка преобразования значения строки {} колонки {}",
+                    row,
+                    column);
+                return Type{};
+            }
+
+            return value;
+        }
+    }
 
     /**
-     * @brief Конвертация чисел PostgreSQL в JSON.
+     * @brief Запрос всех значений столбца с преобразованием в тип Type.
      *
-     * @param row Номер строки
      * @param column Номер столбца
      *
-     * @return JSON значение.
+     * @return Значения столбца
      */
-    [[nodiscard]] Json::Value ValueInt(int row, int column) const noexcept;
+    template<typename Type>
+    [[nodiscard]] ColumnValues<Type> Values(int column) const noexcept
+    {
+        ColumnValues<Type> values{};
+        const auto failed = Cell::Column(result_.get(), column, values);
+        if (failed != 0)
+        {
+            Logging::Error("Ошибка преобразования {} значений колонки {}",
+                           failed,
+                           column);
+        }
 
-    // Выключается проверка стиля наименований для этого участка, т.к. это
-    // методы для использования в стандартной библиотеке c++.
-    // NOLINTBEGIN(readability-identifier-naming)
-    /**
-     * @brief Итератор на первую строку SQL-запроса.
-     *
-     * @return Итератор на первую строку.
-     */
-    [[nodiscard]] std::unique_ptr<ResultIteratorImpl> begin() const;
+        return values;
+    }
 
     /**
-     * @brief Итератор конца строк SQL-запроса.
+     * @brief Запрос значения ячейки по имени столбца с преобразованием в тип
+     * Type.
      *
-     * @return Итератор конца.
+     * @param row Номер строки
+     * @param name Название столбца
+     *
+     * @return Значение. Для NULL, отсутствующего столбца и значений, которые
+     * нельзя преобразовать в тип Type, значение по умолчанию.
      */
-    [[nodiscard]] std::unique_ptr<ResultIteratorImpl> end() const;
-    // NOLINTEND(readability-identifier-naming)
+    template<typename Type>
+    [[nodiscard]] Type Get(int row, std::string_view name) const noexcept
+    {
+        const auto column = Column(name);
+        if (column == -1)
+        {
+            return Type{};
+        }
+
+        return Get<Type>(row, column);
+    }
 
     ResultImpl(const ResultImpl &) = delete;
     ResultImpl(ResultImpl &&) = delete;
@@ -166,70 +264,28 @@ public:
 
 private:
     /**
-     * @brief Указатель на результат выполнения запроса к СУБД библиотеки libpq.
+     * @brief Количество столбцов, при превышении которого для поиска по имени
+     * строится таблица.
      */
-    std::unique_ptr<PGresult, decltype(&PQclear)> result_;
-};
+    static constexpr int indexed_columns{8};
 
-/**
- * @brief Реализация итератора для перебора строк результата SQL-команды.
- */
-class ResultIteratorImpl
-{
-public:
     /**
-     * @brief Конструктор.
-     *
-     * @param result Результат выполнения SQL-запроса
-     * @param row Указатель на реализацию
-     */
-    explicit ResultIteratorImpl(const ResultImpl *result, int row = 0) noexcept;
-
-    /**
-     * @brief Деструктор.
-     */
-    ~ResultIteratorImpl() noexcept = default;
-
-    /**
-     * @brief Запрос значения по имени столбца.
-     *
-     * @param name Название столбца.
-     *
-     * @return Значение. Пустую строку если значение отсутствует.
-     */
-    [[nodiscard]] std::string Value(std::string_view name) const noexcept;
-
-    /**
-     * @brief Переход на следующую строку.
-     *
-     * @return Ссылка на самого себя.
+     * @brief Указатель на результат выполнения запроса к СУБД библиотеки libpq.
      */
-    ResultIteratorImpl &operator++() noexcept;
+    std::unique_ptr<PGresult, decltype(&PQclear)> result_;
 
     /**
-     * @brief Сравнение текущего итератора с итератором переданным в параметрах.
+     * @brief Номера столбцов по именам.
      *
-     * @param rhs Итератор для сравнения
-     *
-     * @return Результат сравнения
-     */
-    [[nodiscard]] bool operator!=(const ResultIteratorImpl &rhs) noexcept;
-
-    ResultIteratorImpl(const ResultIteratorImpl &) = delete;
-    ResultIteratorImpl(ResultIteratorImpl &&) = delete;
-    ResultIteratorImpl &operator=(const ResultIteratorImpl &) = delete;
-    ResultIteratorImpl &operator=(ResultIteratorImpl &&) = delete;
-
-private:
-    /**
-     * @brief Результат выполнения SQL-запроса.
+     * Заполняется при первом поиске столбца по имени, если столбцов больше
+     * indexed_columns. Ключи ссылаются на имена столбцов внутри result_.
      */
-    const ResultImpl *result_;
+    mutable std::unordered_map<std::string_view, int> columns_{};
 
     /**
-     * @brief Номер строки в результате SQL-запроса.
+     * @brief Флаг однократного заполнения номеров столбцов.
      */
-    int row_;
+    mutable std::once_flag columns_flag_{};
 };
 
 }  // namespace tasp::db::pg
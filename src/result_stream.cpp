@@ -0,0 +1,40 @@
+#include "tasp/db/pg/result_stream.hpp"
+
+#include "result_stream_impl.hpp"
+
+using std::make_unique;
+using std::unique_ptr;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    ResultStream
+------------------------------------------------------------------------------*/
+ResultStream::ResultStream(unique_ptr<ResultStreamImpl> impl) noexcept
+: impl_(std::move(impl))
+{
+}
+
+//------------------------------------------------------------------------------
+ResultStream::~ResultStream() noexcept = default;
+
+//------------------------------------------------------------------------------
+bool ResultStream::Status() const noexcept
+{
+    return impl_->Status();
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<Result> ResultStream::Next() const noexcept
+{
+    auto result = impl_->Next();
+    if (!result)
+    {
+        return nullptr;
+    }
+
+    return make_unique<Result>(std::move(result));
+}
+
+}  // namespace tasp::db::pg
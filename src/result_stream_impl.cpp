@@ -0,0 +1,160 @@
+#include "result_stream_impl.hpp"
+
+#include <tasp/config.hpp>
+#include <tasp/logging.hpp>
+
+#include "connection_impl.hpp"
+#include "observers.hpp"
+
+using std::make_unique;
+using std::shared_ptr;
+using std::string_view;
+using std::unique_ptr;
+using std::vector;
+using std::chrono::steady_clock;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    ResultStreamImpl
+------------------------------------------------------------------------------*/
+ResultStreamImpl::ResultStreamImpl(shared_ptr<const ConnectionImpl> connection,
+                                   string_view query,
+                                   const Params &params,
+                                   Result::Format format) noexcept
+: connection_(std::move(connection))
+{
+    observed_ = Observers::Active();
+    if (observed_)
+    {
+        query_ = query;
+        arguments_ = params;
+        start_ = steady_clock::now();
+        Observers::Start({query_, arguments_, connection_.get()});
+    }
+
+    if (!connection_->Send(query, params, format))
+    {
+        error_ = PQerrorMessage(connection_->Native());
+        Notify();
+        return;
+    }
+
+    active_ = true;
+    status_ = true;
+
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+    static const auto chunk =
+        ConfigGlobal::Instance().Get<int>("database.stream.chunk", 1000);
+    const auto mode = PQsetChunkedRowsMode(connection_->Native(), chunk);
+#else
+    const auto mode = PQsetSingleRowMode(connection_->Native());
+#endif
+    if (mode != 1)
+    {
+        Logging::Warning("Не удалось включить построчное получение результата, "
+                         "результат будет получен целиком");
+    }
+}
+
+//------------------------------------------------------------------------------
+ResultStreamImpl::~ResultStreamImpl() noexcept
+{
+    if (!active_)
+    {
+        return;
+    }
+
+    Logging::Debug("Отмена потокового выполнения запроса");
+
+    connection_->Cancel();
+
+    Finish();
+}
+
+//------------------------------------------------------------------------------
+bool ResultStreamImpl::Status() const noexcept
+{
+    return status_;
+}
+
+//------------------------------------------------------------------------------
+unique_ptr<ResultImpl> ResultStreamImpl::Next() noexcept
+{
+    if (!active_)
+    {
+        return nullptr;
+    }
+
+    auto *result = PQgetResult(connection_->Native());
+    if (result == nullptr)
+    {
+        active_ = false;
+        Notify();
+        return nullptr;
+    }
+
+    switch (PQresultStatus(result))
+    {
+        case PGRES_SINGLE_TUPLE:
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+        case PGRES_TUPLES_CHUNK:
+#endif
+            return make_unique<ResultImpl>(result);
+        case PGRES_TUPLES_OK:
+            // Строки в режиме построчного получения уже переданы, либо режим
+            // не был включен и результат получен целиком.
+            if (PQntuples(result) != 0)
+            {
+                Finish();
+                return make_unique<ResultImpl>(result);
+            }
+            PQclear(result);
+            break;
+        default:
+        {
+            const auto failed = make_unique<ResultImpl>(result);
+            status_ = failed->Status();
+            error_ = failed->Error();
+            break;
+        }
+    }
+
+    Finish();
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+void ResultStreamImpl::Finish() noexcept
+{
+    while (auto *result = PQgetResult(connection_->Native()))
+    {
+        if (error_.empty() && observed_)
+        {
+            error_ = PQresultErrorMessage(result);
+        }
+        PQclear(result);
+    }
+
+    active_ = false;
+    Notify();
+}
+
+//------------------------------------------------------------------------------
+void ResultStreamImpl::Notify() noexcept
+{
+    if (!observed_)
+    {
+        return;
+    }
+
+    observed_ = false;
+    Observers::Finish({query_,
+                       arguments_,
+                       connection_.get(),
+                       steady_clock::now() - start_,
+                       error_});
+}
+
+}  // namespace tasp::db::pg
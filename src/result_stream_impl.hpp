@@ -0,0 +1,134 @@
+/**
+ * @file
+ * @brief Реализация интерфейсов для потокового получения результата запроса
+ * к СУБД PostgreSQL.
+ */
+#ifndef TASP_RESULT_STREAM_IMPL_HPP_
+#define TASP_RESULT_STREAM_IMPL_HPP_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <tasp/db/pg/params.hpp>
+#include <tasp/db/pg/result.hpp>
+
+#include "result_impl.hpp"
+
+namespace tasp::db::pg
+{
+
+class ConnectionImpl;
+
+/**
+ * @brief Реализация интерфейса потокового получения результата запроса.
+ *
+ * Строки результата передаются по одной (или порциями, если libpq
+ * поддерживает PQsetChunkedRowsMode) по мере их получения от сервера, весь
+ * результат в памяти не накапливается. Наблюдатели получают событие начала
+ * при отправке запроса и событие завершения после получения последней
+ * строки, ошибки или отмены.
+ */
+class ResultStreamImpl final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * Отправляет запрос в СУБД.
+     *
+     * @param connection Подключение к БД
+     * @param query SQL-запрос
+     * @param params Параметры запроса
+     * @param format Формат результата
+     */
+    ResultStreamImpl(std::shared_ptr<const ConnectionImpl> connection,
+                     std::string_view query,
+                     const Params &params,
+                     Result::Format format) noexcept;
+
+    /**
+     * @brief Деструктор.
+     *
+     * Если получены не все строки, выполнение запроса отменяется.
+     */
+    ~ResultStreamImpl() noexcept;
+
+    /**
+     * @brief Статус выполнения запроса.
+     *
+     * @return Статус
+     */
+    [[nodiscard]] bool Status() const noexcept;
+
+    /**
+     * @brief Запрос следующей порции строк результата.
+     *
+     * @return Указатель на порцию строк, nullptr если строки закончились или
+     * произошла ошибка
+     */
+    [[nodiscard]] std::unique_ptr<ResultImpl> Next() noexcept;
+
+    ResultStreamImpl(const ResultStreamImpl &) = delete;
+    ResultStreamImpl(ResultStreamImpl &&) = delete;
+    ResultStreamImpl &operator=(const ResultStreamImpl &) = delete;
+    ResultStreamImpl &operator=(ResultStreamImpl &&) = delete;
+
+private:
+    /**
+     * @brief Получение оставшихся результатов запроса.
+     */
+    void Finish() noexcept;
+
+    /**
+     * @brief Рассылка наблюдателям события завершения запроса.
+     *
+     * Событие рассылается один раз.
+     */
+    void Notify() noexcept;
+
+    /**
+     * @brief Подключение к БД.
+     */
+    std::shared_ptr<const ConnectionImpl> connection_;
+
+    /**
+     * @brief SQL-запрос, сохраняется только для наблюдателей.
+     */
+    std::string query_{};
+
+    /**
+     * @brief Параметры запроса, сохраняются только для наблюдателей.
+     */
+    Params arguments_{};
+
+    /**
+     * @brief Сообщение об ошибке выполнения запроса.
+     */
+    std::string error_{};
+
+    /**
+     * @brief Время отправки запроса.
+     */
+    std::chrono::steady_clock::time_point start_{};
+
+    /**
+     * @brief Событие запроса передается наблюдателям.
+     */
+    bool observed_{false};
+
+    /**
+     * @brief Запрос выполняется, и не все строки получены.
+     */
+    bool active_{false};
+
+    /**
+     * @brief Статус выполнения запроса.
+     */
+    bool status_{false};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_RESULT_STREAM_IMPL_HPP_
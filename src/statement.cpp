@@ -0,0 +1,177 @@
+#include "statement.hpp"
+
+#include <tasp/db/pg/sql.hpp>
+
+using std::string;
+using std::string_view;
+using std::to_string;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Вхождение, на место которого подставляется параметр.
+ */
+static constexpr string_view format_pattern{"{}"};
+
+/**
+ * @brief Подсчет количества вхождений {} в строке.
+ *
+ * @param text Строка
+ *
+ * @return Количество вхождений
+ */
+static inline size_t CountPlaceholders(string_view text) noexcept
+{
+    size_t count{0};
+    for (auto pos = text.find(format_pattern); pos != string_view::npos;
+         pos = text.find(format_pattern, pos + format_pattern.size()))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+/*------------------------------------------------------------------------------
+    Statement
+------------------------------------------------------------------------------*/
+Statement::Statement(string_view query, size_t params) noexcept
+{
+    sql_.reserve(query.size() + params * 8);
+
+    size_t pos{0};
+    while (pos < query.size())
+    {
+        const auto span = FindSqlSpan(query, pos);
+
+        if (span.kind == SqlSpan::Kind::Literal && span.closed)
+        {
+            const auto body = query.substr(pos + 1, span.end - pos - 2);
+            const auto count = CountPlaceholders(body);
+            placeholders_ += count;
+            if (count == 0 || params_ == params)
+            {
+                sql_.append(query.substr(pos, span.end - pos));
+            }
+            else
+            {
+                AddLiteral(body, params - params_);
+            }
+
+            pos = span.end;
+            continue;
+        }
+
+        // Комментарии, идентификаторы в кавычках, константы E'...' и строки
+        // в долларовых кавычках (тела функций) копируются без изменений.
+        if (span.kind != SqlSpan::Kind::Code)
+        {
+            sql_.append(query.substr(pos, span.end - pos));
+            pos = span.end;
+            continue;
+        }
+
+        if (query.compare(pos, format_pattern.size(), format_pattern) == 0)
+        {
+            ++placeholders_;
+            if (params_ < params)
+            {
+                AddParam();
+            }
+            else
+            {
+                sql_.append(format_pattern);
+            }
+
+            pos += format_pattern.size();
+            continue;
+        }
+
+        sql_.push_back(query[pos++]);
+    }
+
+    if (placeholders_ == 0)
+    {
+        params_ = params;
+    }
+}
+
+//------------------------------------------------------------------------------
+const string &Statement::Sql() const noexcept
+{
+    return sql_;
+}
+
+//------------------------------------------------------------------------------
+size_t Statement::Params() const noexcept
+{
+    return params_;
+}
+
+//------------------------------------------------------------------------------
+size_t Statement::Placeholders() const noexcept
+{
+    return placeholders_;
+}
+
+//------------------------------------------------------------------------------
+void Statement::AddParam() noexcept
+{
+    sql_.push_back('$');
+    sql_.append(to_string(++params_));
+}
+
+//------------------------------------------------------------------------------
+void Statement::AddLiteral(string_view literal, size_t params) noexcept
+{
+    if (literal == format_pattern)
+    {
+        AddParam();
+        return;
+    }
+
+    bool first{true};
+    const auto separate = [this, &first]()
+    {
+        if (!first)
+        {
+            sql_.append(" || ");
+        }
+        first = false;
+    };
+
+    const auto add_text = [this, &separate](string_view text)
+    {
+        if (text.empty())
+        {
+            return;
+        }
+
+        separate();
+        sql_.push_back('\'');
+        sql_.append(text);
+        sql_.push_back('\'');
+    };
+
+    sql_.push_back('(');
+
+    size_t pos{0};
+    for (auto found = literal.find(format_pattern);
+         found != string_view::npos && params != 0;
+         found = literal.find(format_pattern, pos), --params)
+    {
+        add_text(literal.substr(pos, found - pos));
+
+        separate();
+        AddParam();
+        sql_.append("::text");
+
+        pos = found + format_pattern.size();
+    }
+    add_text(literal.substr(pos));
+
+    sql_.push_back(')');
+}
+
+}  // namespace tasp::db::pg
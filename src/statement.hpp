@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @brief Подготовка SQL-запроса к выполнению с параметрами.
+ */
+#ifndef TASP_STATEMENT_HPP_
+#define TASP_STATEMENT_HPP_
+
+#include <string>
+#include <string_view>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief SQL-запрос с параметрами в формате PostgreSQL ($1, $2, ...).
+ *
+ * Для совместимости поддерживается формат {}: первые params вхождений {}
+ * заменяются за один проход на $1, $2, ... Значение, которое ранее
+ * подставлялось внутрь строковой константы ('{}', '%{}%'), передается
+ * конкатенацией с параметром. Если в запросе нет {}, считается, что он уже
+ * записан с параметрами вида $n.
+ *
+ * Текст разбирается по правилам FindSqlSpan: {} внутри комментариев,
+ * идентификаторов в кавычках ("{}"), констант E'...' и строк в долларовых
+ * кавычках не заменяется. Параметр передает только значение, поэтому имена
+ * таблиц и столбцов, а также списки значений через {} больше не
+ * подставляются.
+ */
+class Statement final
+{
+public:
+    /**
+     * @brief Конструктор.
+     *
+     * @param query SQL-запрос
+     * @param params Количество переданных параметров
+     */
+    Statement(std::string_view query, size_t params) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~Statement() noexcept = default;
+
+    /**
+     * @brief Запрос текста SQL-запроса с параметрами вида $n.
+     *
+     * @return SQL-запрос
+     */
+    [[nodiscard]] const std::string &Sql() const noexcept;
+
+    /**
+     * @brief Запрос количества параметров, которые необходимо передать в СУБД.
+     *
+     * @return Количество параметров
+     */
+    [[nodiscard]] size_t Params() const noexcept;
+
+    /**
+     * @brief Запрос количества найденных в запросе вхождений {}.
+     *
+     * @return Количество вхождений {}
+     */
+    [[nodiscard]] size_t Placeholders() const noexcept;
+
+    Statement(const Statement &) = delete;
+    Statement(Statement &&) = delete;
+    Statement &operator=(const Statement &) = delete;
+    Statement &operator=(Statement &&) = delete;
+
+private:
+    /**
+     * @brief Добавление в запрос параметра $n.
+     */
+    void AddParam() noexcept;
+
+    /**
+     * @brief Добавление в запрос строковой константы.
+     *
+     * Если в константе есть {}, она разбивается на части, которые
+     * объединяются с параметрами оператором ||.
+     *
+     * @param literal Содержимое константы без кавычек
+     * @param params Количество оставшихся параметров
+     */
+    void AddLiteral(std::string_view literal, size_t params) noexcept;
+
+    /**
+     * @brief SQL-запрос с параметрами вида $n.
+     */
+    std::string sql_{};
+
+    /**
+     * @brief Количество параметров в запросе.
+     */
+    size_t params_{0};
+
+    /**
+     * @brief Количество вхождений {} в запросе.
+     */
+    size_t placeholders_{0};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_STATEMENT_HPP_
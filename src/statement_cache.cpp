@@ -0,0 +1,141 @@
+#include "statement_cache.hpp"
+
+#include <tasp/db/pg/query.hpp>
+
+using std::string;
+using std::string_view;
+using std::to_string;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    StatementCache
+------------------------------------------------------------------------------*/
+StatementCache::StatementCache(size_t capacity, size_t threshold) noexcept
+: capacity_(capacity)
+, threshold_(threshold)
+{
+    index_.reserve(capacity_);
+}
+
+//------------------------------------------------------------------------------
+StatementCache::~StatementCache() noexcept = default;
+
+//------------------------------------------------------------------------------
+size_t StatementCache::Capacity() const noexcept
+{
+    return capacity_;
+}
+
+//------------------------------------------------------------------------------
+const StatementCache::Entry *StatementCache::Find(string_view query,
+                                                  size_t arguments) noexcept
+{
+    return Find(query, QueryHash(query), arguments);
+}
+
+//------------------------------------------------------------------------------
+const StatementCache::Entry *StatementCache::Find(string_view query,
+                                                  uint64_t hash,
+                                                  size_t arguments) noexcept
+{
+    const auto found = index_.find(Key(hash, arguments));
+    if (found == index_.end())
+    {
+        return nullptr;
+    }
+
+    auto entry = found->second;
+    if (entry->arguments != arguments || !SqlEqual(entry->query, query))
+    {
+        return nullptr;
+    }
+
+    entries_.splice(entries_.begin(), entries_, entry);
+    return &*entry;
+}
+
+//------------------------------------------------------------------------------
+bool StatementCache::Hit(uint64_t hash, size_t arguments) noexcept
+{
+    if (threshold_ <= 1)
+    {
+        return true;
+    }
+
+    // Счетчики однократно выполненных запросов не накапливаются
+    // бесконечно: при переполнении подсчет начинается заново.
+    if (hits_.size() >= capacity_ * 4)
+    {
+        hits_.clear();
+    }
+
+    return ++hits_[Key(hash, arguments)] >= threshold_;
+}
+
+//------------------------------------------------------------------------------
+string StatementCache::NextName() noexcept
+{
+    return "tasp_" + to_string(++counter_);
+}
+
+//------------------------------------------------------------------------------
+string StatementCache::Add(string_view query,
+                           uint64_t hash,
+                           size_t arguments,
+                           size_t params,
+                           string name) noexcept
+{
+    const auto key = Key(hash, arguments);
+    hits_.erase(key);
+
+    string evicted{};
+    if (auto found = index_.find(key); found != index_.end())
+    {
+        evicted = std::move(found->second->name);
+        entries_.erase(found->second);
+        index_.erase(found);
+    }
+    else if (entries_.size() >= capacity_)
+    {
+        evicted = std::move(entries_.back().name);
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+
+    entries_.push_front(
+        {key, string{query}, arguments, params, std::move(name)});
+    index_.emplace(key, entries_.begin());
+
+    return evicted;
+}
+
+//------------------------------------------------------------------------------
+void StatementCache::Remove(string_view query, size_t arguments) noexcept
+{
+    const auto found = index_.find(Key(QueryHash(query), arguments));
+    if (found == index_.end() || !SqlEqual(found->second->query, query))
+    {
+        return;
+    }
+
+    entries_.erase(found->second);
+    index_.erase(found);
+}
+
+//------------------------------------------------------------------------------
+void StatementCache::Clear() noexcept
+{
+    entries_.clear();
+    index_.clear();
+    hits_.clear();
+}
+
+//------------------------------------------------------------------------------
+uint64_t StatementCache::Key(uint64_t hash, size_t arguments) noexcept
+{
+    return hash ^ arguments;
+}
+
+}  // namespace tasp::db::pg
@@ -0,0 +1,218 @@
+/**
+ * @file
+ * @brief Кэш подготовленных на сервере SQL-запросов.
+ */
+#ifndef TASP_STATEMENT_CACHE_HPP_
+#define TASP_STATEMENT_CACHE_HPP_
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Кэш подготовленных запросов подключения к СУБД.
+ *
+ * Хранит соответствие текста запроса и имени подготовленного на сервере
+ * запроса. Запросы, отличающиеся только пробелами и комментариями,
+ * считаются одинаковыми. При переполнении вытесняется запрос, который
+ * дольше всех не использовался (LRU).
+ *
+ * Запрос подготавливается после заданного количества выполнений (Hit),
+ * поэтому однократно выполняемые запросы не занимают место в кэше и не
+ * требуют лишнего обращения к серверу.
+ */
+class StatementCache final
+{
+public:
+    /**
+     * @brief Подготовленный запрос.
+     */
+    struct Entry
+    {
+        /**
+         * @brief Ключ запроса в кэше.
+         */
+        uint64_t key;
+
+        /**
+         * @brief Исходный текст запроса.
+         */
+        std::string query;
+
+        /**
+         * @brief Количество параметров переданных при подготовке.
+         */
+        size_t arguments;
+
+        /**
+         * @brief Количество параметров подготовленного запроса.
+         */
+        size_t params;
+
+        /**
+         * @brief Имя подготовленного запроса на сервере.
+         */
+        std::string name;
+    };
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param capacity Максимальное количество запросов в кэше, 0 - кэш
+     * отключен
+     * @param threshold Количество выполнений запроса, после которого он
+     * подготавливается, 0 и 1 - при первом выполнении
+     */
+    StatementCache(size_t capacity, size_t threshold) noexcept;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~StatementCache() noexcept;
+
+    /**
+     * @brief Запрос максимального количества запросов в кэше.
+     *
+     * @return Максимальное количество запросов
+     */
+    [[nodiscard]] size_t Capacity() const noexcept;
+
+    /**
+     * @brief Поиск подготовленного запроса.
+     *
+     * Найденный запрос становится последним использованным.
+     *
+     * @param query Текст запроса
+     * @param arguments Количество параметров запроса
+     *
+     * @return Указатель на подготовленный запрос или nullptr
+     */
+    [[nodiscard]] const Entry *Find(std::string_view query,
+                                    size_t arguments) noexcept;
+
+    /**
+     * @brief Поиск подготовленного запроса по заранее вычисленному хешу.
+     *
+     * @param query Текст запроса
+     * @param hash Хеш текста запроса, QueryHash(query)
+     * @param arguments Количество параметров запроса
+     *
+     * @return Указатель на подготовленный запрос или nullptr
+     */
+    [[nodiscard]] const Entry *Find(std::string_view query,
+                                    uint64_t hash,
+                                    size_t arguments) noexcept;
+
+    /**
+     * @brief Учет выполнения неподготовленного запроса.
+     *
+     * @param hash Хеш текста запроса, QueryHash(query)
+     * @param arguments Количество параметров запроса
+     *
+     * @return true - запрос выполнен заданное количество раз и должен быть
+     * подготовлен
+     */
+    [[nodiscard]] bool Hit(uint64_t hash, size_t arguments) noexcept;
+
+    /**
+     * @brief Запрос имени для следующего подготавливаемого запроса.
+     *
+     * @return Имя подготовленного запроса
+     */
+    [[nodiscard]] std::string NextName() noexcept;
+
+    /**
+     * @brief Добавление подготовленного запроса в кэш.
+     *
+     * @param query Текст запроса
+     * @param hash Хеш текста запроса, QueryHash(query)
+     * @param arguments Количество параметров запроса
+     * @param params Количество параметров подготовленного запроса
+     * @param name Имя подготовленного запроса на сервере
+     *
+     * @return Имя вытесненного из кэша запроса, который необходимо удалить на
+     * сервере. Пустая строка, если ничего не вытеснено.
+     */
+    [[nodiscard]] std::string Add(std::string_view query,
+                                  uint64_t hash,
+                                  size_t arguments,
+                                  size_t params,
+                                  std::string name) noexcept;
+
+    /**
+     * @brief Удаление запроса из кэша.
+     *
+     * @param query Текст запроса
+     * @param arguments Количество параметров запроса
+     */
+    void Remove(std::string_view query, size_t arguments) noexcept;
+
+    /**
+     * @brief Очистка кэша.
+     *
+     * Используется после переподключения к СУБД, при котором сервер удаляет
+     * все подготовленные запросы.
+     */
+    void Clear() noexcept;
+
+    StatementCache(const StatementCache &) = delete;
+    StatementCache(StatementCache &&) = delete;
+    StatementCache &operator=(const StatementCache &) = delete;
+    StatementCache &operator=(StatementCache &&) = delete;
+
+private:
+    /**
+     * @brief Вычисление ключа запроса в кэше.
+     *
+     * @param hash Хеш текста запроса
+     * @param arguments Количество параметров запроса
+     *
+     * @return Ключ
+     */
+    [[nodiscard]] static uint64_t Key(uint64_t hash,
+                                      size_t arguments) noexcept;
+
+    /**
+     * @brief Максимальное количество запросов в кэше.
+     */
+    size_t capacity_;
+
+    /**
+     * @brief Количество выполнений запроса, после которого он
+     * подготавливается.
+     */
+    size_t threshold_;
+
+    /**
+     * @brief Счетчик для формирования имен подготовленных запросов.
+     */
+    uint64_t counter_{0};
+
+    /**
+     * @brief Запросы в порядке использования, первый - последний
+     * использованный.
+     */
+    std::list<Entry> entries_{};
+
+    /**
+     * @brief Индекс запросов по ключу.
+     */
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_{};
+
+    /**
+     * @brief Количество выполнений неподготовленных запросов по ключу.
+     *
+     * Совпадение ключей разных запросов приводит только к более ранней
+     * подготовке одного из них.
+     */
+    std::unordered_map<uint64_t, size_t> hits_{};
+};
+
+}  // namespace tasp::db::pg
+
+#endif  // TASP_STATEMENT_CACHE_HPP_
@@ -0,0 +1,47 @@
+#include "tasp/db/pg/statistics.hpp"
+
+#include "atomic_histogram.hpp"
+#include "query_stats.hpp"
+
+using std::vector;
+
+namespace tasp::db::pg
+{
+
+/*------------------------------------------------------------------------------
+    Statistics
+------------------------------------------------------------------------------*/
+vector<Statistics::Query> Statistics::Queries() noexcept
+{
+    return QueryStats::Instance().Queries();
+}
+
+//------------------------------------------------------------------------------
+Json::Value Statistics::JsonValue() noexcept
+{
+    Json::Value json{Json::arrayValue};
+    for (const auto &query : Queries())
+    {
+        Json::Value value{Json::objectValue};
+        value["sql"] = query.sql;
+        value["params"] = Json::UInt64{query.params};
+        value["calls"] = Json::UInt64{query.calls};
+        value["errors"] = Json::UInt64{query.errors};
+        value["rows"] = Json::UInt64{query.rows};
+        value["bytes"] = Json::UInt64{query.bytes};
+        value["slow"] = Json::UInt64{query.slow};
+        value["max"] = Json::Int64{query.max.count()};
+        value["latency"] = AtomicHistogram::JsonValue(query.latency);
+        json.append(value);
+    }
+
+    return json;
+}
+
+//------------------------------------------------------------------------------
+void Statistics::Reset() noexcept
+{
+    QueryStats::Instance().Reset();
+}
+
+}  // namespace tasp::db::pg
@@ -20,6 +20,14 @@ TransactionImpl::TransactionImpl(
     Exec("BEGIN", Status::Begin, "Старт транзакции");
 }
 
+//------------------------------------------------------------------------------
+TransactionImpl::TransactionImpl(shared_ptr<const ConnectionImpl> connection,
+                                 bool started) noexcept
+: status_(started ? Status::Begin : Status::None)
+, connection_(std::move(connection))
+{
+}
+
 //------------------------------------------------------------------------------
 TransactionImpl::~TransactionImpl() noexcept
 {
@@ -30,6 +30,16 @@ public:
     explicit TransactionImpl(
         std::shared_ptr<const ConnectionImpl> connection) noexcept;
 
+    /**
+     * @brief Конструктор для транзакции, команда BEGIN которой уже выполнена
+     * асинхронно.
+     *
+     * @param connection Подключение к БД
+     * @param started Результат выполнения команды BEGIN
+     */
+    TransactionImpl(std::shared_ptr<const ConnectionImpl> connection,
+                    bool started) noexcept;
+
     /**
      * @brief Деструктор.
      *
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "cell.hpp"
+
+using std::string;
+using std::string_view;
+using namespace std::string_view_literals;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Пример преобразования значения в двоичном формате в текст.
+ */
+struct BinaryCase
+{
+    /**
+     * @brief Данные в двоичном формате.
+     */
+    string_view data;
+
+    /**
+     * @brief OID типа данных.
+     */
+    Oid type;
+
+    /**
+     * @brief Ожидаемое текстовое представление.
+     */
+    string_view text;
+};
+
+//------------------------------------------------------------------------------
+TEST(Cell, BinaryText)
+{
+    static constexpr BinaryCase cases[]{
+        {"\x01"sv, oid::boolean, "t"},
+        {"\x00\x00\x00\x2a"sv, oid::int4, "42"},
+        {"\xff\xff\xff\xff\xff\xff\xff\xfe"sv, oid::int8, "-2"},
+        {"text"sv, oid::text, "text"},
+        {"\x01{}"sv, oid::jsonb, "{}"},
+        {"\x00\x01\xab\xff"sv, oid::bytea, "\\x0001abff"},
+        {""sv, oid::bytea, "\\x"},
+        {"\x00\x00\x00\x01\x00\x00\x00\x00"sv, 600, ""},
+        {"\x00\x00\x00\x01"sv, 1007, ""},
+        {""sv, oid::jsonb, ""},
+        {"\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x11"
+         "\x00\x00\x00\x01\x00\x00\x00\x01"
+         "\x00\x00\x00\x02\xab\x01"sv,
+         1001,
+         R"({"\\xab01"})"},
+    };
+
+    for (const auto &test : cases)
+    {
+        SCOPED_TRACE(test.type);
+
+        const Cell cell{test.data.data(),
+                        static_cast<int>(test.data.size()),
+                        test.type,
+                        true};
+        EXPECT_EQ(cell.Text(), test.text);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(Cell, ParseInteger)
+{
+    static constexpr string_view cases[]{
+        "0",
+        "-0",
+        "7",
+        "-7",
+        "12345678",
+        "123456789",
+        "1234567890123456",
+        "9223372036854775807",
+        "-9223372036854775808",
+        "9223372036854775808",
+        "-9223372036854775809",
+        "18446744073709551615",
+        "99999999999999999999",
+        "0000000000000000000000042",
+        "-0000000000000000000000042",
+        "00000000",
+        "",
+        "-",
+        "+1",
+        " 1",
+        "1 ",
+        "1a",
+        "1234567a",
+        "12345678a",
+        "123456789012345:",
+        "1.5",
+        "0x10",
+    };
+
+    for (const auto &text : cases)
+    {
+        SCOPED_TRACE(text);
+
+        int64_t expected{0};
+        const auto [end, error] =
+            std::from_chars(text.data(), text.data() + text.size(), expected);
+        const auto valid =
+            error == std::errc{} && end == text.data() + text.size();
+
+        int64_t value{0};
+        const Cell cell{
+            text.data(), static_cast<int>(text.size()), oid::int8, false};
+        EXPECT_EQ(cell.Get(value), valid);
+        if (valid)
+        {
+            EXPECT_EQ(value, expected);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(Cell, ParseIntegerDigits)
+{
+    // Числа всех длин проверяют сочетания блоков по восемь цифр и остатка.
+    int64_t number{0};
+    for (int digits = 1; digits <= 19; ++digits)
+    {
+        number = number * 10 + digits % 9 + 1;
+        for (const auto sign : {int64_t{1}, int64_t{-1}})
+        {
+            const auto text = std::to_string(number * sign);
+            SCOPED_TRACE(text);
+
+            int64_t value{0};
+            const Cell cell{
+                text.data(), static_cast<int>(text.size()), oid::int8, false};
+            ASSERT_TRUE(cell.Get(value));
+            EXPECT_EQ(value, number * sign);
+        }
+    }
+
+    const string text{"32768"};
+    const Cell cell{
+        text.data(), static_cast<int>(text.size()), oid::int2, false};
+    int16_t narrow{0};
+    int32_t wide{0};
+    EXPECT_FALSE(cell.Get(narrow));
+    EXPECT_TRUE(cell.Get(wide));
+    EXPECT_EQ(wide, std::numeric_limits<int16_t>::max() + 1);
+}
+
+//------------------------------------------------------------------------------
+TEST(Cell, ColumnFloat8)
+{
+    const std::unique_ptr<PGresult, decltype(&PQclear)> result{
+        PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK), PQclear};
+    ASSERT_NE(result, nullptr);
+
+    string name{"value"};
+    PGresAttDesc column{name.data(), 0, 0, 1, oid::float8, 8, -1};
+    ASSERT_NE(PQsetResultAttrs(result.get(), 1, &column), 0);
+
+    // 1.5, укороченное значение и NULL.
+    string full{"\x3f\xf8\x00\x00\x00\x00\x00\x00"sv};
+    string shortened{"\x3f\xf8"sv};
+    ASSERT_NE(PQsetvalue(result.get(), 0, 0, full.data(), 8), 0);
+    ASSERT_NE(PQsetvalue(result.get(), 1, 0, shortened.data(), 2), 0);
+    ASSERT_NE(PQsetvalue(result.get(), 2, 0, nullptr, -1), 0);
+
+    ColumnValues<double> values{};
+    EXPECT_EQ(Cell::Column(result.get(), 0, values), 1U);
+    ASSERT_EQ(values.Size(), 3U);
+    EXPECT_DOUBLE_EQ(values.values[0], 1.5);
+    EXPECT_FALSE(values.IsNull(0));
+    EXPECT_TRUE(values.IsNull(1));
+    EXPECT_TRUE(values.IsNull(2));
+}
+
+}  // namespace tasp::db::pg
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "cell.hpp"
+#include "json_type.hpp"
+
+using std::string;
+using std::string_view;
+
+namespace tasp::db::pg
+{
+
+namespace
+{
+
+/**
+ * @brief Обработчик элементов массива, записывающий их в строку вида
+ * {<a>,N,{<b>}}, N - NULL.
+ */
+class ArrayRecorder final
+{
+public:
+    /**
+     * @brief Начало массива.
+     */
+    void Begin()
+    {
+        Separate();
+        text.push_back('{');
+    }
+
+    /**
+     * @brief Конец массива.
+     */
+    void End()
+    {
+        text.push_back('}');
+    }
+
+    /**
+     * @brief Элемент массива.
+     *
+     * @param value Значение
+     * @param null Значение NULL
+     */
+    void Element(string_view value, bool null)
+    {
+        Separate();
+        if (null)
+        {
+            text.push_back('N');
+            return;
+        }
+
+        text.push_back('<');
+        text.append(value);
+        text.push_back('>');
+    }
+
+    /**
+     * @brief Разобранный массив.
+     */
+    string text{};
+
+private:
+    /**
+     * @brief Добавление разделителя перед элементом.
+     */
+    void Separate()
+    {
+        if (!text.empty() && text.back() != '{')
+        {
+            text.push_back(',');
+        }
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief Пример разбора литерала массива.
+ */
+struct ArrayCase
+{
+    /**
+     * @brief Литерал массива.
+     */
+    string_view literal;
+
+    /**
+     * @brief Ожидаемый результат разбора.
+     */
+    bool valid;
+
+    /**
+     * @brief Ожидаемые элементы, только для valid.
+     */
+    string_view elements;
+};
+
+//------------------------------------------------------------------------------
+TEST(JsonType, ParseArray)
+{
+    static constexpr ArrayCase cases[]{
+        {"{}", true, "{}"},
+        {"{1,2,3}", true, "{<1>,<2>,<3>}"},
+        {"{ a , b }", true, "{<a>,<b>}"},
+        {R"({"a,b","c}d"})", true, "{<a,b>,<c}d>}"},
+        {R"({"a\"b","c\\d"})", true, R"({<a"b>,<c\d>})"},
+        {R"({a\,b})", true, "{<a,b>}"},
+        {R"({NULL,null,"NULL"})", true, "{N,N,<NULL>}"},
+        {"{NULLX}", true, "{<NULLX>}"},
+        {"{{1,2},{3,NULL}}", true, "{{<1>,<2>},{<3>,N}}"},
+        {"{{},{}}", true, "{{},{}}"},
+        {"[1:2]={5,6}", true, "{<5>,<6>}"},
+        {"[0:0][1:1]={{x}}", true, "{{<x>}}"},
+        {R"({""})", true, "{<>}"},
+        {"{1,2} ", true, "{<1>,<2>}"},
+        {"", false, ""},
+        {"1,2", false, ""},
+        {"[1:2]", false, ""},
+        {"{1,2", false, ""},
+        {"{{1}", false, ""},
+        {R"({"a})", false, ""},
+        {R"({a\)", false, ""},
+        {"{1} x", false, ""},
+    };
+
+    for (const auto &test : cases)
+    {
+        SCOPED_TRACE(test.literal);
+
+        ArrayRecorder recorder{};
+        string scratch{};
+        EXPECT_EQ(ParseArray(test.literal, recorder, scratch), test.valid);
+        if (test.valid)
+        {
+            EXPECT_EQ(recorder.text, test.elements);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(JsonType, Arrays)
+{
+    for (const auto &[array, element] : oid::arrays)
+    {
+        SCOPED_TRACE(array);
+
+        const auto type = JsonType::Of(array);
+        EXPECT_TRUE(type.array);
+        EXPECT_EQ(type.kind, JsonType::Of(element).kind);
+        EXPECT_FALSE(JsonType::Of(element).array);
+    }
+
+    EXPECT_EQ(JsonType::Of(1001).kind, JsonType::Kind::String);
+    EXPECT_EQ(JsonType::Of(1016).kind, JsonType::Kind::Integer);
+    EXPECT_FALSE(JsonType::Of(600).array);
+}
+
+//------------------------------------------------------------------------------
+TEST(JsonType, NumericPrecision)
+{
+    const auto type = JsonType::Of(oid::numeric);
+    const string_view exact{"12345678901234567890.123456789"};
+
+    EXPECT_EQ(type.Value(exact), Json::Value{string{exact}});
+
+    string buffer{};
+    type.Write(exact, buffer);
+    EXPECT_EQ(buffer, exact);
+
+    const auto array = JsonType::Of(1231);
+    const auto value = array.Value("{1.10,NULL}");
+    ASSERT_TRUE(value.isArray());
+    EXPECT_EQ(value[0], Json::Value{"1.10"});
+    EXPECT_TRUE(value[1].isNull());
+}
+
+}  // namespace tasp::db::pg
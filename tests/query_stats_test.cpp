@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+#include "query_stats.hpp"
+
+using std::string_view;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Пример нормализации текста запроса для статистики.
+ */
+struct QueryStatsCase
+{
+    /**
+     * @brief Исходный запрос.
+     */
+    string_view query;
+
+    /**
+     * @brief Ожидаемый нормализованный текст.
+     */
+    string_view sql;
+};
+
+//------------------------------------------------------------------------------
+TEST(QueryStats, Normalize)
+{
+    static constexpr QueryStatsCase cases[]{
+        {"SELECT 1", "SELECT ?"},
+        {"  SELECT\n\t1  ", "SELECT ?"},
+        {"SELECT * FROM t WHERE id = 42", "SELECT * FROM t WHERE id = ?"},
+        {"SELECT 3.14, 1e10", "SELECT ?, ?"},
+        {"SELECT 'a', 'it''s'", "SELECT ?, ?"},
+        {"SELECT 'unclosed", "SELECT ?"},
+        {R"(SELECT "col 1" FROM t1)", R"(SELECT "col 1" FROM t1)"},
+        {R"(SELECT "a""b")", R"(SELECT "a""b")"},
+        {"SELECT $1, $12", "SELECT $1, $12"},
+        {"SELECT a1, b_2 FROM t", "SELECT a1, b_2 FROM t"},
+        {"SELECT x+1", "SELECT x+?"},
+        {"SELECT 1 -- it's 2\nFROM t", "SELECT ? FROM t"},
+        {"SELECT /* 'a' */ 'b', 1 -- x", "SELECT ?, ?"},
+        {"/* a /* 'b' */ c */ SELECT 'd'", "SELECT ?"},
+        {"SELECT a--'b'\n, 'c'", "SELECT a , ?"},
+        {"SELECT $$secret$$, $tag$it's$tag$", "SELECT ?, ?"},
+        {"SELECT $a$ x $b$ y $a$ FROM t", "SELECT ? FROM t"},
+        {R"(SELECT E'\'secret', 1)", "SELECT ?, ?"},
+        {"SELECT a$b$ FROM t", "SELECT a$b$ FROM t"},
+        {"SELECT $$unclosed", "SELECT ?"},
+        {"", ""},
+    };
+
+    for (const auto &test : cases)
+    {
+        SCOPED_TRACE(test.query);
+
+        EXPECT_EQ(QueryStats::Normalize(test.query), test.sql);
+    }
+}
+
+}  // namespace tasp::db::pg
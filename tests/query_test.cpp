@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string_view>
+
+#include <tasp/db/pg/query.hpp>
+
+using std::string_view;
+
+namespace tasp::db::pg
+{
+
+namespace
+{
+
+/**
+ * @brief Проверка запроса, разобранного во время выполнения.
+ *
+ * @param query Запрос
+ * @param sql Ожидаемый запрос с параметрами вида $n, пустой - запрос
+ * ошибочный
+ * @param params Ожидаемое количество параметров
+ */
+template<size_t Size, typename... Args>
+void ExpectQuery(const Query<Size, Args...> &query,
+                 string_view sql,
+                 size_t params)
+{
+    EXPECT_EQ(query.Valid(), !sql.empty());
+    EXPECT_EQ(query.Sql(), sql);
+    EXPECT_EQ(query.Params(), params);
+    EXPECT_EQ(query.Hash(), QueryHash(query.Sql()));
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+TEST(Query, CompileTime)
+{
+    static constexpr auto query = MakeQuery<int64_t, Untyped>(
+        "SELECT /* {} */ a FROM t WHERE id = {} AND name = {}");
+
+    static_assert(query.Valid());
+    static_assert(query.Params() == 2);
+    static_assert(query.Sql() ==
+                  "SELECT /* {} */ a FROM t WHERE id = $1 AND name = $2");
+}
+
+//------------------------------------------------------------------------------
+TEST(Query, Rewrite)
+{
+    ExpectQuery(MakeQuery("SELECT 1"), "SELECT 1", 0);
+    ExpectQuery(MakeQuery<int>("SELECT {}"), "SELECT $1", 1);
+    ExpectQuery(MakeQuery<int, int>("SELECT $2, $1"), "SELECT $2, $1", 2);
+    ExpectQuery(MakeQuery<int>("SELECT '%' || {} || '%'"),
+                "SELECT '%' || $1 || '%'",
+                1);
+    ExpectQuery(MakeQuery<int>(R"(SELECT "{}" FROM t WHERE a = {})"),
+                R"(SELECT "{}" FROM t WHERE a = $1)",
+                1);
+    ExpectQuery(MakeQuery<int>("SELECT 1 -- don't {} $5\nWHERE a = {}"),
+                "SELECT 1 -- don't {} $5\nWHERE a = $1",
+                1);
+    ExpectQuery(MakeQuery<int>("/* a /* {} */ $3 */ SELECT {}"),
+                "/* a /* {} */ $3 */ SELECT $1",
+                1);
+    ExpectQuery(MakeQuery<int>(R"(SELECT E'\'{}', {})"),
+                R"(SELECT E'\'{}', $1)",
+                1);
+    ExpectQuery(
+        MakeQuery<int>("DO $body$ BEGIN '{}'; $7; END $body$; SELECT {}"),
+        "DO $body$ BEGIN '{}'; $7; END $body$; SELECT $1",
+        1);
+    ExpectQuery(MakeQuery<int>("SELECT a$b$ FROM t WHERE x = $1"),
+                "SELECT a$b$ FROM t WHERE x = $1",
+                1);
+}
+
+//------------------------------------------------------------------------------
+TEST(Query, Invalid)
+{
+    ExpectQuery(MakeQuery<int>("SELECT '{}'"), "", 0);
+    ExpectQuery(MakeQuery<int>("SELECT '%{}%'"), "", 0);
+    ExpectQuery(MakeQuery<int, int>("SELECT {}, $2"), "", 0);
+    ExpectQuery(MakeQuery<int>("SELECT {}, {}"), "", 0);
+    ExpectQuery(MakeQuery<int>("SELECT 1 -- {}"), "", 0);
+}
+
+}  // namespace tasp::db::pg
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "reactor.hpp"
+
+using std::condition_variable;
+using std::mutex;
+using std::unique_lock;
+using std::vector;
+using std::chrono::milliseconds;
+
+namespace tasp::db::pg
+{
+
+//------------------------------------------------------------------------------
+TEST(Reactor, Timers)
+{
+    auto &reactor = Reactor::Instance();
+
+    mutex guard{};
+    condition_variable done{};
+    vector<int> fired{};
+
+    const auto record = [&](int value)
+    {
+        return [&, value]
+        {
+            const std::scoped_lock lock{guard};
+            fired.push_back(value);
+            done.notify_one();
+        };
+    };
+
+    const auto cancelled = reactor.After(milliseconds{10}, record(0));
+    ASSERT_NE(reactor.After(milliseconds{30}, record(3)), 0U);
+    ASSERT_NE(reactor.After(milliseconds{20}, record(2)), 0U);
+    ASSERT_NE(reactor.After(milliseconds{1}, record(1)), 0U);
+    ASSERT_NE(cancelled, 0U);
+    reactor.Cancel(cancelled);
+    reactor.Cancel(cancelled);
+
+    unique_lock lock{guard};
+    ASSERT_TRUE(done.wait_for(lock,
+                              std::chrono::seconds{5},
+                              [&]
+                              {
+                                  return fired.size() == 3;
+                              }));
+    EXPECT_EQ(fired, (vector<int>{1, 2, 3}));
+}
+
+//------------------------------------------------------------------------------
+TEST(Reactor, Watch)
+{
+    auto &reactor = Reactor::Instance();
+
+    mutex guard{};
+    condition_variable done{};
+    int calls{0};
+
+    // Дескриптор с тем же номером регистрируется повторно, события
+    // доставляются только новому обработчику.
+    for (int round = 0; round < 2; ++round)
+    {
+        const auto descriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        ASSERT_GE(descriptor, 0);
+
+        ASSERT_TRUE(reactor.Watch(descriptor,
+                                  EPOLLIN,
+                                  [&, descriptor, round](uint32_t events)
+                                  {
+                                      EXPECT_TRUE(events & EPOLLIN);
+                                      uint64_t value{0};
+                                      [[maybe_unused]] const auto bytes =
+                                          read(descriptor,
+                                               &value,
+                                               sizeof(value));
+
+                                      const std::scoped_lock lock{guard};
+                                      EXPECT_EQ(calls, round);
+                                      ++calls;
+                                      done.notify_one();
+                                  }));
+
+        const uint64_t value{1};
+        ASSERT_EQ(write(descriptor, &value, sizeof(value)),
+                  static_cast<ssize_t>(sizeof(value)));
+
+        {
+            unique_lock lock{guard};
+            ASSERT_TRUE(done.wait_for(lock,
+                                      std::chrono::seconds{5},
+                                      [&]
+                                      {
+                                          return calls == round + 1;
+                                      }));
+        }
+
+        reactor.Remove(descriptor);
+        close(descriptor);
+    }
+}
+
+}  // namespace tasp::db::pg
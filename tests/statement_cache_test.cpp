@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+#include <tasp/db/pg/query.hpp>
+
+#include "statement_cache.hpp"
+
+using std::string_view;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Пример сравнения нормализованных запросов.
+ */
+struct NormalizeCase
+{
+    /**
+     * @brief Первый запрос.
+     */
+    string_view lhs;
+
+    /**
+     * @brief Второй запрос.
+     */
+    string_view rhs;
+
+    /**
+     * @brief Ожидаемый результат сравнения.
+     */
+    bool equal;
+};
+
+//------------------------------------------------------------------------------
+TEST(StatementCache, Normalize)
+{
+    static constexpr NormalizeCase cases[]{
+        {"SELECT 1", "SELECT 1", true},
+        {"SELECT  1", "SELECT 1", true},
+        {"  SELECT\n\t1 ;\n", "SELECT 1 ;", true},
+        {"SELECT 1 -- comment", "SELECT 1", true},
+        {"SELECT /* a /* b */ c */ 1", "SELECT 1", true},
+        {"SELECT/**/1", "SELECT 1", true},
+        {"SELECT 'a  b'", "SELECT 'a b'", false},
+        {"SELECT '--'", "SELECT", false},
+        {R"(SELECT "a  b")", R"(SELECT "a b")", false},
+        {"SELECT $$ a  b $$", "SELECT $$ a b $$", false},
+        {"SELECT 1", "SELECT 2", false},
+        {"SELECT a=1", "SELECT a = 1", false},
+        {"", "  -- comment", true},
+    };
+
+    for (const auto &test : cases)
+    {
+        SCOPED_TRACE(test.lhs);
+
+        EXPECT_EQ(SqlEqual(test.lhs, test.rhs), test.equal);
+        EXPECT_EQ(QueryHash(test.lhs) == QueryHash(test.rhs), test.equal);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(StatementCache, Find)
+{
+    StatementCache cache{2, 1};
+
+    const string_view query{"SELECT {}"};
+    EXPECT_TRUE(cache.Add(query, QueryHash(query), 1, 1, "s1").empty());
+
+    const string_view spaced{"SELECT  {} -- comment"};
+    const auto *entry = cache.Find(spaced, 1);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->name, "s1");
+    EXPECT_EQ(entry->query, query);
+    EXPECT_EQ(cache.Find(query, 2), nullptr);
+    EXPECT_EQ(cache.Find("SELECT {} + 1", 1), nullptr);
+
+    EXPECT_TRUE(cache.Add("SELECT 2", QueryHash("SELECT 2"), 0, 0, "s2")
+                    .empty());
+    EXPECT_EQ(cache.Add("SELECT 3", QueryHash("SELECT 3"), 0, 0, "s3"), "s1");
+
+    cache.Remove("SELECT  2", 0);
+    EXPECT_EQ(cache.Find("SELECT 2", 0), nullptr);
+    EXPECT_NE(cache.Find("SELECT 3", 0), nullptr);
+}
+
+//------------------------------------------------------------------------------
+TEST(StatementCache, Threshold)
+{
+    StatementCache cache{4, 3};
+
+    const auto hash = QueryHash("SELECT {}");
+    EXPECT_FALSE(cache.Hit(hash, 1));
+    EXPECT_FALSE(cache.Hit(hash, 1));
+    EXPECT_FALSE(cache.Hit(hash, 2));
+    EXPECT_TRUE(cache.Hit(hash, 1));
+
+    static_cast<void>(cache.Add("SELECT {}", hash, 1, 1, "s1"));
+    EXPECT_FALSE(cache.Hit(hash, 1));
+
+    StatementCache eager{4, 1};
+    EXPECT_TRUE(eager.Hit(hash, 1));
+}
+
+}  // namespace tasp::db::pg
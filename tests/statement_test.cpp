@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+#include "statement.hpp"
+
+using std::string_view;
+
+namespace tasp::db::pg
+{
+
+/**
+ * @brief Пример преобразования запроса с параметрами {}.
+ */
+struct StatementCase
+{
+    /**
+     * @brief Исходный запрос.
+     */
+    string_view query;
+
+    /**
+     * @brief Количество переданных параметров.
+     */
+    size_t arguments;
+
+    /**
+     * @brief Ожидаемый запрос с параметрами вида $n.
+     */
+    string_view sql;
+
+    /**
+     * @brief Ожидаемое количество вхождений {}.
+     */
+    size_t placeholders;
+
+    /**
+     * @brief Ожидаемое количество параметров запроса.
+     */
+    size_t params;
+};
+
+//------------------------------------------------------------------------------
+TEST(Statement, Rewrite)
+{
+    static constexpr StatementCase cases[]{
+        {"SELECT 1", 0, "SELECT 1", 0, 0},
+        {"SELECT {}", 1, "SELECT $1", 1, 1},
+        {"SELECT {}, {}", 2, "SELECT $1, $2", 2, 2},
+        {"SELECT $1, $2", 2, "SELECT $1, $2", 0, 2},
+        {"SELECT {} {}", 1, "SELECT $1 {}", 2, 1},
+        {"SELECT '{}'", 1, "SELECT $1", 1, 1},
+        {"SELECT '%{}%'", 1, "SELECT ('%' || $1::text || '%')", 1, 1},
+        {"SELECT 'it''s {}'", 1, "SELECT ('it''s ' || $1::text)", 1, 1},
+        {"SELECT '{}", 1, "SELECT '{}", 0, 1},
+        {R"(SELECT "{}" FROM t WHERE a = {})",
+         1,
+         R"(SELECT "{}" FROM t WHERE a = $1)",
+         1,
+         1},
+        {"SELECT 1 -- don't {}\nWHERE a = {}",
+         1,
+         "SELECT 1 -- don't {}\nWHERE a = $1",
+         1,
+         1},
+        {"SELECT 1 -- {}", 1, "SELECT 1 -- {}", 0, 1},
+        {"SELECT /* {} 'x */ {}", 1, "SELECT /* {} 'x */ $1", 1, 1},
+        {"/* a /* {} */ {} */ {}", 1, "/* a /* {} */ {} */ $1", 1, 1},
+        {R"(SELECT E'\'{}', {})", 1, R"(SELECT E'\'{}', $1)", 1, 1},
+        {"SELECT e'{}' || {}", 1, "SELECT e'{}' || $1", 1, 1},
+        {"CREATE FUNCTION f() AS $$ SELECT '{}', {} $$; SELECT {}",
+         1,
+         "CREATE FUNCTION f() AS $$ SELECT '{}', {} $$; SELECT $1",
+         1,
+         1},
+        {"DO $body$ BEGIN $1; END $body$; SELECT {}",
+         1,
+         "DO $body$ BEGIN $1; END $body$; SELECT $1",
+         1,
+         1},
+        {"SELECT a$b$ FROM t WHERE x = {}",
+         1,
+         "SELECT a$b$ FROM t WHERE x = $1",
+         1,
+         1},
+        {"SELECT $$ {}", 1, "SELECT $$ {}", 0, 1},
+    };
+
+    for (const auto &test : cases)
+    {
+        SCOPED_TRACE(test.query);
+
+        const Statement statement{test.query, test.arguments};
+        EXPECT_EQ(statement.Sql(), test.sql);
+        EXPECT_EQ(statement.Placeholders(), test.placeholders);
+        EXPECT_EQ(statement.Params(), test.params);
+    }
+}
+
+}  // namespace tasp::db::pg